@@ -61,6 +61,7 @@
 #include <tskrgb2ycbcr-dsp.h>
 #include <swirgb2ycbcr-dsp.h>
 #include <rgb2ycbcr-dsp_config.h>
+#include <rgb2ycbcr-dsp_kernel.h>
 
 
 /** ============================================================================
@@ -87,7 +88,58 @@ Uint32 xferBufSize ;
  *          A value of 0 in numTransfers implies infinite iterations.
  *  ============================================================================
  */
-Uint16 numTransfers ;
+Uint32 numTransfers ;
+
+/** ============================================================================
+ *  @name   numBuffers
+ *
+ *  @desc   Number of buffers streamed between the GPP and the DSP.
+ *  ============================================================================
+ */
+Uint32 numBuffers ;
+
+/** ============================================================================
+ *  @name   outputFormat
+ *
+ *  @desc   Layout of the converted pixels, one of RGB2YCBCR_DSP_FORMAT_XXX.
+ *  ============================================================================
+ */
+Uint16 outputFormat ;
+
+/** ============================================================================
+ *  @name   frameWidth
+ *
+ *  @desc   Width of the frame in pixels, needed to subsample the chroma
+ *          planes.
+ *  ============================================================================
+ */
+Uint16 frameWidth ;
+
+/** ============================================================================
+ *  @name   chromaFilter
+ *
+ *  @desc   Filter the chroma planes are subsampled with, one of
+ *          RGB2YCBCR_DSP_FILTER_XXX.
+ *  ============================================================================
+ */
+Uint16 chromaFilter ;
+
+/** ============================================================================
+ *  @name   colorimetry
+ *
+ *  @desc   Matrix the pixels are converted with, one of
+ *          RGB2YCBCR_DSP_COLOR_XXX.
+ *  ============================================================================
+ */
+Uint16 colorimetry ;
+
+/** ============================================================================
+ *  @name   direction
+ *
+ *  @desc   Direction of the conversion, one of RGB2YCBCR_DSP_DIR_XXX.
+ *  ============================================================================
+ */
+Uint16 direction ;
 
 #if defined (DSP_BOOTMODE_NOBOOT)
 /** ============================================================================
@@ -233,13 +285,49 @@ Void main(Int argc, Char *argv[])
     /* Transfer size given by GPP side */
     xferBufSize = DSPLINK_ALIGN ((atoi (argv[0]) / DSP_MAUSIZE),
                                   DSPLINK_BUF_ALIGN) ;
+
+    /* Number of buffers to stream, older GPP sides do not send it */
+    numBuffers = (argc > 2) ? atoi (argv[2]) : TSK_NUM_BUFFERS ;
+    if (numBuffers == 0) {
+        numBuffers = TSK_NUM_BUFFERS ;
+    }
+    else if (numBuffers > MAX_BUFFERS) {
+        numBuffers = MAX_BUFFERS ;
+    }
+
+    /* Output layout, frame width, chroma filter, colorimetry and
+     * direction, older GPP sides do not send them
+     */
+    outputFormat = (argc > 3) ? atoi (argv[3]) : RGB2YCBCR_DSP_FORMAT_PACKED ;
+    frameWidth   = (argc > 4) ? atoi (argv[4]) : 0 ;
+    chromaFilter = (argc > 5) ? atoi (argv[5]) : RGB2YCBCR_DSP_FILTER_DROP ;
+    colorimetry  = (argc > 6) ? atoi (argv[6]) : RGB2YCBCR_DSP_COLOR_LEGACY ;
+    direction    = (argc > 7) ? atoi (argv[7]) : RGB2YCBCR_DSP_DIR_FORWARD ;
 #else
     /* Get the number of transfers to be done by the application */
     numTransfers = 10000 ;
 
     /* Transfer size for given by GPP side */
     xferBufSize = 1024 ;
+
+    /* Number of buffers to stream */
+    numBuffers = TSK_NUM_BUFFERS ;
+
+    /* Interleaved output */
+    outputFormat = RGB2YCBCR_DSP_FORMAT_PACKED ;
+    frameWidth   = 0 ;
+    chromaFilter = RGB2YCBCR_DSP_FILTER_DROP ;
+    colorimetry  = RGB2YCBCR_DSP_COLOR_LEGACY ;
+    direction    = RGB2YCBCR_DSP_DIR_FORWARD ;
 #endif
+
+    /* The inverse only reads and writes packed pixels */
+    if (direction == RGB2YCBCR_DSP_DIR_INVERSE) {
+        outputFormat = RGB2YCBCR_DSP_FORMAT_PACKED ;
+    }
+
+    /* The matrices are picked once, the kernels keep them in registers */
+    RGB2YCBCR_DSP_setColorimetry (colorimetry) ;
 #if defined (SWI_MODE)
     /* Create phase of SWIRGB2YCBCR_DSP application */
     status = SWIRGB2YCBCR_DSP_create(&info);
@@ -310,6 +398,9 @@ static Int tskLoop()
         if (status != SYS_OK) {
             SET_FAILURE_REASON(status);
         }
+
+        /* Report the buffers converted since the last periodic report */
+        RGB2YCBCR_DSP_logKernelStats ();
     }
 
     /* Delete Phase */
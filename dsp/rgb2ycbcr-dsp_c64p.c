@@ -0,0 +1,226 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_c64p.c
+ *
+ *  @path   $(DSPLINK)/dsp/src/samples/rgb2ycbcr-dsp/
+ *
+ *  @desc   Color space conversion kernel written with C64x+ intrinsics.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+/*  ----------------------------------- DSP/BIOS Headers            */
+#include <std.h>
+
+/*  ----------------------------------- Sample Headers              */
+#include <rgb2ycbcr-dsp_kernel.h>
+#include <rgb2ycbcr-dsp_c64p.h>
+
+
+#if defined (RGB2YCBCR_DSP_C64P)
+/** ============================================================================
+ *  @const  FORWARD_BIAS
+ *
+ *  @desc   Rounding term of SCALE plus the offset added to the result of a
+ *          row of a matrix. The offset is whole, so adding it before the
+ *          shift gives the same result as adding it after.
+ *  ============================================================================
+ */
+#define FORWARD_BIAS(c) (2048 + ((c) << 12))
+
+/** ============================================================================
+ *  @const  INVERSE_BIAS
+ *
+ *  @desc   Rounding term of SCALE minus the input offsets a row of an
+ *          inverse matrix is applied to.
+ *  ============================================================================
+ */
+#define INVERSE_BIAS(row, c) (2048 - (  ((row) [0] * (c) [0])             \
+                                      + ((row) [1] * (c) [1])             \
+                                      + ((row) [2] * (c) [2])))
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_transformC64P
+ *
+ *  @desc   Applies a matrix to groups of four interleaved pixels, both
+ *          ways. The four pixels of a group are spread over three words:
+ *              A0 B0 C0 A1 | B1 C1 A2 B2 | C2 A3 B3 C3
+ *          Unpacking a word gives two halfword pairs of unsigned levels,
+ *          and each pair lines up with one of four coefficient pairs of a
+ *          matrix row:
+ *              (K1, K2) (K3, 0) (0, K1) (K2, K3)
+ *          so every output is the sum of two DOTP2 plus the bias of its
+ *          row, shifted down. The results fit in 16 bits and SPACKU4
+ *          saturates them to 0..255 on the way out, so clamping costs no
+ *          branch. The pairs and biases are read once and stay in
+ *          registers through the loop. The loop has no branches, and the
+ *          alignment and trip count asserted below let the compiler
+ *          software pipeline it. The pointers are not restrict, as the
+ *          task converts in place. Writing in place is safe because a word
+ *          is only stored after the three words of its group are loaded.
+ *
+ *  @arg    input
+ *              Pixels to convert. It must be word aligned.
+ *          output
+ *              Buffer receiving the converted pixels. It must be word
+ *              aligned. It may be input, but must not overlap it otherwise.
+ *          numQuads
+ *              Number of groups of four pixels to convert.
+ *          matrix
+ *              Matrix to convert with.
+ *          bias1, bias2, bias3
+ *              Term added to the sums of each row before the shift.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ----------------------------------------------------------------------------
+ */
+static Void RGB2YCBCR_DSP_transformC64P (const Char * input,
+                                         Char *       output,
+                                         Uint32       numQuads,
+                                         const RGB2YCBCR_DSP_Matrix * matrix,
+                                         Int          bias1,
+                                         Int          bias2,
+                                         Int          bias3)
+{
+    const Uint32 * in  = (const Uint32 *) input ;
+    Uint32 *       out = (Uint32 *) output ;
+    Uint32  q ;
+    Uint32  w0, w1, w2 ;
+    Uint32  p0, p1, p2, p3, p4, p5 ;
+    Int     a0, a1, a2, a3 ;
+    Int     b0, b1, b2, b3 ;
+    Int     c0, c1, c2, c3 ;
+
+    /* Coefficient pairs, first one in the low half */
+    const Int16 * k1 = matrix->k [0] ;
+    const Int16 * k2 = matrix->k [1] ;
+    const Int16 * k3 = matrix->k [2] ;
+    const Uint32 k1a = _pack2 (k1 [1], k1 [0]) ;
+    const Uint32 k1b = _pack2 (0,      k1 [2]) ;
+    const Uint32 k1c = _pack2 (k1 [0], 0) ;
+    const Uint32 k1d = _pack2 (k1 [2], k1 [1]) ;
+    const Uint32 k2a = _pack2 (k2 [1], k2 [0]) ;
+    const Uint32 k2b = _pack2 (0,      k2 [2]) ;
+    const Uint32 k2c = _pack2 (k2 [0], 0) ;
+    const Uint32 k2d = _pack2 (k2 [2], k2 [1]) ;
+    const Uint32 k3a = _pack2 (k3 [1], k3 [0]) ;
+    const Uint32 k3b = _pack2 (0,      k3 [2]) ;
+    const Uint32 k3c = _pack2 (k3 [0], 0) ;
+    const Uint32 k3d = _pack2 (k3 [2], k3 [1]) ;
+
+    _nassert (((Int) input  & 3) == 0) ;
+    _nassert (((Int) output & 3) == 0) ;
+
+    #pragma MUST_ITERATE (1, , )
+    for (q = 0 ; q < numQuads ; q++) {
+        w0 = _amem4_const (&in [3 * q]) ;
+        w1 = _amem4_const (&in [3 * q + 1]) ;
+        w2 = _amem4_const (&in [3 * q + 2]) ;
+
+        p0 = _unpklu4 (w0) ;    /* B0 : A0 */
+        p1 = _unpkhu4 (w0) ;    /* A1 : C0 */
+        p2 = _unpklu4 (w1) ;    /* C1 : B1 */
+        p3 = _unpkhu4 (w1) ;    /* B2 : A2 */
+        p4 = _unpklu4 (w2) ;    /* A3 : C2 */
+        p5 = _unpkhu4 (w2) ;    /* C3 : B3 */
+
+        a0 = (_dotp2 (p0, k1a) + _dotp2 (p1, k1b) + bias1) >> 12 ;
+        a1 = (_dotp2 (p1, k1c) + _dotp2 (p2, k1d) + bias1) >> 12 ;
+        a2 = (_dotp2 (p3, k1a) + _dotp2 (p4, k1b) + bias1) >> 12 ;
+        a3 = (_dotp2 (p4, k1c) + _dotp2 (p5, k1d) + bias1) >> 12 ;
+        b0 = (_dotp2 (p0, k2a) + _dotp2 (p1, k2b) + bias2) >> 12 ;
+        b1 = (_dotp2 (p1, k2c) + _dotp2 (p2, k2d) + bias2) >> 12 ;
+        b2 = (_dotp2 (p3, k2a) + _dotp2 (p4, k2b) + bias2) >> 12 ;
+        b3 = (_dotp2 (p4, k2c) + _dotp2 (p5, k2d) + bias2) >> 12 ;
+        c0 = (_dotp2 (p0, k3a) + _dotp2 (p1, k3b) + bias3) >> 12 ;
+        c1 = (_dotp2 (p1, k3c) + _dotp2 (p2, k3d) + bias3) >> 12 ;
+        c2 = (_dotp2 (p3, k3a) + _dotp2 (p4, k3b) + bias3) >> 12 ;
+        c3 = (_dotp2 (p4, k3c) + _dotp2 (p5, k3d) + bias3) >> 12 ;
+
+        _amem4 (&out [3 * q])     = _spacku4 (_pack2 (a1, c0), _pack2 (b0, a0)) ;
+        _amem4 (&out [3 * q + 1]) = _spacku4 (_pack2 (b2, a2), _pack2 (c1, b1)) ;
+        _amem4 (&out [3 * q + 2]) = _spacku4 (_pack2 (c3, b3), _pack2 (a3, c2)) ;
+    }
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_convertC64P
+ *
+ *  @desc   R, G, B in, Y, Cb, Cr out. FORWARD_BIAS folds the offsets into
+ *          the rounding term.
+ *
+ *  @modif  output
+ *  ============================================================================
+ */
+Void RGB2YCBCR_DSP_convertC64P (const Char * input,
+                                Char *       output,
+                                Uint32       numQuads,
+                                const RGB2YCBCR_DSP_Matrix * matrix)
+{
+    RGB2YCBCR_DSP_transformC64P (input,
+                                 output,
+                                 numQuads,
+                                 matrix,
+                                 FORWARD_BIAS (matrix->c [0]),
+                                 FORWARD_BIAS (matrix->c [1]),
+                                 FORWARD_BIAS (matrix->c [2])) ;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_convertInverseC64P
+ *
+ *  @desc   Y, Cb, Cr in, R, G, B out. INVERSE_BIAS takes the input offsets
+ *          out.
+ *
+ *  @modif  output
+ *  ============================================================================
+ */
+Void RGB2YCBCR_DSP_convertInverseC64P (const Char * input,
+                                       Char *       output,
+                                       Uint32       numQuads,
+                                       const RGB2YCBCR_DSP_Matrix * matrix)
+{
+    RGB2YCBCR_DSP_transformC64P (input,
+                                 output,
+                                 numQuads,
+                                 matrix,
+                                 INVERSE_BIAS (matrix->k [0], matrix->c),
+                                 INVERSE_BIAS (matrix->k [1], matrix->c),
+                                 INVERSE_BIAS (matrix->k [2], matrix->c)) ;
+}
+#endif /* if defined (RGB2YCBCR_DSP_C64P) */
@@ -0,0 +1,134 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_c64p.h
+ *
+ *  @path   $(DSPLINK)/dsp/src/samples/rgb2ycbcr-dsp/
+ *
+ *  @desc   Color space conversion kernel written with C64x+ intrinsics.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RGB2YCBCR_DSP_C64P_)
+#define RGB2YCBCR_DSP_C64P_
+
+
+/** ============================================================================
+ *  @const  RGB2YCBCR_DSP_C64P
+ *
+ *  @desc   Defined when the C64x+ kernel is built. It needs the Q12
+ *          coefficients and a little endian target, and can be turned off
+ *          with RGB2YCBCR_DSP_SCALAR_KERNEL to compare against the C loop.
+ *  ============================================================================
+ */
+#if defined (_TMS320C6400_PLUS) && defined (_LITTLE_ENDIAN)          \
+    && !defined (RGB2YCBCR_DSP_EXACT_DIV)                            \
+    && !defined (RGB2YCBCR_DSP_SCALAR_KERNEL)
+#define RGB2YCBCR_DSP_C64P
+#endif
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_convertC64P
+ *
+ *  @desc   Converts groups of four interleaved R, G, B pixels to Y, Cb, Cr
+ *          with a Q12 matrix, as RGB2YCBCR_DSP_convert () does.
+ *          A group is three words, so the loop loads and stores whole words
+ *          and works on packed data. The pixels are unsigned levels and
+ *          the results are saturated to 0..255. They match the C kernel
+ *          bit for bit.
+ *
+ *  @arg    input
+ *              Pixels to convert. It must be word aligned.
+ *          output
+ *              Buffer receiving the converted pixels. It must be word
+ *              aligned. It may be input, but must not overlap it otherwise.
+ *          numQuads
+ *              Number of groups of four pixels to convert.
+ *          matrix
+ *              Matrix to convert with. It is read before the loop.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_convert
+ *  ============================================================================
+ */
+Void RGB2YCBCR_DSP_convertC64P (const Char * input,
+                                Char *       output,
+                                Uint32       numQuads,
+                                const RGB2YCBCR_DSP_Matrix * matrix) ;
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_convertInverseC64P
+ *
+ *  @desc   Converts groups of four interleaved Y, Cb, Cr pixels back to
+ *          R, G, B with a Q12 inverse matrix, clamping to 0..255, as
+ *          RGB2YCBCR_DSP_convertInverse () does. The results match the C
+ *          kernel bit for bit.
+ *
+ *  @arg    input
+ *              Pixels to convert. It must be word aligned.
+ *          output
+ *              Buffer receiving the converted pixels. It must be word
+ *              aligned. It may be input, but must not overlap it otherwise.
+ *          numQuads
+ *              Number of groups of four pixels to convert.
+ *          matrix
+ *              Inverse matrix to convert with. It is read before the loop.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_convertInverse
+ *  ============================================================================
+ */
+Void RGB2YCBCR_DSP_convertInverseC64P (const Char * input,
+                                       Char *       output,
+                                       Uint32       numQuads,
+                                       const RGB2YCBCR_DSP_Matrix * matrix) ;
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RGB2YCBCR_DSP_C64P_) */
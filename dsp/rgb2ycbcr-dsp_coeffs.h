@@ -0,0 +1,185 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_coeffs.h
+ *
+ *  @path   $(DSPLINK)/dsp/src/samples/rgb2ycbcr-dsp/
+ *
+ *  @desc   Coefficients of the color space conversion. Both the DSP kernel
+ *          and the GPP kernels are built from this file, so they convert
+ *          with the same values. It holds no types, the tables are given as
+ *          initializers of the RGB2YCBCR_DSP_Matrix of each side.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RGB2YCBCR_DSP_COEFFS_H)
+#define RGB2YCBCR_DSP_COEFFS_H
+
+
+/** ============================================================================
+ *  @const  DXY or CZ
+ *
+ *  @desc   Values for the D and C matrix used for color space transformation
+ *  D = [0.257   0.502  0.098;
+ *      -.148  -0.289  0.438;
+ *     0.438  -0.366 -0.071];
+ *  C = [16; 128; 128];
+ *  ============================================================================
+ */
+#define D11 257
+#define D12 502
+#define D13 98
+#define D21 -148
+#define D22 -289
+#define D23 438
+#define D31 438
+#define D32 -366
+#define D33 -71
+#define C1 16
+#define C2 128
+#define C3 128
+
+/** ============================================================================
+ *  @const  KXY, SCALE
+ *
+ *  @desc   Coefficients of the legacy matrix and the step that brings the
+ *          sums back to pixel range: DXY with a division by 100 when built
+ *          with RGB2YCBCR_DSP_EXACT_DIV, fixed point otherwise.
+ *          The fixed point coefficients are DXY / 100 in Q12, rounded to
+ *          nearest. The other matrices are in Q12 as well. Q12 keeps them
+ *          within the 16 bit multipliers and their error under 0.05 of a
+ *          level over the whole input range. The division by 100 is a
+ *          software routine on the C64x+, the shift is a single
+ *          instruction.
+ *  ============================================================================
+ */
+#if defined (RGB2YCBCR_DSP_EXACT_DIV)
+#define K11 D11
+#define K12 D12
+#define K13 D13
+#define K21 D21
+#define K22 D22
+#define K23 D23
+#define K31 D31
+#define K32 D32
+#define K33 D33
+#define SCALE(sum) ((sum) / 100)
+#else /* if defined (RGB2YCBCR_DSP_EXACT_DIV) */
+#define K11 10527
+#define K12 20562
+#define K13 4014
+#define K21 -6062
+#define K22 -11837
+#define K23 17940
+#define K31 17940
+#define K32 -14991
+#define K33 -2908
+#define SCALE(sum) (((sum) + 2048) >> 12)
+#endif /* if defined (RGB2YCBCR_DSP_EXACT_DIV) */
+
+
+/** ============================================================================
+ *  @const  RGB2YCBCR_DSP_MATRICES
+ *
+ *  @desc   Initializer of the matrix of each colorimetry, indexed by
+ *          RGB2YCBCR_DSP_COLOR_XXX. The standard ones are in Q12, with
+ *          chroma rows summing to zero, so with RGB2YCBCR_DSP_EXACT_DIV only
+ *          the legacy one is there.
+ *  ============================================================================
+ */
+#define RGB2YCBCR_DSP_MATRIX_LEGACY                       \
+   { { { K11,   K12,   K13   },                           \
+       { K21,   K22,   K23   },                           \
+       { K31,   K32,   K33   } }, { C1, C2, C3 } }
+
+#if defined (RGB2YCBCR_DSP_EXACT_DIV)
+#define RGB2YCBCR_DSP_MATRICES                            \
+   RGB2YCBCR_DSP_MATRIX_LEGACY
+#else /* if defined (RGB2YCBCR_DSP_EXACT_DIV) */
+#define RGB2YCBCR_DSP_MATRICES                            \
+   RGB2YCBCR_DSP_MATRIX_LEGACY,                           \
+   /* BT.601 */                                           \
+   { { { 1052,  2065,  401   },                           \
+       { -607,  -1192, 1799  },                           \
+       { 1799,  -1506, -293  } }, { 16, 128, 128 } },     \
+   { { { 1225,  2404,  467   },                           \
+       { -691,  -1357, 2048  },                           \
+       { 2048,  -1715, -333  } }, { 0,  128, 128 } },     \
+   /* BT.709 */                                           \
+   { { { 748,   2516,  254   },                           \
+       { -412,  -1387, 1799  },                           \
+       { 1799,  -1634, -165  } }, { 16, 128, 128 } },     \
+   { { { 871,   2929,  296   },                           \
+       { -469,  -1579, 2048  },                           \
+       { 2048,  -1860, -188  } }, { 0,  128, 128 } },     \
+   /* BT.2020 */                                          \
+   { { { 924,   2385,  209   },                           \
+       { -502,  -1297, 1799  },                           \
+       { 1799,  -1654, -145  } }, { 16, 128, 128 } },     \
+   { { { 1076,  2777,  243   },                           \
+       { -572,  -1476, 2048  },                           \
+       { 2048,  -1883, -165  } }, { 0,  128, 128 } }
+#endif /* if defined (RGB2YCBCR_DSP_EXACT_DIV) */
+
+/** ============================================================================
+ *  @const  RGB2YCBCR_DSP_INVERSES
+ *
+ *  @desc   Initializer of the inverse matrix of each colorimetry, in Q12,
+ *          indexed by RGB2YCBCR_DSP_COLOR_XXX. The offsets are taken from
+ *          Y, Cb and Cr before the matrix is applied.
+ *  ============================================================================
+ */
+#define RGB2YCBCR_DSP_INVERSES                            \
+   /* Legacy, BT.601 */                                   \
+   { { { 4769,  0,     6537  },                           \
+       { 4769,  -1605, -3330 },                           \
+       { 4769,  8263,  0     } }, { 16, 128, 128 } },     \
+   { { { 4769,  0,     6537  },                           \
+       { 4769,  -1605, -3330 },                           \
+       { 4769,  8263,  0     } }, { 16, 128, 128 } },     \
+   { { { 4096,  0,     5743  },                           \
+       { 4096,  -1410, -2925 },                           \
+       { 4096,  7258,  0     } }, { 0,  128, 128 } },     \
+   /* BT.709 */                                           \
+   { { { 4769,  0,     7343  },                           \
+       { 4769,  -873,  -2183 },                           \
+       { 4769,  8652,  0     } }, { 16, 128, 128 } },     \
+   { { { 4096,  0,     6450  },                           \
+       { 4096,  -767,  -1917 },                           \
+       { 4096,  7601,  0     } }, { 0,  128, 128 } },     \
+   /* BT.2020 */                                          \
+   { { { 4769,  0,     6876  },                           \
+       { 4769,  -767,  -2664 },                           \
+       { 4769,  8773,  0     } }, { 16, 128, 128 } },     \
+   { { { 4096,  0,     6040  },                           \
+       { 4096,  -674,  -2340 },                           \
+       { 4096,  7706,  0     } }, { 0,  128, 128 } }
+
+
+#endif /* !defined (RGB2YCBCR_DSP_COEFFS_H) */
@@ -101,6 +101,82 @@ extern "C" {
  */
 #define OUTPUT_CHANNEL            OUTPUT_CHNL_NAME(DSPLINK_DRVNAME)
 
+/** ============================================================================
+ *  @const  RGB2YCBCR_DSP_ARG_DATA, RGB2YCBCR_DSP_ARG_END
+ *
+ *  @desc   Values the GPP passes as the arg of a buffer. A buffer with
+ *          RGB2YCBCR_DSP_ARG_END is not converted. It is sent back as is and
+ *          ends a session started with zero transfers. They must match the
+ *          ones in gpp/rgb2ycbcr-dsp.h.
+ *  ============================================================================
+ */
+#define RGB2YCBCR_DSP_ARG_DATA      0
+#define RGB2YCBCR_DSP_ARG_END       0xE0D
+
+/** ============================================================================
+ *  @const  RGB2YCBCR_DSP_FORMAT_PACKED, RGB2YCBCR_DSP_FORMAT_I444,
+ *          RGB2YCBCR_DSP_FORMAT_I420, RGB2YCBCR_DSP_FORMAT_NV12,
+ *          RGB2YCBCR_DSP_FORMAT_I422
+ *
+ *  @desc   Layouts the converted pixels of a buffer are written in, given by
+ *          the GPP at load time. PACKED keeps Y, Cb, Cr interleaved. The
+ *          other ones write the Y plane of the buffer followed by its Cb and
+ *          Cr planes, full size for I444, one sample per 2x1 pixels for
+ *          I422, one per 2x2 pixels for I420 and as interleaved Cb, Cr pairs
+ *          for NV12. A subsampled buffer is sent back with the size of its
+ *          planes. They must match the ones in gpp/rgb2ycbcr-dsp.h.
+ *  ============================================================================
+ */
+#define RGB2YCBCR_DSP_FORMAT_PACKED 0
+#define RGB2YCBCR_DSP_FORMAT_I444   1
+#define RGB2YCBCR_DSP_FORMAT_I420   2
+#define RGB2YCBCR_DSP_FORMAT_NV12   3
+#define RGB2YCBCR_DSP_FORMAT_I422   4
+
+/** ============================================================================
+ *  @const  RGB2YCBCR_DSP_FILTER_DROP, RGB2YCBCR_DSP_FILTER_AVG2,
+ *          RGB2YCBCR_DSP_FILTER_BOX
+ *
+ *  @desc   How a subsampled chroma sample is made from the pixels it
+ *          covers. DROP keeps the top left one. AVG2 averages the two
+ *          along the direction the format halves last, the two rows for
+ *          I420 and NV12 and the two columns for I422. BOX averages all of
+ *          them. They must match the ones in gpp/rgb2ycbcr-dsp.h.
+ *  ============================================================================
+ */
+#define RGB2YCBCR_DSP_FILTER_DROP   0
+#define RGB2YCBCR_DSP_FILTER_AVG2   1
+#define RGB2YCBCR_DSP_FILTER_BOX    2
+
+/** ============================================================================
+ *  @const  RGB2YCBCR_DSP_COLOR_XXX
+ *
+ *  @desc   Colorimetries the GPP can ask for at load time. LEGACY is the
+ *          matrix this sample has always used. The other ones are the
+ *          BT.601, BT.709 and BT.2020 matrices, with Y in 16..235 and
+ *          chroma in 16..240 (limited), or every level used (FULL). They
+ *          must match the ones in gpp/rgb2ycbcr-dsp.h.
+ *  ============================================================================
+ */
+#define RGB2YCBCR_DSP_COLOR_LEGACY       0
+#define RGB2YCBCR_DSP_COLOR_BT601        1
+#define RGB2YCBCR_DSP_COLOR_BT601_FULL   2
+#define RGB2YCBCR_DSP_COLOR_BT709        3
+#define RGB2YCBCR_DSP_COLOR_BT709_FULL   4
+#define RGB2YCBCR_DSP_COLOR_BT2020       5
+#define RGB2YCBCR_DSP_COLOR_BT2020_FULL  6
+
+/** ============================================================================
+ *  @const  RGB2YCBCR_DSP_DIR_FORWARD, RGB2YCBCR_DSP_DIR_INVERSE
+ *
+ *  @desc   Direction of the conversion, R, G, B to Y, Cb, Cr or back. The
+ *          inverse reads and writes packed pixels only. They must match
+ *          the ones in gpp/rgb2ycbcr-dsp.h.
+ *  ============================================================================
+ */
+#define RGB2YCBCR_DSP_DIR_FORWARD   0
+#define RGB2YCBCR_DSP_DIR_INVERSE   1
+
 #if defined (CHNL_PCPY_LINK)
 /** ============================================================================
  *  @name   NUM_BUF_SIZES
@@ -0,0 +1,572 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_kernel.c
+ *
+ *  @path   $(DSPLINK)/dsp/src/samples/rgb2ycbcr-dsp/
+ *
+ *  @desc   Color space conversion kernel shared by the TSK and SWI modes.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+/*  ----------------------------------- DSP/BIOS Headers            */
+#include <std.h>
+#include <log.h>
+#include <clk.h>
+
+/*  ----------------------------------- Sample Headers              */
+#include <rgb2ycbcr-dsp_config.h>
+#include <rgb2ycbcr-dsp_kernel.h>
+#include <rgb2ycbcr-dsp_c64p.h>
+
+
+/** ============================================================================
+ *  @const  CLAMP_PIXEL
+ *
+ *  @desc   Clamps a result to a pixel level. The compiler turns it into
+ *          predicated instructions, not branches.
+ *  ============================================================================
+ */
+#define CLAMP_PIXEL(v) (((v) < 0) ? 0 : (((v) > 255) ? 255 : (v)))
+
+
+/** ============================================================================
+ *  @name   trace
+ *
+ *  @desc   trace LOG_Obj used to do LOG_printf
+ *  ============================================================================
+ */
+extern LOG_Obj trace ;
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_kernelStats
+ *
+ *  @desc   Cycle count of the kernel since the last report.
+ *  ============================================================================
+ */
+static RGB2YCBCR_DSP_KernelStats RGB2YCBCR_DSP_kernelStats ;
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_matrices
+ *
+ *  @desc   Matrix of each colorimetry, indexed by RGB2YCBCR_DSP_COLOR_XXX.
+ *          The standard ones are in Q12, with chroma rows summing to zero.
+ *  ============================================================================
+ */
+static const RGB2YCBCR_DSP_Matrix RGB2YCBCR_DSP_matrices [] = {
+    RGB2YCBCR_DSP_MATRICES
+} ;
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_inverses
+ *
+ *  @desc   Inverse matrix of each colorimetry, in Q12, indexed by
+ *          RGB2YCBCR_DSP_COLOR_XXX. The offsets are taken from Y, Cb and Cr
+ *          before the matrix is applied.
+ *  ============================================================================
+ */
+static const RGB2YCBCR_DSP_Matrix RGB2YCBCR_DSP_inverses [] = {
+    RGB2YCBCR_DSP_INVERSES
+} ;
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_matrix, RGB2YCBCR_DSP_inverse
+ *
+ *  @desc   Matrices the kernels convert with.
+ *  ============================================================================
+ */
+static const RGB2YCBCR_DSP_Matrix * RGB2YCBCR_DSP_matrix  = &RGB2YCBCR_DSP_matrices [0] ;
+static const RGB2YCBCR_DSP_Matrix * RGB2YCBCR_DSP_inverse = &RGB2YCBCR_DSP_inverses [0] ;
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_convertC
+ *
+ *  @desc   Portable C kernel. Each pixel is read into registers before
+ *          anything is written, so the conversion can be done in place.
+ *
+ *  @arg    input
+ *              Pixels to convert.
+ *          output
+ *              Buffer receiving the converted pixels. It may be input.
+ *          numPixels
+ *              Number of pixels to convert.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ----------------------------------------------------------------------------
+ */
+static Void RGB2YCBCR_DSP_convertC (Char * input, Char * output, Uint32 numPixels) ;
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_convertInverseC
+ *
+ *  @desc   Portable C inverse kernel. Like the forward one it can convert
+ *          in place.
+ *
+ *  @arg    input
+ *              Pixels to convert.
+ *          output
+ *              Buffer receiving the converted pixels. It may be input.
+ *          numPixels
+ *              Number of pixels to convert.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ----------------------------------------------------------------------------
+ */
+static Void RGB2YCBCR_DSP_convertInverseC (Char * input, Char * output, Uint32 numPixels) ;
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_subsample
+ *
+ *  @desc   Makes one subsampled chroma sample from the pixels it covers.
+ *
+ *  @arg    sample
+ *              Chroma byte of the top left pixel.
+ *          below
+ *              Distance to the same byte one row down, 0 when only a pair
+ *              of columns is covered.
+ *          filter
+ *              One of RGB2YCBCR_DSP_FILTER_XXX.
+ *
+ *  @ret    The chroma sample.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ----------------------------------------------------------------------------
+ */
+static Char RGB2YCBCR_DSP_subsample (Char * sample, Uint32 below, Uint16 filter) ;
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_planarize
+ *
+ *  @desc   Splits converted Y, Cb, Cr pixels into the planes of a format.
+ *          The chroma of I422 is made from pairs of columns, the one of
+ *          I420 and NV12 from 2x2 blocks, which need whole pairs of rows.
+ *
+ *  @arg    input
+ *              Converted pixels, interleaved.
+ *          output
+ *              Buffer receiving the planes. It must not overlap input.
+ *          numPixels
+ *              Number of pixels in input.
+ *          format
+ *              Layout of output, one of RGB2YCBCR_DSP_FORMAT_XXX.
+ *          width
+ *              Width of the frame in pixels.
+ *          filter
+ *              Chroma filter, one of RGB2YCBCR_DSP_FILTER_XXX.
+ *
+ *  @ret    Number of bytes written to output.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ----------------------------------------------------------------------------
+ */
+static Uint32 RGB2YCBCR_DSP_planarize (Char * input,
+                                       Char * output,
+                                       Uint32 numPixels,
+                                       Uint16 format,
+                                       Uint16 width,
+                                       Uint16 filter) ;
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_convert
+ *
+ *  @desc   Converts a buffer of pixels with the fastest kernel built in and
+ *          counts the cycles it takes.
+ *
+ *  @modif  output, RGB2YCBCR_DSP_kernelStats
+ *  ============================================================================
+ */
+Void RGB2YCBCR_DSP_convert (Char * input, Char * output, Uint32 size)
+{
+    Uint32  numPixels = size / 3 ;
+    Uint32  done      = 0 ;
+    LgUns   start ;
+
+    start = CLK_gethtime () ;
+
+#if defined (RGB2YCBCR_DSP_C64P)
+    /* Groups of four pixels go through the packed data kernel */
+    if ((((Uint32) input | (Uint32) output) & 3) == 0) {
+        done = numPixels & ~3u ;
+    }
+    if (done > 0) {
+        RGB2YCBCR_DSP_convertC64P (input, output, done / 4, RGB2YCBCR_DSP_matrix) ;
+    }
+#endif /* if defined (RGB2YCBCR_DSP_C64P) */
+
+    RGB2YCBCR_DSP_convertC (input + (done * 3), output + (done * 3), numPixels - done) ;
+
+    RGB2YCBCR_DSP_kernelStats.cycles += (Uint32) ((CLK_gethtime () - start)
+                                                  * CLK_cpuCyclesPerHtime ()) ;
+    RGB2YCBCR_DSP_kernelStats.pixels += numPixels ;
+    RGB2YCBCR_DSP_kernelStats.calls++ ;
+
+    if (RGB2YCBCR_DSP_kernelStats.calls == KERNEL_LOG_PERIOD) {
+        RGB2YCBCR_DSP_logKernelStats () ;
+    }
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_convertInverse
+ *
+ *  @desc   Converts a buffer of pixels back to R, G, B with the fastest
+ *          inverse kernel built in and counts the cycles it takes.
+ *
+ *  @modif  output, RGB2YCBCR_DSP_kernelStats
+ *  ============================================================================
+ */
+Void RGB2YCBCR_DSP_convertInverse (Char * input, Char * output, Uint32 size)
+{
+    Uint32  numPixels = size / 3 ;
+    Uint32  done      = 0 ;
+    LgUns   start ;
+
+    start = CLK_gethtime () ;
+
+#if defined (RGB2YCBCR_DSP_C64P)
+    if ((((Uint32) input | (Uint32) output) & 3) == 0) {
+        done = numPixels & ~3u ;
+    }
+    if (done > 0) {
+        RGB2YCBCR_DSP_convertInverseC64P (input, output, done / 4, RGB2YCBCR_DSP_inverse) ;
+    }
+#endif /* if defined (RGB2YCBCR_DSP_C64P) */
+
+    RGB2YCBCR_DSP_convertInverseC (input + (done * 3), output + (done * 3), numPixels - done) ;
+
+    RGB2YCBCR_DSP_kernelStats.cycles += (Uint32) ((CLK_gethtime () - start)
+                                                  * CLK_cpuCyclesPerHtime ()) ;
+    RGB2YCBCR_DSP_kernelStats.pixels += numPixels ;
+    RGB2YCBCR_DSP_kernelStats.calls++ ;
+
+    if (RGB2YCBCR_DSP_kernelStats.calls == KERNEL_LOG_PERIOD) {
+        RGB2YCBCR_DSP_logKernelStats () ;
+    }
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_setColorimetry
+ *
+ *  @desc   Points the kernels at the matrices of a colorimetry.
+ *
+ *  @modif  RGB2YCBCR_DSP_matrix, RGB2YCBCR_DSP_inverse
+ *  ============================================================================
+ */
+Void RGB2YCBCR_DSP_setColorimetry (Uint16 colorimetry)
+{
+    Uint16 numMatrices = sizeof (RGB2YCBCR_DSP_matrices)
+                         / sizeof (RGB2YCBCR_DSP_matrices [0]) ;
+
+    if (colorimetry >= numMatrices) {
+        LOG_printf (&trace,
+                    "Colorimetry %d not built in, using the legacy matrix",
+                    colorimetry) ;
+        colorimetry = RGB2YCBCR_DSP_COLOR_LEGACY ;
+    }
+
+    RGB2YCBCR_DSP_matrix  = &RGB2YCBCR_DSP_matrices [colorimetry] ;
+    RGB2YCBCR_DSP_inverse = &RGB2YCBCR_DSP_inverses [colorimetry] ;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_convertPlanar
+ *
+ *  @desc   Converts a buffer in place, then writes its planes to output.
+ *
+ *  @modif  input, output
+ *  ============================================================================
+ */
+Uint32 RGB2YCBCR_DSP_convertPlanar (Char * input,
+                                    Char * output,
+                                    Uint32 size,
+                                    Uint16 format,
+                                    Uint16 width,
+                                    Uint16 filter)
+{
+    RGB2YCBCR_DSP_convert (input, input, size) ;
+
+    return RGB2YCBCR_DSP_planarize (input,
+                                    output,
+                                    size / 3,
+                                    format,
+                                    width,
+                                    filter) ;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_logKernelStats
+ *
+ *  @desc   Logs and restarts the kernel cycle count.
+ *
+ *  @modif  RGB2YCBCR_DSP_kernelStats
+ *  ============================================================================
+ */
+Void RGB2YCBCR_DSP_logKernelStats (Void)
+{
+    if (RGB2YCBCR_DSP_kernelStats.pixels > 0) {
+        LOG_printf (&trace,
+                    "Kernel: %d pixels in %d cycles",
+                    RGB2YCBCR_DSP_kernelStats.pixels,
+                    RGB2YCBCR_DSP_kernelStats.cycles) ;
+    }
+    if (RGB2YCBCR_DSP_kernelStats.pixels >= 100) {
+        LOG_printf (&trace,
+                    "Kernel: %d cycles per 100 pixels",
+                    RGB2YCBCR_DSP_kernelStats.cycles
+                    / (RGB2YCBCR_DSP_kernelStats.pixels / 100)) ;
+    }
+
+    RGB2YCBCR_DSP_kernelStats.calls  = 0 ;
+    RGB2YCBCR_DSP_kernelStats.pixels = 0 ;
+    RGB2YCBCR_DSP_kernelStats.cycles = 0 ;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_convertC
+ *
+ *  @desc   Portable C kernel. The matrix is read once, before the loop.
+ *          The pixels are read as unsigned levels and the results clamped,
+ *          as the C64x+ kernel does.
+ *
+ *  @modif  output
+ *  ----------------------------------------------------------------------------
+ */
+static Void RGB2YCBCR_DSP_convertC (Char * input, Char * output, Uint32 numPixels)
+{
+    const Int   k11 = RGB2YCBCR_DSP_matrix->k [0][0] ;
+    const Int   k12 = RGB2YCBCR_DSP_matrix->k [0][1] ;
+    const Int   k13 = RGB2YCBCR_DSP_matrix->k [0][2] ;
+    const Int   k21 = RGB2YCBCR_DSP_matrix->k [1][0] ;
+    const Int   k22 = RGB2YCBCR_DSP_matrix->k [1][1] ;
+    const Int   k23 = RGB2YCBCR_DSP_matrix->k [1][2] ;
+    const Int   k31 = RGB2YCBCR_DSP_matrix->k [2][0] ;
+    const Int   k32 = RGB2YCBCR_DSP_matrix->k [2][1] ;
+    const Int   k33 = RGB2YCBCR_DSP_matrix->k [2][2] ;
+    const Int   c1  = RGB2YCBCR_DSP_matrix->c [0] ;
+    const Int   c2  = RGB2YCBCR_DSP_matrix->c [1] ;
+    const Int   c3  = RGB2YCBCR_DSP_matrix->c [2] ;
+    Uint32      i ;
+    Int         r, g, b ;
+    Int         y, cb, cr ;
+
+    for (i = 0 ; i < (numPixels * 3) ; i = i + 3) {
+        r = (Uint8) input [i] ;
+        g = (Uint8) input [i + 1] ;
+        b = (Uint8) input [i + 2] ;
+
+        y  = SCALE ((k11 * r) + (k12 * g) + (k13 * b)) + c1 ;
+        cb = SCALE ((k21 * r) + (k22 * g) + (k23 * b)) + c2 ;
+        cr = SCALE ((k31 * r) + (k32 * g) + (k33 * b)) + c3 ;
+
+        output [i]     = (Char) CLAMP_PIXEL (y) ;
+        output [i + 1] = (Char) CLAMP_PIXEL (cb) ;
+        output [i + 2] = (Char) CLAMP_PIXEL (cr) ;
+    }
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_convertInverseC
+ *
+ *  @desc   Portable C inverse kernel. The offsets are folded into the
+ *          rounding term so the arithmetic is the one of the C64x+ kernel.
+ *
+ *  @modif  output
+ *  ----------------------------------------------------------------------------
+ */
+static Void RGB2YCBCR_DSP_convertInverseC (Char * input, Char * output, Uint32 numPixels)
+{
+    const RGB2YCBCR_DSP_Matrix * m = RGB2YCBCR_DSP_inverse ;
+    const Int   k11   = m->k [0][0] ;
+    const Int   k12   = m->k [0][1] ;
+    const Int   k13   = m->k [0][2] ;
+    const Int   k21   = m->k [1][0] ;
+    const Int   k22   = m->k [1][1] ;
+    const Int   k23   = m->k [1][2] ;
+    const Int   k31   = m->k [2][0] ;
+    const Int   k32   = m->k [2][1] ;
+    const Int   k33   = m->k [2][2] ;
+    const Int   bias1 = 2048 - ((k11 * m->c [0]) + (k12 * m->c [1]) + (k13 * m->c [2])) ;
+    const Int   bias2 = 2048 - ((k21 * m->c [0]) + (k22 * m->c [1]) + (k23 * m->c [2])) ;
+    const Int   bias3 = 2048 - ((k31 * m->c [0]) + (k32 * m->c [1]) + (k33 * m->c [2])) ;
+    Uint32      i ;
+    Int         y, cb, cr ;
+    Int         r, g, b ;
+
+    for (i = 0 ; i < (numPixels * 3) ; i = i + 3) {
+        y  = (Uint8) input [i] ;
+        cb = (Uint8) input [i + 1] ;
+        cr = (Uint8) input [i + 2] ;
+
+        r = ((k11 * y) + (k12 * cb) + (k13 * cr) + bias1) >> 12 ;
+        g = ((k21 * y) + (k22 * cb) + (k23 * cr) + bias2) >> 12 ;
+        b = ((k31 * y) + (k32 * cb) + (k33 * cr) + bias3) >> 12 ;
+
+        output [i]     = (Char) CLAMP_PIXEL (r) ;
+        output [i + 1] = (Char) CLAMP_PIXEL (g) ;
+        output [i + 2] = (Char) CLAMP_PIXEL (b) ;
+    }
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_subsample
+ *
+ *  @desc   Averages the chroma bytes the filter takes, as unsigned levels,
+ *          rounding halves up.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+static Char RGB2YCBCR_DSP_subsample (Char * sample, Uint32 below, Uint16 filter)
+{
+    Uns topLeft  = (Uint8) sample [0] ;
+    Uns topRight = (Uint8) sample [3] ;
+
+    if (filter == RGB2YCBCR_DSP_FILTER_AVG2) {
+        if (below == 0) {
+            return (Char) ((topLeft + topRight + 1) >> 1) ;
+        }
+        return (Char) ((topLeft + (Uint8) sample [below] + 1) >> 1) ;
+    }
+
+    if (filter == RGB2YCBCR_DSP_FILTER_BOX) {
+        if (below == 0) {
+            return (Char) ((topLeft + topRight + 1) >> 1) ;
+        }
+        return (Char) ((  topLeft
+                        + topRight
+                        + (Uint8) sample [below]
+                        + (Uint8) sample [below + 3]
+                        + 2) >> 2) ;
+    }
+
+    return sample [0] ;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_planarize
+ *
+ *  @desc   Writes the Y plane, then the chroma planes of the format.
+ *
+ *  @modif  output
+ *  ----------------------------------------------------------------------------
+ */
+static Uint32 RGB2YCBCR_DSP_planarize (Char * input,
+                                       Char * output,
+                                       Uint32 numPixels,
+                                       Uint16 format,
+                                       Uint16 width,
+                                       Uint16 filter)
+{
+    Char *  cb ;
+    Char *  cr ;
+    Char *  pixel ;
+    Uint32  below ;
+    Uint32  rowStep ;
+    Uint32  chromaSize ;
+    Uint32  numRows ;
+    Uint32  row ;
+    Uint32  i ;
+
+    for (i = 0 ; i < numPixels ; i++) {
+        output [i] = input [i * 3] ;
+    }
+
+    /* Without a width to pair rows with there is nothing to subsample */
+    if (width == 0) {
+        format = RGB2YCBCR_DSP_FORMAT_I444 ;
+    }
+
+    if (format == RGB2YCBCR_DSP_FORMAT_I444) {
+        cb = output + numPixels ;
+        cr = cb + numPixels ;
+        for (i = 0 ; i < numPixels ; i++) {
+            cb [i] = input [(i * 3) + 1] ;
+            cr [i] = input [(i * 3) + 2] ;
+        }
+        return numPixels * 3 ;
+    }
+
+    if (format == RGB2YCBCR_DSP_FORMAT_I422) {
+        rowStep    = 1 ;
+        below      = 0 ;
+        chromaSize = numPixels / 2 ;
+    }
+    else {
+        rowStep    = 2 ;
+        below      = width * 3 ;
+        chromaSize = numPixels / 4 ;
+    }
+
+    numRows = numPixels / width ;
+    cb      = output + numPixels ;
+    cr      = cb + chromaSize ;
+    for (row = 0 ; (row + rowStep) <= numRows ; row = row + rowStep) {
+        pixel = input + (row * width * 3) ;
+        for (i = 0 ; i < width ; i = i + 2) {
+            *cb++ = RGB2YCBCR_DSP_subsample (pixel + (i * 3) + 1, below, filter) ;
+            if (format == RGB2YCBCR_DSP_FORMAT_NV12) {
+                *cb++ = RGB2YCBCR_DSP_subsample (pixel + (i * 3) + 2, below, filter) ;
+            }
+            else {
+                *cr++ = RGB2YCBCR_DSP_subsample (pixel + (i * 3) + 2, below, filter) ;
+            }
+        }
+    }
+
+    return numPixels + (2 * chromaSize) ;
+}
@@ -0,0 +1,251 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_kernel.h
+ *
+ *  @path   $(DSPLINK)/dsp/src/samples/rgb2ycbcr-dsp/
+ *
+ *  @desc   Color space conversion kernel shared by the TSK and SWI modes.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RGB2YCBCR_DSP_KERNEL_)
+#define RGB2YCBCR_DSP_KERNEL_
+
+/*  ----------------------------------- Sample Headers              */
+#include <rgb2ycbcr-dsp_coeffs.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_Matrix
+ *
+ *  @desc   Conversion matrix of a colorimetry.
+ *
+ *  @field  k
+ *              Coefficients, one row per output, in the fixed point SCALE
+ *              takes. They fit in 16 bits for the C64x+ multipliers.
+ *  @field  c
+ *              Offsets added to Y, Cb and Cr, or taken from them before an
+ *              inverse matrix is applied.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_Matrix_tag {
+    Int16 k [3][3] ;
+    Int16 c [3] ;
+} RGB2YCBCR_DSP_Matrix ;
+
+
+/** ============================================================================
+ *  @const  KERNEL_LOG_PERIOD
+ *
+ *  @desc   Number of kernel calls between two cycle count reports.
+ *  ============================================================================
+ */
+#define KERNEL_LOG_PERIOD 64
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_KernelStats
+ *
+ *  @desc   Cycle count of the conversion kernel since the last report.
+ *
+ *  @field  calls
+ *              Number of buffers converted.
+ *  @field  pixels
+ *              Number of pixels converted.
+ *  @field  cycles
+ *              CPU cycles spent in the kernel.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_KernelStats_tag {
+    Uint32 calls ;
+    Uint32 pixels ;
+    Uint32 cycles ;
+} RGB2YCBCR_DSP_KernelStats ;
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_convert
+ *
+ *  @desc   Converts interleaved R, G, B bytes to Y, Cb, Cr. The bytes are
+ *          unsigned levels and the results are clamped to 0..255. Trailing
+ *          bytes that do not make a whole pixel are not written.
+ *          The matrix is the one RGB2YCBCR_DSP_setColorimetry () picked.
+ *          By default it is applied in Q12 fixed point with a rounding
+ *          shift. Building with RGB2YCBCR_DSP_EXACT_DIV keeps the original
+ *          matrix and division by 100, and no other colorimetry.
+ *          On the C64x+ the Q12 kernel runs RGB2YCBCR_DSP_convertC64P (),
+ *          unless RGB2YCBCR_DSP_SCALAR_KERNEL is defined. The time spent is
+ *          logged on trace every KERNEL_LOG_PERIOD calls.
+ *
+ *  @arg    input
+ *              Pixels to convert.
+ *          output
+ *              Buffer receiving the converted pixels. It may be input.
+ *          size
+ *              Number of bytes in input.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ============================================================================
+ */
+Void RGB2YCBCR_DSP_convert (Char * input, Char * output, Uint32 size) ;
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_convertInverse
+ *
+ *  @desc   Converts interleaved Y, Cb, Cr bytes back to R, G, B with the
+ *          inverse of the matrix RGB2YCBCR_DSP_setColorimetry () picked.
+ *          The bytes are unsigned levels and the results are clamped to
+ *          0..255. Trailing bytes that do not make a whole pixel are not
+ *          written.
+ *          On the C64x+ it runs RGB2YCBCR_DSP_convertInverseC64P (),
+ *          unless RGB2YCBCR_DSP_SCALAR_KERNEL is defined. The time spent is
+ *          counted with the forward kernel.
+ *
+ *  @arg    input
+ *              Pixels to convert.
+ *          output
+ *              Buffer receiving the converted pixels. It may be input.
+ *          size
+ *              Size of the buffers in bytes.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_convert
+ *  ============================================================================
+ */
+Void RGB2YCBCR_DSP_convertInverse (Char * input, Char * output, Uint32 size) ;
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_setColorimetry
+ *
+ *  @desc   Picks the matrices the kernels convert with, both ways. Each
+ *          colorimetry has its matrices worked out beforehand, so a kernel
+ *          only loads them into registers once per buffer. The legacy
+ *          matrix is ten times a BT.601 one and mostly saturates, it goes
+ *          back with the BT.601 inverse.
+ *
+ *  @arg    colorimetry
+ *              One of RGB2YCBCR_DSP_COLOR_XXX. An unknown one, or any but
+ *              the legacy one with RGB2YCBCR_DSP_EXACT_DIV, is logged on
+ *              trace and the legacy matrix is used.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_convert
+ *  ============================================================================
+ */
+Void RGB2YCBCR_DSP_setColorimetry (Uint16 colorimetry) ;
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_convertPlanar
+ *
+ *  @desc   Converts interleaved R, G, B bytes and writes the result as the
+ *          planes of a format. The input is converted in place first, so
+ *          the kernel of RGB2YCBCR_DSP_convert () is used, then the planes
+ *          are gathered from it. The chroma of the subsampled formats is
+ *          filtered from the pixels each sample covers. I420 and NV12 need
+ *          whole pairs of rows in the buffer, I422 whole rows. With a
+ *          width of 0 they are written as I444.
+ *
+ *  @arg    input
+ *              Pixels to convert. They are overwritten.
+ *          output
+ *              Buffer receiving the planes. It must not overlap input.
+ *          size
+ *              Number of bytes in input.
+ *          format
+ *              Layout of output, one of RGB2YCBCR_DSP_FORMAT_XXX other than
+ *              RGB2YCBCR_DSP_FORMAT_PACKED.
+ *          width
+ *              Width of the frame in pixels.
+ *          filter
+ *              Chroma filter, one of RGB2YCBCR_DSP_FILTER_XXX.
+ *
+ *  @ret    Number of bytes written to output, the size to send back.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_convert
+ *  ============================================================================
+ */
+Uint32 RGB2YCBCR_DSP_convertPlanar (Char * input,
+                                    Char * output,
+                                    Uint32 size,
+                                    Uint16 format,
+                                    Uint16 width,
+                                    Uint16 filter) ;
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_logKernelStats
+ *
+ *  @desc   Logs the cycles per pixel of the conversion kernel since the
+ *          last report on trace, and starts a new count.
+ *
+ *  @arg    None
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_convert
+ *  ============================================================================
+ */
+Void RGB2YCBCR_DSP_logKernelStats (Void) ;
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RGB2YCBCR_DSP_KERNEL_) */
@@ -62,69 +62,72 @@
 /*  ----------------------------------- Sample Headers              */
 #include <rgb2ycbcr-dsp_config.h>
 #include <swirgb2ycbcr-dsp.h>
+#include <rgb2ycbcr-dsp_kernel.h>
 
 /** ============================================================================
- *  @const  DXY or CZ
+ *  @const  FILEID
  *
- *  @desc   Values for the D and C matrix used for color space transformation
- *  D = [0.257   0.502  0.098;
- *      -.148  -0.289  0.438;
- *     0.438  -0.366 -0.071];
- *  C = [16; 128; 128];
+ *  @desc   FILEID needed for SET_FAILURE_REASON macro.
  *  ============================================================================
  */
-#define D11 257
-#define D12 502
-#define D13 98
-#define D21 -148
-#define D22 -289
-#define D23 438
-#define D31 438
-#define D32 -366
-#define D33 -71
-#define C1 16
-#define C2 128
-#define C3 128
+#define FILEID  FID_APP_C
 
 /** ============================================================================
- *  @const  FILEID
+ *  @const  INITIAL_MAILBOX_VAL
  *
- *  @desc   FILEID needed for SET_FAILURE_REASON macro.
+ *  @desc   Initialial mailbox value. The SWI is posted by the GIO callbacks
+ *          and works out what to do from the buffer rings.
  *  ============================================================================
  */
-#define FILEID  FID_APP_C
+#define INITIAL_MAILBOX_VAL 0
 
 /** ============================================================================
- *  @const  READ_MAILBOX_MASK
+ *  @name   xferBufSize
  *
- *  @desc   Read mailbox mask.
+ *  @desc   Size of the buffer size for SWI.
  *  ============================================================================
  */
-#define READ_MAILBOX_MASK   0x1
+extern Uint32 xferBufSize ;
 
 /** ============================================================================
- *  @const  WRITE_MAILBOX_MASK
+ *  @name   numBuffers
  *
- *  @desc   Write mailbox mask.
+ *  @desc   Number of input and output buffers in the SWI rings.
  *  ============================================================================
  */
-#define WRITE_MAILBOX_MASK  0x2
+extern Uint32 numBuffers ;
 
 /** ============================================================================
- *  @const  WRITE_MAILBOX_MASK
+ *  @name   outputFormat
  *
- *  @desc   Initialial mailbox value.
+ *  @desc   Layout of the converted pixels, one of RGB2YCBCR_DSP_FORMAT_XXX.
  *  ============================================================================
  */
-#define INITIAL_MAILBOX_VAL (READ_MAILBOX_MASK | WRITE_MAILBOX_MASK)
+extern Uint16 outputFormat ;
 
 /** ============================================================================
- *  @name   xferBufSize
+ *  @name   frameWidth
  *
- *  @desc   Size of the buffer size for SWI.
+ *  @desc   Width of the frame in pixels.
  *  ============================================================================
  */
-extern Uint32 xferBufSize ;
+extern Uint16 frameWidth ;
+
+/** ============================================================================
+ *  @name   chromaFilter
+ *
+ *  @desc   Filter the chroma planes are subsampled with.
+ *  ============================================================================
+ */
+extern Uint16 chromaFilter ;
+
+/** ============================================================================
+ *  @name   direction
+ *
+ *  @desc   Direction of the conversion, one of RGB2YCBCR_DSP_DIR_XXX.
+ *  ============================================================================
+ */
+extern Uint16 direction ;
 
 #if defined (DSP_BOOTMODE_NOBOOT)
 
@@ -223,6 +226,7 @@ Int SWIRGB2YCBCR_DSP_create (SWIRGB2YCBCR_DSP_TransferInfo ** infoPtr)
     Int                     status      = SYS_OK ;
     SWI_Attrs               swiAttrs    = SWI_ATTRS ;
     SWIRGB2YCBCR_DSP_TransferInfo *  info;
+    Uint16                  i ;
 #if  defined (DSP_BOOTMODE_NOBOOT)
     POOL_Obj                poolObj ;
 
@@ -262,6 +266,8 @@ Int SWIRGB2YCBCR_DSP_create (SWIRGB2YCBCR_DSP_TransferInfo ** infoPtr)
     /* Initialize SWIRGB2YCBCR_DSP_TransferInfo structure */
     if (status == SYS_OK) {
         info->bufferSize = xferBufSize ;
+        info->numBuffers = (numBuffers > SWI_MAX_BUFFERS) ? SWI_MAX_BUFFERS
+                                                          : numBuffers ;
         (info->appReadCb).fxn  = readFinishCb ;
         (info->appReadCb).arg  = (Ptr) info ;
         (info->appWriteCb).fxn = writeFinishCb ;
@@ -301,13 +307,13 @@ Int SWIRGB2YCBCR_DSP_create (SWIRGB2YCBCR_DSP_TransferInfo ** infoPtr)
     }
 
     /* Allocate input and output buffers */
-    if (status == SYS_OK) {
+    for (i = 0 ; (i < info->numBuffers) && (status == SYS_OK) ; i++) {
         status = POOL_alloc (SAMPLE_POOL_ID,
-                             (Ptr *) &(info->inputBuffer),
+                             (Ptr *) &(info->inputBuffers [i]),
                              info->bufferSize) ;
         if (status == SYS_OK) {
             status = POOL_alloc (SAMPLE_POOL_ID,
-                                 (Ptr *) &(info->outputBuffer),
+                                 (Ptr *) &(info->outputBuffers [i]),
                                  info->bufferSize) ;
             if (status != SYS_OK) {
                 SET_FAILURE_REASON (status) ;
@@ -327,30 +333,40 @@ Int SWIRGB2YCBCR_DSP_create (SWIRGB2YCBCR_DSP_TransferInfo ** infoPtr)
  *
  *  @desc   Execute phase of SWIRGB2YCBCR_DSP application. It get the application
  *          started after that SWIs get posted automatically.
+ *          Every input buffer is submitted for reading and every output
+ *          buffer starts in the free ring, so up to numBuffers reads,
+ *          conversions and writes overlap.
  *
  *  @modif  None.
  *  ============================================================================
  */
 Int SWIRGB2YCBCR_DSP_execute (SWIRGB2YCBCR_DSP_TransferInfo * info)
 {
-    Int status = SYS_OK ;
-    Int iomStatus ;
-
-    /* Submit a read request */
-    iomStatus = GIO_submit (info->gioInputChan,
-                            IOM_READ,
-                            info->inputBuffer,
-                            (size_t *) &(info->bufferSize),
-                            &(info->appReadCb)) ;
-
-    if (iomStatus != IOM_PENDING) {
-        status = SYS_EBADIO ;
-        SET_FAILURE_REASON (status) ;
+    Int     status = SYS_OK ;
+    Int     iomStatus ;
+    size_t  size ;
+    Uint16  i ;
+
+    /* All output buffers are free to start with */
+    for (i = 0 ; i < info->numBuffers ; i++) {
+        info->freeBuffers [i] = info->outputBuffers [i] ;
+    }
+    info->freeTail = info->numBuffers ;
+
+    /* Submit a read request for every input buffer */
+    for (i = 0 ; (i < info->numBuffers) && (status == SYS_OK) ; i++) {
+        size = info->bufferSize ;
+        iomStatus = GIO_submit (info->gioInputChan,
+                                IOM_READ,
+                                info->inputBuffers [i],
+                                &size,
+                                &(info->appReadCb)) ;
+
+        if (iomStatus != IOM_PENDING) {
+            status = SYS_EBADIO ;
+            SET_FAILURE_REASON (status) ;
+        }
     }
-
-    /* We don't write for the first time so clearing write bit
-     * from SWI's mailbox */
-    SWI_andn (info->swi, WRITE_MAILBOX_MASK) ;
 
     return status ;
 }
@@ -367,8 +383,9 @@ Int SWIRGB2YCBCR_DSP_execute (SWIRGB2YCBCR_DSP_TransferInfo * info)
  */
 Int SWIRGB2YCBCR_DSP_delete (SWIRGB2YCBCR_DSP_TransferInfo * info)
 {
-    Int status = SYS_OK ;
-    Int iomStatus ;
+    Int     status = SYS_OK ;
+    Int     iomStatus ;
+    Uint16  i ;
 
     if (info != NULL) {
         /* Delete SWI */
@@ -394,14 +411,16 @@ Int SWIRGB2YCBCR_DSP_delete (SWIRGB2YCBCR_DSP_TransferInfo * info)
             }
         }
 
-        /* Deallocate inputBuffer */
-        if (info->inputBuffer != NULL) {
-            POOL_free (SAMPLE_POOL_ID, info->inputBuffer, info->bufferSize) ;
-        }
+        for (i = 0 ; i < info->numBuffers ; i++) {
+            /* Deallocate inputBuffers */
+            if (info->inputBuffers [i] != NULL) {
+                POOL_free (SAMPLE_POOL_ID, info->inputBuffers [i], info->bufferSize) ;
+            }
 
-        /* Deallocate outputBuffer */
-        if (info->outputBuffer != NULL) {
-            POOL_free (SAMPLE_POOL_ID, info->outputBuffer, info->bufferSize) ;
+            /* Deallocate outputBuffers */
+            if (info->outputBuffers [i] != NULL) {
+                POOL_free (SAMPLE_POOL_ID, info->outputBuffers [i], info->bufferSize) ;
+            }
         }
 
         /* Deallocate info structure */
@@ -430,16 +449,20 @@ Int SWIRGB2YCBCR_DSP_delete (SWIRGB2YCBCR_DSP_TransferInfo * info)
 static Void readFinishCb (Ptr arg, Int status, Ptr bufp, Uns size)
 {
     SWIRGB2YCBCR_DSP_TransferInfo * info = (SWIRGB2YCBCR_DSP_TransferInfo *) arg ;
+    Uns                             slot = info->readTail % info->numBuffers ;
 
-    /* Received full buffer from the GPP */
-    info->inputBuffer = bufp ;
+    /* Received a filled buffer from the GPP, the last chunk of a frame
+     * carries only what is left of it
+     */
+    info->readBuffers [slot] = bufp ;
+    info->readWords [slot]   = size ;
 
-    info->readWords = size ;
     if (status != IOM_COMPLETED) {
         SET_FAILURE_REASON (status) ;
     }
     /* Give indication to SWI that READ is over */
-    SWI_andn (info->swi, READ_MAILBOX_MASK) ;
+    info->readTail++ ;
+    SWI_post (info->swi) ;
 }
 
 
@@ -459,22 +482,24 @@ static Void writeFinishCb (Ptr arg, Int status, Ptr bufp, Uns size)
     (Void) size ; /* To remove compiler warning */
 
     /* Received empty buffer from the GPP */
-    info->outputBuffer = bufp ;
+    info->freeBuffers [info->freeTail % info->numBuffers] = bufp ;
 
     if (status != IOM_COMPLETED) {
         SET_FAILURE_REASON(status) ;
     }
     /* Give indication to SWI that WRITE is over */
-    SWI_andn (info->swi, WRITE_MAILBOX_MASK) ;
+    info->freeTail++ ;
+    SWI_post (info->swi) ;
 }
 
 
 /** ----------------------------------------------------------------------------
  *  @func   rgb2ycbcr_dspSWI
  *
- *  @desc   SWI entry point. This SWI runs every time both IOM_READ and
- *          IOM_WRITE request get completed. It puts does processing and put
- *          next IOM_READ and IOM_WRITE requests.
+ *  @desc   SWI entry point. This SWI runs every time an IOM_READ or an
+ *          IOM_WRITE request gets completed. It converts every filled input
+ *          buffer for which a free output buffer is available, and puts the
+ *          next IOM_READ and IOM_WRITE requests for each of them.
  *
  *  @modif  None
  *  ----------------------------------------------------------------------------
@@ -483,46 +508,66 @@ static Void rgb2ycbcr_dspSWI (Arg arg0, Arg arg1)
 {
     Int                    status          = SYS_OK;
     SWIRGB2YCBCR_DSP_TransferInfo * info            = (SWIRGB2YCBCR_DSP_TransferInfo *) arg0;
-    Uns                    numWordsToWrite = info->readWords;
+    size_t                 numWordsToWrite;
+    size_t                 numWordsToRead;
     Int                    iomStatus;
-    Uns i;
-    Uint32                 y,cb,cr;
+    Char *                 inputBuffer;
+    Char *                 outputBuffer;
 
     (Void) arg1 ; /* To remove compiler warning */
 
-    /* Do processing of data here */
-    for (i = 0 ; (i+3) <= info->readWords ; i = i+3) {
-       y = (((D11 * info->inputBuffer[i]) + (D12 * info->inputBuffer[i+1]) + (D13 * info->inputBuffer[i+2])) / 100) + C1;
-       cb = (((D21 * info->inputBuffer[i]) + (D22 * info->inputBuffer[i+1]) + (D23 * info->inputBuffer[i+2])) / 100) + C2;
-       cr = (((D31 * info->inputBuffer[i]) + (D32 * info->inputBuffer[i+1]) + (D33 * info->inputBuffer[i+2])) / 100) + C3;
-
-       info->outputBuffer[i] = y;
-       info->outputBuffer[i+1] = cb;
-       info->outputBuffer[i+2] = cr;
-    }
+    while (   (status == SYS_OK)
+           && (info->readHead != info->readTail)
+           && (info->freeHead != info->freeTail)) {
+        inputBuffer     = info->readBuffers [info->readHead % info->numBuffers] ;
+        numWordsToWrite = info->readWords [info->readHead % info->numBuffers] ;
+        outputBuffer    = info->freeBuffers [info->freeHead % info->numBuffers] ;
+        info->readHead++ ;
+        info->freeHead++ ;
+
+        /* Do processing of data here. The input buffer is about to be
+         * read into again, so planes are converted in place and gathered
+         * from it into the output buffer, which only sends their size back
+         */
+        if (direction == RGB2YCBCR_DSP_DIR_INVERSE) {
+            RGB2YCBCR_DSP_convertInverse (inputBuffer, outputBuffer, numWordsToWrite) ;
+        }
+        else if (outputFormat == RGB2YCBCR_DSP_FORMAT_PACKED) {
+            RGB2YCBCR_DSP_convert (inputBuffer, outputBuffer, numWordsToWrite) ;
+        }
+        else {
+            numWordsToWrite = RGB2YCBCR_DSP_convertPlanar (inputBuffer,
+                                                           outputBuffer,
+                                                           numWordsToWrite,
+                                                           outputFormat,
+                                                           frameWidth,
+                                                           chromaFilter) ;
+        }
 
-    /* Submit a Read data request */
-    iomStatus = GIO_submit (info->gioInputChan,
-                            IOM_READ,
-                            info->inputBuffer,
-                            (size_t *) &(info->bufferSize),
-                            &(info->appReadCb)) ;
+        /* Submit a Read data request */
+        numWordsToRead = info->bufferSize ;
+        iomStatus = GIO_submit (info->gioInputChan,
+                                IOM_READ,
+                                inputBuffer,
+                                &numWordsToRead,
+                                &(info->appReadCb)) ;
 
-    if (iomStatus != IOM_PENDING) {
-        status = SYS_EBADIO ;
-        SET_FAILURE_REASON (status) ;
-    }
+        if (iomStatus != IOM_PENDING) {
+            status = SYS_EBADIO ;
+            SET_FAILURE_REASON (status) ;
+        }
 
-    /* Submit a Write data request */
-    if (status == SYS_OK) {
-        iomStatus = GIO_submit (info->gioOutputChan,
-                                IOM_WRITE,
-                                info->outputBuffer,
-                                &numWordsToWrite,
-                                &(info->appWriteCb)) ;
-    }
-    if (iomStatus != IOM_PENDING) {
-        status = SYS_EBADIO ;
-        SET_FAILURE_REASON (status) ;
+        /* Submit a Write data request */
+        if (status == SYS_OK) {
+            iomStatus = GIO_submit (info->gioOutputChan,
+                                    IOM_WRITE,
+                                    outputBuffer,
+                                    &numWordsToWrite,
+                                    &(info->appWriteCb)) ;
+            if (iomStatus != IOM_PENDING) {
+                status = SYS_EBADIO ;
+                SET_FAILURE_REASON (status) ;
+            }
+        }
     }
 }
@@ -44,11 +44,23 @@ extern "C" {
 #endif /* defined (__cplusplus) */
 
 
+/** ============================================================================
+ *  @const  SWI_MAX_BUFFERS
+ *
+ *  @desc   Maximum number of input and output buffers in the SWI rings.
+ *  ============================================================================
+ */
+#define SWI_MAX_BUFFERS         16
+
+
 /** ============================================================================
  *  @name   SWIRGB2YCBCR_DSP_TransferInfo
  *
  *  @desc   Structure used to keep various information needed by various phases
  *          of the application.
+ *          Filled input buffers and free output buffers are kept in two
+ *          rings. The GIO callbacks only advance the tail of a ring and the
+ *          SWI only advances the head, so neither needs to lock the other.
  *
  *  @field  gioInputChan
  *              Handle input GIO channel.
@@ -58,16 +70,30 @@ extern "C" {
  *              Callback structure for read requests.
  *  @field  appWriteCb
  *              Callback structure for write requests.
- *  @field  inputBuffer
- *              Buffer to receive data from GPP.
- *  @field  outputBuffer
- *              Buffer to send data to GPP.
+ *  @field  inputBuffers
+ *              Buffers allocated to receive data from GPP.
+ *  @field  outputBuffers
+ *              Buffers allocated to send data to GPP.
+ *  @field  readBuffers
+ *              Ring of input buffers filled by the GPP.
  *  @field  readWords
- *              Number of words read from GPP.
+ *              Number of words read from GPP into each readBuffers entry.
+ *  @field  readHead
+ *              Number of filled input buffers taken by the SWI.
+ *  @field  readTail
+ *              Number of input buffers filled by the GPP.
+ *  @field  freeBuffers
+ *              Ring of output buffers returned by the GPP.
+ *  @field  freeHead
+ *              Number of free output buffers taken by the SWI.
+ *  @field  freeTail
+ *              Number of output buffers returned by the GPP.
  *  @field  swi
  *              SWI structure.
  *  @field  bufferSize
  *              Size of buffer.
+ *  @field  numBuffers
+ *              Number of buffers in each ring.
  *  ============================================================================
  */
 typedef struct SWIRGB2YCBCR_DSP_TransferInfo_tag {
@@ -75,11 +101,18 @@ typedef struct SWIRGB2YCBCR_DSP_TransferInfo_tag {
     GIO_Handle      gioOutputChan;
     GIO_AppCallback appReadCb;
     GIO_AppCallback appWriteCb;
-    Char *          inputBuffer;
-    Char *          outputBuffer;
-    Uint16          readWords;
+    Char *          inputBuffers [SWI_MAX_BUFFERS];
+    Char *          outputBuffers [SWI_MAX_BUFFERS];
+    Char *          readBuffers [SWI_MAX_BUFFERS];
+    Uns             readWords [SWI_MAX_BUFFERS];
+    volatile Uns    readHead;
+    volatile Uns    readTail;
+    Char *          freeBuffers [SWI_MAX_BUFFERS];
+    volatile Uns    freeHead;
+    volatile Uns    freeTail;
     SWI_Handle      swi;
-    Uint16          bufferSize;
+    Uint32          bufferSize;
+    Uint16          numBuffers;
 } SWIRGB2YCBCR_DSP_TransferInfo;
 
 
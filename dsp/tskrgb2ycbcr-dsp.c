@@ -60,30 +60,7 @@
 /*  ----------------------------------- Sample Headers              */
 #include <rgb2ycbcr-dsp_config.h>
 #include <tskrgb2ycbcr-dsp.h>
-
-/** ============================================================================
- *  @const  DXY or CZ
- *
- *  @desc   Values for the D and C matrix used for color space transformation
- *  D = [0.257   0.502  0.098;
- *      -.148  -0.289  0.438;
- *     0.438  -0.366 -0.071];
- *  C = [16; 128; 128];
- *  ============================================================================
- */
-#define D11 257
-#define D12 502
-#define D13 98
-#define D21 -148
-#define D22 -289
-#define D23 438
-#define D31 438
-#define D32 -366
-#define D33 -71
-#define C1 16
-#define C2 128
-#define C3 128
-
+#include <rgb2ycbcr-dsp_kernel.h>
 
 /** ============================================================================
  *  @const  FILEID
@@ -108,7 +85,47 @@ extern Uint32 xferBufSize ;
  *          A value of 0 in numTransfers implies infinite iterations.
  *  ============================================================================
  */
-extern Uint16 numTransfers ;
+extern Uint32 numTransfers ;
+
+/** ============================================================================
+ *  @name   numBuffers
+ *
+ *  @desc   Number of buffers streamed between the GPP and the DSP.
+ *  ============================================================================
+ */
+extern Uint32 numBuffers ;
+
+/** ============================================================================
+ *  @name   outputFormat
+ *
+ *  @desc   Layout of the converted pixels, one of RGB2YCBCR_DSP_FORMAT_XXX.
+ *  ============================================================================
+ */
+extern Uint16 outputFormat ;
+
+/** ============================================================================
+ *  @name   frameWidth
+ *
+ *  @desc   Width of the frame in pixels.
+ *  ============================================================================
+ */
+extern Uint16 frameWidth ;
+
+/** ============================================================================
+ *  @name   chromaFilter
+ *
+ *  @desc   Filter the chroma planes are subsampled with.
+ *  ============================================================================
+ */
+extern Uint16 chromaFilter ;
+
+/** ============================================================================
+ *  @name   direction
+ *
+ *  @desc   Direction of the conversion, one of RGB2YCBCR_DSP_DIR_XXX.
+ *  ============================================================================
+ */
+extern Uint16 direction ;
 
 #if defined (DSP_BOOTMODE_NOBOOT)
 /** ============================================================================
@@ -142,6 +159,36 @@ DEV_Attrs dioDevAttrs = {
 } ;
 #endif
 
+/** ----------------------------------------------------------------------------
+ *  @func   TSKRGB2YCBCR_DSP_recycle
+ *
+ *  @desc   Reclaims the oldest buffer sent to the GPP and issues it again on
+ *          the input stream.
+ *
+ *  @arg    info
+ *              Information for transfer.
+ *          requested
+ *              Number of buffers issued on the input stream so far.
+ *          queued
+ *              Number of buffers currently waiting on the input stream.
+ *
+ *  @ret    SYS_OK
+ *              Successful operation.
+ *          SYS_EBADIO
+ *              Failure occured while doing IO.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ----------------------------------------------------------------------------
+ */
+static Int TSKRGB2YCBCR_DSP_recycle (TSKRGB2YCBCR_DSP_TransferInfo * info,
+                                     Uint32 * requested,
+                                     Uint16 * queued) ;
+
+
 /** ============================================================================
  *  @func   TSKRGB2YCBCR_DSP_create
  *
@@ -157,6 +204,7 @@ Int TSKRGB2YCBCR_DSP_create (TSKRGB2YCBCR_DSP_TransferInfo ** infoPtr)
     Int                     status = SYS_OK ;
     TSKRGB2YCBCR_DSP_TransferInfo *  info = NULL ;
     SIO_Attrs               attrs ;
+    Uint16                  numAllocs ;
     Uint16                  i ;
     Uint16                  j ;
 #if  defined (DSP_BOOTMODE_NOBOOT)
@@ -195,7 +243,7 @@ Int TSKRGB2YCBCR_DSP_create (TSKRGB2YCBCR_DSP_TransferInfo ** infoPtr)
         /* Filling up the transfer info structure */
         info->numTransfers =  numTransfers ;
         info->bufferSize   =  xferBufSize ;
-        info->numBuffers   =  TSK_NUM_BUFFERS ;
+        info->numBuffers   =  numBuffers ;
 
         /* Attributes for the stream creation */
         attrs = SIO_ATTRS ;
@@ -222,16 +270,23 @@ Int TSKRGB2YCBCR_DSP_create (TSKRGB2YCBCR_DSP_TransferInfo ** infoPtr)
         }
     }
 
-    /* Allocating all the buffers that will be used in the transfer */
+    /* Allocating all the buffers that will be used in the transfer. Planes
+     * can not be written over the pixels they are read from, so a planar
+     * format needs one more to write them to
+     */
     if (status == SYS_OK) {
-        for (i = 0 ; (i < info->numBuffers) && (status == SYS_OK) ; i++) {
+        numAllocs = info->numBuffers ;
+        if (outputFormat != RGB2YCBCR_DSP_FORMAT_PACKED) {
+            numAllocs++ ;
+        }
+        for (i = 0 ; (i < numAllocs) && (status == SYS_OK) ; i++) {
             status = POOL_alloc (SAMPLE_POOL_ID,
                                  (Ptr *) &(info->buffers [i]),
                                  info->bufferSize) ;
             if (status != SYS_OK) {
                 for (j = 0 ; j < i ; j++) {
                     POOL_free (SAMPLE_POOL_ID,
-                               info->buffers [i],
+                               info->buffers [j],
                                info->bufferSize) ;
                     info->buffers [j] = NULL ;
                 }
@@ -240,6 +295,10 @@ Int TSKRGB2YCBCR_DSP_create (TSKRGB2YCBCR_DSP_TransferInfo ** infoPtr)
         }
     }
 
+    if ((status == SYS_OK) && (numAllocs > info->numBuffers)) {
+        info->scratch = info->buffers [info->numBuffers] ;
+    }
+
     return status ;
 }
 
@@ -248,85 +307,198 @@ Int TSKRGB2YCBCR_DSP_create (TSKRGB2YCBCR_DSP_TransferInfo ** infoPtr)
  *  @func   TSKRGB2YCBCR_DSP_execute
  *
  *  @desc   Execute phase function for the TSKRGB2YCBCR_DSP application. Application
- *          receives the data from the input channel and sends the same data
- *          back on output channel. Channel numbers can be configured through
- *          header file.
+ *          receives the data from the input channel and sends the converted
+ *          data back on output channel. Channel numbers can be configured
+ *          through header file.
+ *          All the buffers are primed on the input stream at startup and
+ *          the task rotates through them, so the next buffer is received
+ *          while the current one is converted and the previous one is sent
+ *          back to the GPP.
+ *          With zero transfers the task runs until a buffer comes with the
+ *          RGB2YCBCR_DSP_ARG_END arg. That buffer is sent back unconverted
+ *          and the buffers still issued on the input stream are dropped.
  *
  *  @modif  None.
  *  ============================================================================
  */
 Int TSKRGB2YCBCR_DSP_execute(TSKRGB2YCBCR_DSP_TransferInfo * info)
 {
-    Int         status  = SYS_OK ;
-    Char *      buffer  = info->buffers [0] ;
-    Arg         arg     = 0 ;
+    Int         status   = SYS_OK ;
+    Char *      buffer   = NULL ;
+    Arg         arg      = 0 ;
+    Char *      converted ;
+    Uint32      sendSize ;
     Uint32      i ;
+    Uint32      j ;
+    Uint32      requested = 0 ;
+    Uint16      queued   = 0 ;
+    Uint16      pending  = 0 ;
+    Bool        ended    = FALSE ;
     Int         nmadus ;
-    Uint32      y,cb,cr;
 
-    /* Execute the rgb2ycbcr-dsp for configured number of transfers
+    /* Prime the input stream with all the buffers
      * A value of 0 in numTransfers implies infinite iterations
      */
+    for (j = 0 ;
+         (   (j < info->numBuffers)
+          && ((info->numTransfers == 0) || (requested < info->numTransfers))
+          && (status == SYS_OK)) ;
+         j++) {
+        status = SIO_issue (info->inputStream,
+                            info->buffers [j],
+                            info->bufferSize,
+                            arg) ;
+        if (status == SYS_OK) {
+            requested++ ;
+            queued++ ;
+        }
+        else {
+            SET_FAILURE_REASON (status) ;
+        }
+    }
+
+    /* Execute the rgb2ycbcr-dsp for configured number of transfers */
     for (i = 0 ;
          (   ((info->numTransfers == 0) || (i < info->numTransfers))
-          && (status == SYS_OK)) ;
+          && (status == SYS_OK)
+          && (!ended)) ;
          i++) {
-        /* Receive a data buffer from GPP */
-        status = SIO_issue(info->inputStream,
-                           buffer,
-                           info->bufferSize,
-                           arg) ;
-        if (status == SYS_OK) {
-            nmadus = SIO_reclaim (info->inputStream,
-                                  (Ptr *) &buffer,
-                                  &arg) ;
-            if (nmadus < 0) {
-                status = -nmadus ;
-                SET_FAILURE_REASON (status) ;
-            }
-            else {
-                info->receivedSize = nmadus ;
-            }
+        /* Receive the oldest filled buffer from GPP */
+        nmadus = SIO_reclaim (info->inputStream,
+                              (Ptr *) &buffer,
+                              &arg) ;
+        if (nmadus < 0) {
+            status = -nmadus ;
+            SET_FAILURE_REASON (status) ;
         }
         else {
-            SET_FAILURE_REASON(status);
+            info->receivedSize = nmadus ;
+            queued-- ;
+            ended = (arg == RGB2YCBCR_DSP_ARG_END) ;
         }
 
-        /* Do processing on this buffer */
-        if (status == SYS_OK) {
-            /* Add code to process the buffer here*/
-            for (i = 0 ; (i+3) <= info->receivedSize ; i = i+3) {
-               y = (((D11 * info->buffers[0][i]) + (D12 * info->buffers[0][i+1]) + (D13 * info->buffers[0][i+2])) / 100) + C1;
-               cb = (((D21 * info->buffers[0][i]) + (D22 * info->buffers[0][i+1]) + (D23 * info->buffers[0][i+2])) / 100) + C2;
-               cr = (((D31 * info->buffers[0][i]) + (D32 * info->buffers[0][i+1]) + (D33 * info->buffers[0][i+2])) / 100) + C3;
-
-               info->buffers[0][i] = y;
-               info->buffers[0][i+1] = cb;
-               info->buffers[0][i+2] = cr;
+        /* The buffer sent on the previous iteration goes back to the input
+         * stream, so the next chunk arrives while this one is converted
+         */
+        if ((status == SYS_OK) && (pending > 0)) {
+            status = TSKRGB2YCBCR_DSP_recycle (info, &requested, &queued) ;
+            pending-- ;
+        }
+
+        /* Do processing on this buffer. The planes go to the scratch buffer,
+         * which is sent instead with the size of the planes, and the
+         * received one becomes the scratch
+         */
+        converted = buffer ;
+        sendSize  = info->receivedSize ;
+        if ((status == SYS_OK) && (!ended)) {
+            if (direction == RGB2YCBCR_DSP_DIR_INVERSE) {
+                RGB2YCBCR_DSP_convertInverse (buffer, buffer, info->receivedSize) ;
+            }
+            else if (info->scratch == NULL) {
+                RGB2YCBCR_DSP_convert (buffer, buffer, info->receivedSize) ;
+            }
+            else {
+                sendSize = RGB2YCBCR_DSP_convertPlanar (buffer,
+                                                        info->scratch,
+                                                        info->receivedSize,
+                                                        outputFormat,
+                                                        frameWidth,
+                                                        chromaFilter) ;
+                converted     = info->scratch ;
+                info->scratch = buffer ;
             }
         }
 
         /* Send the processed buffer back to GPP */
         if (status == SYS_OK) {
             status = SIO_issue(info->outputStream,
-                               buffer,
-                               info->receivedSize,
+                               converted,
+                               sendSize,
                                arg);
-
             if (status == SYS_OK) {
-                nmadus = SIO_reclaim (info->outputStream,
-                                      (Ptr *) &(buffer),
-                                      &arg) ;
-                if (nmadus < 0) {
-                    status = -nmadus ;
-                    SET_FAILURE_REASON (status) ;
-                }
+                pending++ ;
             }
             else {
                 SET_FAILURE_REASON (status) ;
             }
         }
+
+        /* With nothing left on the input stream the buffer just sent is
+         * the only one we can receive into, so wait for it here
+         */
+        if ((status == SYS_OK) && (queued == 0) && (!ended)) {
+            status = TSKRGB2YCBCR_DSP_recycle (info, &requested, &queued) ;
+            pending-- ;
+        }
+    }
+
+    /* Nothing more comes after the end of a session, give back the
+     * buffers still waiting on the input stream
+     */
+    if ((status == SYS_OK) && ended && (queued > 0)) {
+        status = SIO_idle (info->inputStream) ;
+        if (status != SYS_OK) {
+            SET_FAILURE_REASON (status) ;
+        }
+    }
+
+    /* Wait for the last buffers to reach the GPP */
+    while ((status == SYS_OK) && (pending > 0)) {
+        nmadus = SIO_reclaim (info->outputStream,
+                              (Ptr *) &buffer,
+                              &arg) ;
+        if (nmadus < 0) {
+            status = -nmadus ;
+            SET_FAILURE_REASON (status) ;
+        }
+        pending-- ;
+    }
+
+    return status ;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   TSKRGB2YCBCR_DSP_recycle
+ *
+ *  @desc   Reclaims the oldest buffer sent to the GPP and issues it on the
+ *          input stream if more transfers are still expected.
+ *
+ *  @modif  requested, queued
+ *  ----------------------------------------------------------------------------
+ */
+static Int TSKRGB2YCBCR_DSP_recycle (TSKRGB2YCBCR_DSP_TransferInfo * info,
+                                     Uint32 * requested,
+                                     Uint16 * queued)
+{
+    Int     status = SYS_OK ;
+    Char *  buffer = NULL ;
+    Arg     arg    = 0 ;
+    Int     nmadus ;
+
+    nmadus = SIO_reclaim (info->outputStream,
+                          (Ptr *) &buffer,
+                          &arg) ;
+    if (nmadus < 0) {
+        status = -nmadus ;
+        SET_FAILURE_REASON (status) ;
+    }
+    else if (   (info->numTransfers == 0)
+             || (*requested < info->numTransfers)) {
+        status = SIO_issue (info->inputStream,
+                            buffer,
+                            info->bufferSize,
+                            arg) ;
+        if (status == SYS_OK) {
+            (*requested)++ ;
+            (*queued)++ ;
+        }
+        else {
+            SET_FAILURE_REASON (status) ;
+        }
     }
+
     return status ;
 }
 
@@ -365,10 +537,10 @@ Int TSKRGB2YCBCR_DSP_delete (TSKRGB2YCBCR_DSP_TransferInfo * info)
         }
     }
 
-    /* Delete the buffers */
+    /* Delete the buffers, with the scratch one if there is one */
     if (info->numBuffers > 0) {
         for (j = 0 ;
-             (j < info->numBuffers) && (info->buffers [j] != NULL) ;
+             (j <= info->numBuffers) && (info->buffers [j] != NULL) ;
              j++) {
             POOL_free (SAMPLE_POOL_ID, info->buffers [j], info->bufferSize) ;
         }
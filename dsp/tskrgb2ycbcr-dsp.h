@@ -55,7 +55,8 @@ extern "C" {
 /** ============================================================================
  *  @const  TSK_NUM_BUFFERS
  *
- *  @desc   Number of buffers to allocate and use for transfer.
+ *  @desc   Default number of buffers to allocate and use for transfer, when
+ *          the GPP does not give one.
  *  ============================================================================
  */
 #define TSK_NUM_BUFFERS          1
@@ -80,17 +81,22 @@ extern "C" {
  *  @field  numBuffers
  *              Number of valid buffers in "buffers" array.
  *  @field  buffers
- *              Array of buffer pointers.
+ *              Array of buffer pointers. With a planar output format one
+ *              more buffer is allocated after the streamed ones.
+ *  @field  scratch
+ *              Buffer the planes of the next chunk are written to, NULL for
+ *              the packed format.
  *  ============================================================================
  */
 typedef struct TSKRGB2YCBCR_DSP_TransferInfo_tag {
     SIO_Handle inputStream;
     SIO_Handle outputStream;
-    Uint16     numTransfers;
+    Uint32     numTransfers;
     Uint32     bufferSize;
-    Uint16     receivedSize;
-    Uint16     numBuffers;
-    Char *     buffers [MAX_BUFFERS];
+    Uint32     receivedSize;
+    Uint32     numBuffers;
+    Char *     buffers [MAX_BUFFERS + 1];
+    Char *     scratch;
 } TSKRGB2YCBCR_DSP_TransferInfo;
 
 
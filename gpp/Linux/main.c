@@ -37,10 +37,12 @@
 
 /*  ----------------------------------- OS Specific Headers           */
 #include <unistd.h>
+#include <getopt.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdarg.h>
+#include <sys/stat.h>
 
 /*  ----------------------------------- DSP/BIOS Link                 */
 #include <dsplink.h>
@@ -48,6 +50,16 @@
 /*  ----------------------------------- Application Header            */
 #include <rgb2ycbcr-dsp_os.h>
 #include <rgb2ycbcr-dsp.h>
+#include <rgb2ycbcr-dsp_cvt.h>
+#include <rgb2ycbcr-dsp_plan.h>
+#include <rgb2ycbcr-dsp_tune.h>
+#include <rgb2ycbcr-dsp_roundtrip.h>
+#include <rgb2ycbcr-dsp_stats.h>
+#include <rgb2ycbcr-dsp_daemon.h>
+#include <rgb2ycbcr-dsp_client.h>
+#include <rgb2ycbcr-dsp_png.h>
+#include <rgb2ycbcr-dsp_batch.h>
+#include <rgb2ycbcr-dsp_rawio.h>
 
 /* PNG header to manipulate the image */
 #include <png.h>
@@ -64,6 +76,25 @@ png_structp png_ptr;
 png_infop info_ptr;
 int number_of_passes;
 png_bytep * row_pointers;
+FILE * image_fp;
+FILE * image_out_fp;
+Uint32 png_profile = PNG_PROFILE_DEFAULT;
+
+/*  ============================================================================
+ *  @name   ImageFrame
+ *
+ *  @desc   Layout of a frame held in channel buffers. Every chunk holds
+ *          rowsPerChunk whole rows of rowBytes bytes. When streaming, the
+ *          libpng reader and writer the rows go through are kept too.
+ *  ============================================================================
+ */
+typedef struct ImageFrame_tag {
+   Char8 *     fileName;
+   Uint32      rowsPerChunk;
+   Uint32      rowBytes;
+   png_structp readPtr;
+   png_structp writePtr;
+} ImageFrame;
 
 #if defined (__cplusplus)
 extern "C" {
@@ -73,9 +104,108 @@ extern "C" {
 void image_load(
    Char8 * file_name);
 
+void image_open(
+   Char8 * file_name);
+
+void image_close(void);
+
 void image_store(
    Char8 * file_name);
 
+void image_write(
+   Char8 * file_name);
+
+void image_write_open(
+   Char8 * file_name);
+
+void image_write_close(void);
+
+void image_store_raw(
+   Char8  * file_name,
+   Uint32   kind,
+   Char8  * data,
+   Uint32   size,
+   Uint32   format,
+   Uint32   filter);
+
+DSP_STATUS image_load_chunks(
+   Pvoid    arg,
+   Char8 ** chunks,
+   Uint32   numChunks,
+   Uint32   chunkSize);
+
+DSP_STATUS image_store_chunks(
+   Pvoid    arg,
+   Char8 ** chunks,
+   Uint32   numChunks,
+   Uint32   chunkSize);
+
+DSP_STATUS image_read_strip(
+   Pvoid    arg,
+   Char8  * buffer,
+   Uint32   index,
+   Uint32   size);
+
+DSP_STATUS image_write_strip(
+   Pvoid    arg,
+   Char8  * buffer,
+   Uint32   index,
+   Uint32   size);
+
+DSP_STATUS image_convert_session(
+   Char8 * in_name,
+   Char8 * out_name,
+   Uint8   processor_id,
+   int   * convert_failed);
+
+int image_session(
+   Char8 * dsp_executable,
+   Char8 * input,
+   Char8 * output_dir,
+   int     is_list,
+   Char8 * str_buffer_size,
+   Char8 * str_num_buffers,
+   Char8 * str_num_dsp_buffers,
+   Char8 * str_processor_id,
+   Char8 * timing_file);
+
+int video_session(
+   Char8 *                dsp_executable,
+   Char8 *                input,
+   Char8 *                output,
+   Uint32                 in_kind,
+   Uint32                 raw_width,
+   Uint32                 raw_height,
+   RGB2YCBCR_DSP_Kernel * kernel,
+   Uint32                 format,
+   Uint32                 filter,
+   int                    inverse,
+   Char8 *                str_buffer_size,
+   Char8 *                str_num_buffers,
+   Char8 *                str_num_dsp_buffers,
+   Char8 *                str_processor_id,
+   int                    depth_given,
+   Char8 *                timing_file);
+
+void timing_dump(
+   Char8 * file_name);
+
+Uint32 tune_lookup(
+   Char8 * dsp_executable,
+   Char8 * str_buffer_size,
+   Char8 * str_num_buffers,
+   int     depth_given);
+
+Uint32 frame_plan(
+   Char8 *  dsp_executable,
+   Char8 *  str_buffer_size,
+   Char8 *  str_num_buffers,
+   int      depth_given,
+   Uint32   format,
+   Uint32   filter,
+   Char8 ** planes,
+   Uint32 * planes_size);
+
 void abort_(
    const char * s, 
    ...);
@@ -103,25 +233,547 @@ int main (int argc, char ** argv)
    Uint32  numIterations    = 0;
    Char8   strNumIterations[10];
    Char8 * strNumIterationsPtr = NULL;
+   Char8   strNumBuffers[10];
+   Char8   strNumDspBuffers[10];
+   int     numArgs          = 0;
+   int     zeroCopy         = 0;
+   int     streaming        = 0;
+   int     opt;
+   Char8 ** chunks          = NULL;
+   ImageFrame frame;
+   Char8   strChunkSize[12];
+   RGB2YCBCR_DSP_Kernel * kernel = NULL;
+   RGB2YCBCR_DSP_Kernel * hybridKernel = NULL;
+   Char8 * timingFile       = NULL;
+   int     imageList        = 0;
+   Char8 * daemonSocket     = NULL;
+   Char8 * loadSocket       = NULL;
+   Uint32  chunkSize        = 0;
+   int     autotune         = 0;
+   int     depthGiven       = 0;
+   int     inverse          = 0;
+   int     roundTrip        = 0;
+   int     hybrid           = 0;
+   int     pngBench         = 0;
+   Int32   profile;
+   unsigned int numDecoders = 0;
+   unsigned int numEncoders = 0;
+   unsigned int rawWidth    = 0;
+   unsigned int rawHeight   = 0;
+   Uint32  inKind;
+   Uint32  outKind;
+   Int32   format           = RGB2YCBCR_DSP_FORMAT_PACKED;
+   Int32   filter           = RGB2YCBCR_DSP_FILTER_DROP;
+   Int32   colorimetry;
+   Char8 * planes           = NULL;
+   Uint32  planesSize       = 0;
+   unsigned int tuneWidth;
+   unsigned int tuneHeight;
+   RGB2YCBCR_DSP_TuneResult tuned;
+   RGB2YCBCR_DSP_RoundTripResult trip;
+   static struct option longOptions [] = {
+      { "autotune",  no_argument, NULL, 'A' },
+      { "roundtrip", no_argument, NULL, 'R' },
+      { "pngbench",  no_argument, NULL, 'P' },
+      { NULL,        0,           NULL, 0   }
+   };
+   struct stat inputStat;
+
+   snprintf(strNumBuffers, 10, "%u", (unsigned int) DEFAULT_PIPELINE_DEPTH);
+   snprintf(strNumDspBuffers, 10, "%u", (unsigned int) DEFAULT_DSP_BUFFERS);
+
+   /* Options go before the positional arguments */
+   while ((opt = getopt_long(argc, argv, "d:b:zsa:Hf:c:m:e:ir:t:lj:D:L:V", longOptions, NULL)) != -1) {
+      switch (opt) {
+      case 'd':
+         /* Number of buffers kept in flight between GPP and DSP */
+         snprintf(strNumBuffers, 10, "%s", optarg);
+         depthGiven = 1;
+         break;
+      case 'b':
+         /* Number of buffers the DSP streams through */
+         snprintf(strNumDspBuffers, 10, "%s", optarg);
+         break;
+      case 'z':
+         /* Decode into and encode from the channel buffers */
+         zeroCopy = 1;
+         break;
+      case 's':
+         /* Decode, convert and encode strip by strip */
+         streaming = 1;
+         break;
+      case 'a':
+         /* Convert on the GPP with the given kernel instead of the DSP */
+         kernel = RGB2YCBCR_DSP_GetKernel(optarg);
+         if (kernel == NULL) {
+            printf("Unknown GPP kernel %s\n", optarg);
+            argc = 0;
+         }
+         break;
+      case 'H':
+         /* Convert on the GPP alongside the DSP */
+         hybrid = 1;
+         break;
+      case 'f':
+         /* Layout of the converted image */
+         format = RGB2YCBCR_DSP_GetFormat(optarg);
+         if (format < 0) {
+            printf("Unknown output format %s\n", optarg);
+            argc = 0;
+         }
+         break;
+      case 'c':
+         /* How subsampled chroma is filtered */
+         filter = RGB2YCBCR_DSP_GetFilter(optarg);
+         if (filter < 0) {
+            printf("Unknown chroma filter %s\n", optarg);
+            argc = 0;
+         }
+         break;
+      case 'm':
+         /* Matrix of the GPP kernels and of the DSP */
+         colorimetry = RGB2YCBCR_DSP_GetColorimetry(optarg);
+         if (colorimetry < 0) {
+            printf("Unknown colorimetry %s\n", optarg);
+            argc = 0;
+         }
+         else if (DSP_FAILED(RGB2YCBCR_DSP_SetColorimetry(colorimetry))) {
+            argc = 0;
+         }
+         break;
+      case 'e':
+         /* How hard deflate works on the output */
+         profile = RGB2YCBCR_DSP_GetPngProfile(optarg);
+         if (profile < 0) {
+            printf("Unknown encode profile %s\n", optarg);
+            argc = 0;
+         }
+         else {
+            png_profile = profile;
+         }
+         break;
+      case 'i':
+         /* The input holds Y, Cb, Cr, convert it back to R, G, B */
+         inverse = 1;
+         break;
+      case 'r':
+         /* The input holds raw R, G, B frames of that size */
+         if (   (sscanf(optarg, "%ux%u", &rawWidth, &rawHeight) != 2)
+             || (rawWidth == 0) || (rawHeight == 0)) {
+            printf("Invalid raw frame size %s\n", optarg);
+            argc = 0;
+         }
+         break;
+      case 't':
+         /* Write the chunk timings to a CSV or JSON file */
+         timingFile = optarg;
+         break;
+      case 'l':
+         /* The input image is a file listing the images to convert */
+         imageList = 1;
+         break;
+      case 'j':
+         /* Decode and encode the images of a batch on threads */
+         switch (sscanf(optarg, "%u,%u", &numDecoders, &numEncoders)) {
+         case 1:
+            numEncoders = numDecoders;
+            break;
+         case 2:
+            break;
+         default:
+            printf("Invalid number of threads %s\n", optarg);
+            argc = 0;
+            break;
+         }
+         break;
+      case 'D':
+         /* Serve conversions on a UNIX socket */
+         daemonSocket = optarg;
+         break;
+      case 'L':
+         /* Load the daemon listening on a UNIX socket */
+         loadSocket = optarg;
+         break;
+      case 'A':
+         /* Find the fastest chunk size and depth for a resolution */
+         autotune = 1;
+         break;
+      case 'R':
+         /* Convert to Y, Cb, Cr and back, print the speed and the error */
+         roundTrip = 1;
+         break;
+      case 'P':
+         /* Time the encode profiles on a set of images */
+         pngBench = 1;
+         break;
+#if defined (VERIFY_DATA)
+      case 'V':
+         /* Check the GPP kernels against the reference and leave */
+         return DSP_SUCCEEDED(RGB2YCBCR_DSP_VerifyKernels()) ? 0 : 1;
+#endif /* defined (VERIFY_DATA) */
+      default:
+         argc = 0;
+         break;
+      }
+   }
+   numArgs = argc - optind;
+
+   if (inverse && (roundTrip || (format != RGB2YCBCR_DSP_FORMAT_PACKED))) {
+      printf("The inverse reads and writes packed pixels only\n");
+      argc    = 0;
+      numArgs = 0;
+   }
+   else if (inverse && DSP_FAILED(RGB2YCBCR_DSP_SetDirection(RGB2YCBCR_DSP_DIR_INVERSE))) {
+      argc    = 0;
+      numArgs = 0;
+   }
+
+   if (pngBench && (numArgs >= 1)) {
+      /* <Image> ... */
+      return DSP_SUCCEEDED(RGB2YCBCR_DSP_PngBench(&argv [optind], numArgs)) ? 0 : 1;
+   }
 
-   if ((argc != 6) && (argc != 5)) {
-      printf ("Usage : %s <absolute path of DSP executable> "
+   if ((daemonSocket != NULL) && ((numArgs == 2) || (numArgs == 3))) {
+      /* <DSP executable> <Buffer size> [<DSP Processor Id>] */
+      strProcessorId = (numArgs == 3) ? argv [optind + 2] : "0";
+      chunkSize = RGB2YCBCR_DSP_PlanChunk(RGB2YCBCR_DSP_PlanParse(argv [optind + 1]),
+                                          0, 0, atoi(strNumBuffers));
+      snprintf(strChunkSize, 12, "%u", (unsigned int) chunkSize);
+      return DSP_SUCCEEDED(RGB2YCBCR_DSP_DaemonRun(daemonSocket,
+                                                   argv [optind],
+                                                   strChunkSize,
+                                                   strNumBuffers,
+                                                   strNumDspBuffers,
+                                                   strProcessorId)) ? 0 : 1;
+   }
+
+   if (   autotune && ((numArgs == 2) || (numArgs == 3))
+       && (sscanf(argv [optind + 1], "%ux%u", &tuneWidth, &tuneHeight) == 2)) {
+      /* <DSP executable> <Width>x<Height> [<DSP Processor Id>] */
+      strProcessorId = (numArgs == 3) ? argv [optind + 2] : "0";
+      if (DSP_FAILED(RGB2YCBCR_DSP_Tune(argv [optind], tuneWidth, tuneHeight,
+                                        strNumDspBuffers, strProcessorId, &tuned))) {
+         printf("Auto-tuning failed\n");
+         return 1;
+      }
+      printf("Best: chunk %u depth %u, %.2f MB/s, saved in %s\n",
+             (unsigned int) tuned.chunkSize, (unsigned int) tuned.numBuffers,
+             tuned.throughput, TUNE_CACHE_FILE);
+      return DSP_SUCCEEDED(RGB2YCBCR_DSP_TuneSave(TUNE_CACHE_FILE, tuneWidth, tuneHeight,
+                                                  argv [optind], &tuned)) ? 0 : 1;
+   }
+
+   if ((loadSocket != NULL) && (numArgs == 3)) {
+      /* <Clients> <Requests per client> <Frame size> */
+      return DSP_SUCCEEDED(RGB2YCBCR_DSP_LoadGen(loadSocket,
+                                                 atoi(argv [optind]),
+                                                 atoi(argv [optind + 1]),
+                                                 atoi(argv [optind + 2]))) ? 0 : 1;
+   }
+
+   if (   (daemonSocket != NULL) || (loadSocket != NULL) || autotune || pngBench
+       || ((numArgs != 5) && (numArgs != 4))) {
+      printf ("Usage : %s [-d <Pipeline depth>] [-b <DSP buffers>] [-z | -s] [-a <GPP kernel>] [-H] "
+              "[-f <Output format>] [-c <Chroma filter>] [-m <Colorimetry>] [-i] [-r <Width>x<Height>] "
+              "[-t <Timing file>] [-l] "
+              "[-j <Decoders>[,<Encoders>]] [-e <Encode profile>] "
+              "[--roundtrip] "
+              "<absolute path of DSP executable> "
               "<Input image> <Output Image> <Buffer size> < DSP Processor Id >\n"
-              "\n\t For single DSP configuration this is optional argument\n",
-              argv [0]) ;
+              "\n\t For single DSP configuration this is optional argument\n"
+              "\t A list of ids such as 0,1 shares the frame between the DSPs, when\n"
+              "\t the image is copied through the pipeline\n"
+              "\n\t <Buffer size> is rounded down to whole pixels, whole rows when\n"
+              "\t they fit, or picked for the image with auto\n"
+              "\n\t -d : Number of buffers kept in flight, 1 to %d (default %d)\n"
+              "\t -b : Number of buffers the DSP streams through (default %d)\n"
+              "\t -z : Zero-copy, decode and encode the image in the channel buffers\n"
+              "\t -s : Streaming, decode and encode strips as they go through the DSP\n"
+              "\t -a : Convert on the GPP instead of the DSP, with kernel ref or simd\n"
+              "\t -H : Convert on the GPP and the DSPs at once, each taking the next\n"
+              "\t      chunk when free, with the kernel of -a (default simd)\n"
+              "\t -f : Output format, packed (a PNG, default), or i444, i422, i420 or\n"
+              "\t      nv12 planes written raw, or as Y4M if the output ends in .y4m\n"
+              "\t -c : Chroma filter of i422, i420 and nv12, drop (default), avg2 or box\n"
+              "\t -m : Colorimetry, legacy (default), bt601, bt709 or bt2020, limited\n"
+              "\t      range, or full range with a -full suffix, e.g. bt709-full\n"
+              "\t -i : Inverse, the input holds Y, Cb, Cr and is converted back to R, G, B\n"
+              "\t -r : The input holds raw frames of that size, whatever its name\n"
+              "\t -e : Encode profile of the PNG output, default (libpng's own),\n"
+              "\t      fastest, balanced or smallest\n"
+              "\t -t : Write the chunk timings to a file, JSON if it ends in .json, else CSV\n"
+              "\t -l : The input is a file listing one image per line\n"
+              "\t -j : Decode and encode the images of a directory or a list on that\n"
+              "\t      many threads, while the DSP converts others\n"
+              "\t -D <socket> <DSP executable> <Buffer size> [<DSP Processor Id>] :\n"
+              "\t      Keep the DSP loaded and convert frames sent on a UNIX socket\n"
+              "\t -L <socket> <Clients> <Requests> <Frame size> :\n"
+              "\t      Load the daemon and print req/s and latency percentiles\n"
+              "\t --autotune <DSP executable> <Width>x<Height> [<DSP Processor Id>] :\n"
+              "\t      Find the fastest chunk size and depth for a resolution and keep\n"
+              "\t      them in " TUNE_CACHE_FILE ", used when <Buffer size> is auto\n"
+              "\t --roundtrip : Convert the image to Y, Cb, Cr and back, print the speed\n"
+              "\t      of both directions and the PSNR, and store the image that comes back\n"
+              "\t --pngbench <Image> ... :\n"
+              "\t      Encode the images with every encode profile and print the time\n"
+              "\t      and the size of the files\n"
+              "\n\t When the input is a directory or a list, every image is converted\n"
+              "\t with the DSP loaded once, into the output directory\n"
+              "\n\t Inputs ending in .ppm (binary, 8 bit), .y4m (4:4:4, converted back\n"
+              "\t to R, G, B) or .rgb, .yuv and .raw (with -r) are mapped instead of\n"
+              "\t decoded, and every frame they hold is converted with the DSP loaded\n"
+              "\t once. Outputs ending in .ppm, .y4m, .rgb, .yuv or .raw are written\n"
+              "\t as they are, a Y4M output with i444 planes unless -f says otherwise\n"
+#if defined (VERIFY_DATA)
+              "\t -V : Check the reference against a golden model and the GPP kernels\n"
+              "\t      against the reference over all 2^24 values, and exit\n"
+#endif /* defined (VERIFY_DATA) */
+              ,
+              argv [0], MAX_PIPELINE_DEPTH, DEFAULT_PIPELINE_DEPTH,
+              DEFAULT_DSP_BUFFERS) ;
    }
    else {
-      dspExecutable  = argv [1];
-      strImageInput  = argv [2];
-      strImageOutput = argv [3];
-      strBufferSize  = argv [4];
-      if(argc == 5 ) {
+      dspExecutable  = argv [optind];
+      strImageInput  = argv [optind + 1];
+      strImageOutput = argv [optind + 2];
+      strBufferSize  = argv [optind + 3];
+      if(numArgs == 4 ) {
          strProcessorId = "0";
          processorId    = 0;
       }
       else {
-         strProcessorId = argv[5];
-         processorId    = atoi(argv [4]);
+         strProcessorId = argv[optind + 4];
+         processorId    = atoi(argv [optind + 4]);
+      }
+
+      inKind  = (rawWidth != 0) ? RAW_KIND_RAW : RGB2YCBCR_DSP_RawKind(strImageInput);
+      outKind = RGB2YCBCR_DSP_RawKind(strImageOutput);
+
+      if ((inKind != RAW_KIND_NONE) && (roundTrip || imageList)) {
+         printf("The round trip and the lists read PNG images only\n");
+         return 1;
+      }
+
+      if ((inKind == RAW_KIND_Y4M) && !inverse) {
+         /* A Y4M stream holds Y, Cb, Cr, only the inverse has a use for it */
+         if (   (format != RGB2YCBCR_DSP_FORMAT_PACKED)
+             || DSP_FAILED(RGB2YCBCR_DSP_SetDirection(RGB2YCBCR_DSP_DIR_INVERSE))) {
+            printf("The inverse reads and writes packed pixels only\n");
+            return 1;
+         }
+         printf("Y4M input, converting back to R, G, B\n");
+         inverse = 1;
+      }
+
+      if ((outKind == RAW_KIND_Y4M) && (format == RGB2YCBCR_DSP_FORMAT_PACKED) && !roundTrip) {
+         if (inverse) {
+            printf("Y4M holds Y, Cb, Cr, the inverse writes R, G, B\n");
+            return 1;
+         }
+         format = RGB2YCBCR_DSP_FORMAT_I444;
+      }
+
+      if (hybrid && (roundTrip || imageList || (inKind != RAW_KIND_NONE))) {
+         printf("Only a single image converts on the GPP and the DSP at once\n");
+         hybrid = 0;
+      }
+
+      if (hybrid) {
+         /* The kernel converts next to the DSP, not instead of it, in the
+          * frame the copying path keeps
+          */
+         hybridKernel = (kernel != NULL) ? kernel : RGB2YCBCR_DSP_GetKernel("simd");
+         kernel       = NULL;
+         zeroCopy     = 0;
+         streaming    = 0;
+      }
+
+      if ((kernel != NULL) || roundTrip) {
+         /* The in place and streaming modes only drive the DSP channels */
+         zeroCopy  = 0;
+         streaming = 0;
+      }
+
+      if (roundTrip && (format != RGB2YCBCR_DSP_FORMAT_PACKED)) {
+         printf("The round trip goes through packed pixels, output format ignored\n");
+         format = RGB2YCBCR_DSP_FORMAT_PACKED;
+      }
+
+      if (format != RGB2YCBCR_DSP_FORMAT_PACKED) {
+         /* Planes go to a frame of their own, only the copying path has one */
+         zeroCopy  = 0;
+         streaming = 0;
+      }
+
+      if ((inKind != RAW_KIND_NONE) || (outKind != RAW_KIND_NONE)) {
+         /* The in place and streaming modes go through libpng */
+         zeroCopy  = 0;
+         streaming = 0;
+      }
+
+      if (   (strchr(strProcessorId, ',') != NULL) && (kernel == NULL)
+          && (roundTrip || zeroCopy || streaming || imageList || (inKind != RAW_KIND_NONE))) {
+         printf("Only the copying path shares a frame, using DSP %u\n",
+                (unsigned int) processorId);
+      }
+
+      if (   (kernel == NULL) && !roundTrip && (processorId < MAX_PROCESSORS)
+          && (imageList || (   (stat(strImageInput, &inputStat) == 0)
+                            && S_ISDIR(inputStat.st_mode)))) {
+         if (format != RGB2YCBCR_DSP_FORMAT_PACKED) {
+            printf("Many images are written as PNG, output format ignored\n");
+         }
+
+         /* Many images of any size, the chunks only keep pixels whole */
+         chunkSize = RGB2YCBCR_DSP_PlanChunk(RGB2YCBCR_DSP_PlanParse(strBufferSize),
+                                             0, 0, atoi(strNumBuffers));
+         snprintf(strChunkSize, 12, "%u", (unsigned int) chunkSize);
+
+         if (numDecoders > 0) {
+            /* The PNG codec runs on threads around the DSP */
+            return DSP_SUCCEEDED(RGB2YCBCR_DSP_BatchRun(dspExecutable,
+                                                        strImageInput,
+                                                        imageList ? TRUE : FALSE,
+                                                        strImageOutput,
+                                                        strChunkSize,
+                                                        strNumBuffers,
+                                                        strNumDspBuffers,
+                                                        strProcessorId,
+                                                        numDecoders,
+                                                        numEncoders,
+                                                        png_profile)) ? 0 : 1;
+         }
+
+         /* Many images, keep the DSP loaded between them */
+         return image_session(dspExecutable,
+                              strImageInput,
+                              strImageOutput,
+                              imageList,
+                              strChunkSize,
+                              strNumBuffers,
+                              strNumDspBuffers,
+                              strProcessorId,
+                              timingFile);
+      }
+
+      if ((inKind != RAW_KIND_NONE) && ((kernel != NULL) || (processorId < MAX_PROCESSORS))) {
+         /* Every frame of the file, with the DSP loaded once */
+         return video_session(dspExecutable,
+                              strImageInput,
+                              strImageOutput,
+                              inKind,
+                              rawWidth,
+                              rawHeight,
+                              kernel,
+                              format,
+                              filter,
+                              inverse,
+                              strBufferSize,
+                              strNumBuffers,
+                              strNumDspBuffers,
+                              strProcessorId,
+                              depthGiven,
+                              timingFile);
+      }
+
+      if (streaming) {
+         /* Read only the header, rows are decoded as the pipeline asks for them */
+         image_open(strImageInput);
+
+         if (number_of_passes > 1) {
+            /* Interlaced rows only come out complete after the last pass */
+            printf("Interlaced input, streaming disabled\n");
+            image_close();
+            streaming = 0;
+         }
+      }
+
+      if (streaming) {
+         /* Strips hold whole rows so they can be handed to libpng as is */
+         frame.fileName     = strImageOutput;
+         frame.rowBytes     = png_get_rowbytes(png_ptr, info_ptr);
+         frame.rowsPerChunk = RGB2YCBCR_DSP_PlanChunk(tune_lookup(dspExecutable,
+                                                                  strBufferSize,
+                                                                  strNumBuffers,
+                                                                  depthGiven),
+                                                      height * frame.rowBytes,
+                                                      frame.rowBytes,
+                                                      atoi(strNumBuffers))
+                              / frame.rowBytes;
+         if (frame.rowsPerChunk == 0) {
+            frame.rowsPerChunk = 1;
+         }
+         numIterations = (height + frame.rowsPerChunk - 1) / frame.rowsPerChunk;
+         snprintf(strChunkSize, 12, "%u", (unsigned int) (frame.rowsPerChunk * frame.rowBytes));
+         snprintf(strNumIterations, 10, "%u", (unsigned int) numIterations);
+
+         /* The output is encoded while the input is still being decoded */
+         frame.readPtr = png_ptr;
+         image_write_open(strImageOutput);
+         frame.writePtr = png_ptr;
+
+         if (processorId < MAX_PROCESSORS) {
+            RGB2YCBCR_DSP_MainStream (dspExecutable,
+                                      height * frame.rowBytes,
+                                      strChunkSize,
+                                      strNumIterations,
+                                      strNumBuffers,
+                                      strNumDspBuffers,
+                                      strProcessorId,
+                                      image_read_strip,
+                                      image_write_strip,
+                                      &frame);
+            timing_dump(timingFile);
+         }
+
+         image_write_close();
+         image_close();
+         return 0;
+      }
+
+      if (zeroCopy) {
+         /* Read only the header, rows are decoded into the channel buffers */
+         image_open(strImageInput);
+
+         /* Chunks hold whole rows so they can be handed to libpng as is */
+         frame.fileName     = strImageOutput;
+         frame.rowBytes     = png_get_rowbytes(png_ptr, info_ptr);
+         frame.rowsPerChunk = RGB2YCBCR_DSP_PlanChunk(tune_lookup(dspExecutable,
+                                                                  strBufferSize,
+                                                                  strNumBuffers,
+                                                                  depthGiven),
+                                                      height * frame.rowBytes,
+                                                      frame.rowBytes,
+                                                      atoi(strNumBuffers))
+                              / frame.rowBytes;
+         if (frame.rowsPerChunk == 0) {
+            frame.rowsPerChunk = 1;
+         }
+         numIterations = (height + frame.rowsPerChunk - 1) / frame.rowsPerChunk;
+         snprintf(strChunkSize, 12, "%u", (unsigned int) (frame.rowsPerChunk * frame.rowBytes));
+         snprintf(strNumIterations, 10, "%u", (unsigned int) numIterations);
+
+         chunks       = (Char8 **) malloc(sizeof(Char8 *) * numIterations);
+         row_pointers = (png_bytep *) malloc(sizeof(png_bytep) * height);
+
+         if ((processorId < MAX_PROCESSORS) && (chunks != NULL) && (row_pointers != NULL)) {
+            RGB2YCBCR_DSP_MainInPlace (dspExecutable,
+                                       height * frame.rowBytes,
+                                       strChunkSize,
+                                       strNumIterations,
+                                       strNumBuffers,
+                                       strNumDspBuffers,
+                                       strProcessorId,
+                                       chunks,
+                                       image_load_chunks,
+                                       image_store_chunks,
+                                       &frame);
+            timing_dump(timingFile);
+         }
+
+         free(row_pointers);
+         free(chunks);
+         return 0;
       }
 
       /* Read input image */
@@ -133,9 +785,23 @@ int main (int argc, char ** argv)
       /* Create array of data to be processed by the DSP this is a tmp variable to hold data */
       imageData = malloc(sizeof(Char8) * dataSize);
 
-      /* According to the Data Size and the buffer size we calculate how many iterations are needed */
-      numIterations = (Uint32) (dataSize / atoi(strBufferSize));
-      if (0 != (dataSize % atoi(strBufferSize))) {
+      /* Frame receiving the planes of a planar format, and the chunks */
+      chunkSize = frame_plan(dspExecutable,
+                             strBufferSize,
+                             strNumBuffers,
+                             depthGiven,
+                             format,
+                             filter,
+                             &planes,
+                             &planesSize);
+      if (chunkSize == 0) {
+         return -1;
+      }
+      snprintf(strChunkSize, 12, "%u", (unsigned int) chunkSize);
+
+      /* According to the Data Size and the chunk size we calculate how many iterations are needed */
+      numIterations = (Uint32) (dataSize / chunkSize);
+      if (0 != (dataSize % chunkSize)) {
          numIterations += 1;
       }
       snprintf(strNumIterations, 10, "%u", (unsigned int) numIterations);
@@ -167,13 +833,82 @@ int main (int argc, char ** argv)
       /* Do image processing 
          This is the process we are evaluating. Is in charge of 
          send data to the DSP, apply transformation and get it back */
-      if (processorId < MAX_PROCESSORS) {
+      if (roundTrip) {
+         if (   ((kernel != NULL) || (processorId < MAX_PROCESSORS))
+             && DSP_SUCCEEDED(RGB2YCBCR_DSP_RoundTrip(dspExecutable,
+                                                      strChunkSize,
+                                                      strNumBuffers,
+                                                      strNumDspBuffers,
+                                                      strProcessorId,
+                                                      kernel,
+                                                      imageData,
+                                                      dataSize,
+                                                      &trip))) {
+            printf("Round trip on %s: forward %.2f MB/s, inverse %.2f MB/s, "
+                   "PSNR %.2f dB, max error %u\n",
+                   (kernel != NULL) ? kernel->name : "the DSP",
+                   trip.forward, trip.inverse, trip.psnr, (unsigned int) trip.maxError);
+         }
+         else {
+            printf("Round trip failed\n");
+         }
+      }
+      else if (kernel != NULL) {
+         printf("Converting on the GPP with kernel %s\n", kernel->name);
+         if (inverse) {
+            kernel->inverseFxn(imageData, dataSize);
+         }
+         else {
+            kernel->convertFxn(imageData, dataSize);
+         }
+         if (planes != NULL) {
+            RGB2YCBCR_DSP_Planarize(imageData, planes, width * height, format, width, filter);
+         }
+      }
+      else if ((hybridKernel != NULL) && (processorId < MAX_PROCESSORS)) {
+         printf("Chunk size %u bytes, %u chunks, shared with the GPP\n",
+                (unsigned int) chunkSize, (unsigned int) numIterations);
+         RGB2YCBCR_DSP_MainHybrid (dspExecutable,
+                                   imageData,
+                                   dataSize,
+                                   strChunkSize,
+                                   strNumIterationsPtr,
+                                   strNumBuffers,
+                                   strNumDspBuffers,
+                                   strProcessorId,
+                                   hybridKernel->name);
+         timing_dump(timingFile);
+      }
+      else if (processorId < MAX_PROCESSORS) {
+         printf("Chunk size %u bytes, %u chunks\n",
+                (unsigned int) chunkSize, (unsigned int) numIterations);
          RGB2YCBCR_DSP_Main (dspExecutable,
                              imageData,
                              dataSize,
-                             strBufferSize,
+                             strChunkSize,
                              strNumIterationsPtr,
+                             strNumBuffers,
+                             strNumDspBuffers,
                              strProcessorId);
+         timing_dump(timingFile);
+      }
+
+      if (planes != NULL) {
+         /* The planes are the output, the image data is left unconverted */
+         image_store_raw(strImageOutput,
+                         (outKind == RAW_KIND_Y4M) ? RAW_KIND_Y4M : RAW_KIND_RAW,
+                         planes, planesSize, format, filter);
+         free(planes);
+         free(imageData);
+         return 0;
+      }
+
+      if (outKind != RAW_KIND_NONE) {
+         /* Packed pixels written as they are, the rows are not needed */
+         image_store_raw(strImageOutput, outKind, imageData, dataSize,
+                         RGB2YCBCR_DSP_FORMAT_PACKED, filter);
+         free(imageData);
+         return 0;
       }
 
       /* Transfer analized data into the image data we want to store */
@@ -205,6 +940,390 @@ int main (int argc, char ** argv)
 }
 
 /* FUNCTIONS */
+DSP_STATUS image_convert_session(
+   Char8 * in_name,
+   Char8 * out_name,
+   Uint8   processor_id,
+   int   * convert_failed)
+{
+   DSP_STATUS             status;
+   RGB2YCBCR_DSP_PngImage image;
+
+   /* An image that can not be read or written fails alone, the session
+    * goes on with the next one. A failed conversion is told apart, as
+    * the session can not be trusted after it
+    */
+   *convert_failed = 0;
+   status = RGB2YCBCR_DSP_PngRead(in_name, &image);
+   if (DSP_FAILED(status)) {
+      printf("Could not read %s\n", in_name);
+   }
+
+   if (DSP_SUCCEEDED(status)) {
+      status = RGB2YCBCR_DSP_SessionConvert(image.data,
+                                            image.width * image.height * NUMBER_OF_CHANNELS,
+                                            processor_id);
+      if (DSP_FAILED(status)) {
+         printf("Could not convert %s\n", in_name);
+         *convert_failed = 1;
+      }
+   }
+
+   if (DSP_SUCCEEDED(status)) {
+      status = RGB2YCBCR_DSP_PngWrite(out_name, &image, png_profile);
+      if (DSP_FAILED(status)) {
+         printf("Could not write %s\n", out_name);
+      }
+   }
+
+   RGB2YCBCR_DSP_PngFree(&image);
+
+   return status;
+}
+
+int image_session(
+   Char8 * dsp_executable,
+   Char8 * input,
+   Char8 * output_dir,
+   int     is_list,
+   Char8 * str_buffer_size,
+   Char8 * str_num_buffers,
+   Char8 * str_num_dsp_buffers,
+   Char8 * str_processor_id,
+   Char8 * timing_file)
+{
+   DSP_STATUS                status   = DSP_SOK;
+   Uint8                     processor_id;
+   RGB2YCBCR_DSP_BatchSource source;
+   Char8                     in_name[BATCH_MAX_NAME];
+   Char8                     out_name[BATCH_MAX_NAME];
+   int                       failures = 0;
+   int                       convert_failed;
+
+   if (DSP_FAILED(RGB2YCBCR_DSP_BatchOpen(input, is_list ? TRUE : FALSE, output_dir, &source))) {
+      return -1;
+   }
+
+   status = RGB2YCBCR_DSP_SessionCreate(dsp_executable,
+                                        str_buffer_size,
+                                        str_num_buffers,
+                                        str_num_dsp_buffers,
+                                        str_processor_id,
+                                        &processor_id);
+   if (DSP_SUCCEEDED(status)) {
+      /* The timings of every image go to the file at the end */
+      RGB2YCBCR_DSP_StatsKeep(TRUE);
+   }
+
+   while (DSP_SUCCEEDED(status) && RGB2YCBCR_DSP_BatchNext(&source, in_name, out_name)) {
+      printf("Converting %s into %s\n", in_name, out_name);
+      if (DSP_FAILED(image_convert_session(in_name, out_name, processor_id, &convert_failed))) {
+         failures++;
+      }
+
+      if (convert_failed) {
+         /* Chunks of the failed image may still be in the channels, the
+          * next image would take them for its own
+          */
+         printf("Ending the session\n");
+         break;
+      }
+   }
+
+   if (DSP_SUCCEEDED(status)) {
+      timing_dump(timing_file);
+      RGB2YCBCR_DSP_StatsKeep(FALSE);
+      RGB2YCBCR_DSP_SessionDelete(processor_id);
+   }
+   else {
+      failures++;
+   }
+
+   failures += source.numSkipped;
+   RGB2YCBCR_DSP_BatchClose(&source);
+
+   return (failures == 0) ? 0 : 1;
+}
+
+/*  ============================================================================
+ *  @func   video_session
+ *
+ *  @desc   Converts every frame of a PPM, raw or Y4M file into a PPM, raw
+ *          or Y4M file, one after the other through the channels of a
+ *          single session, or with a GPP kernel. The frames are copied out
+ *          of the mapped input and written back with one writev () each.
+ *  ============================================================================
+ */
+int video_session(
+   Char8 *                dsp_executable,
+   Char8 *                input,
+   Char8 *                output,
+   Uint32                 in_kind,
+   Uint32                 raw_width,
+   Uint32                 raw_height,
+   RGB2YCBCR_DSP_Kernel * kernel,
+   Uint32                 format,
+   Uint32                 filter,
+   int                    inverse,
+   Char8 *                str_buffer_size,
+   Char8 *                str_num_buffers,
+   Char8 *                str_num_dsp_buffers,
+   Char8 *                str_processor_id,
+   int                    depth_given,
+   Char8 *                timing_file)
+{
+   DSP_STATUS              status      = DSP_SOK;
+   RGB2YCBCR_DSP_RawInput  in;
+   RGB2YCBCR_DSP_RawOutput out;
+   Uint32                  out_kind    = RGB2YCBCR_DSP_RawKind(output);
+   Char8 *                 pixels      = NULL;
+   Char8 *                 planes      = NULL;
+   Uint32                  planes_size = 0;
+   Uint32                  frame_size;
+   Uint32                  chunk_size  = 0;
+   Char8                   str_chunk_size[12];
+   Uint8                   processor_id;
+   Bool                    session     = FALSE;
+   Uint32                  num_frames  = 0;
+   Real64                  start;
+   Real64                  elapsed;
+
+   if (out_kind == RAW_KIND_NONE) {
+      printf("Frames are written as PPM, raw or Y4M, not as %s\n", output);
+      return -1;
+   }
+
+   if (DSP_FAILED(RGB2YCBCR_DSP_RawOpen(input, in_kind, raw_width, raw_height, &in))) {
+      return -1;
+   }
+   width      = in.width;
+   height     = in.height;
+   frame_size = width * height * NUMBER_OF_CHANNELS;
+
+   pixels = malloc(frame_size);
+   if (pixels == NULL) {
+      status = DSP_EMEMORY;
+   }
+
+   if (DSP_SUCCEEDED(status)) {
+      chunk_size = frame_plan(dsp_executable,
+                              str_buffer_size,
+                              str_num_buffers,
+                              depth_given,
+                              format,
+                              filter,
+                              &planes,
+                              &planes_size);
+      if (chunk_size == 0) {
+         status = DSP_EFAIL;
+      }
+   }
+   snprintf(str_chunk_size, 12, "%u", (unsigned int) chunk_size);
+
+   if (DSP_SUCCEEDED(status)) {
+      status = RGB2YCBCR_DSP_RawCreate(output, out_kind, width, height, format, filter, &out);
+   }
+
+   if (DSP_SUCCEEDED(status) && (kernel == NULL)) {
+      status = RGB2YCBCR_DSP_SessionCreate(dsp_executable,
+                                           str_chunk_size,
+                                           str_num_buffers,
+                                           str_num_dsp_buffers,
+                                           str_processor_id,
+                                           &processor_id);
+      if (DSP_SUCCEEDED(status)) {
+         /* A table per frame would drown the summary, the timings of every
+          * frame go to the file at the end
+          */
+         RGB2YCBCR_DSP_StatsQuiet(TRUE);
+         RGB2YCBCR_DSP_StatsKeep(TRUE);
+         session = TRUE;
+      }
+      else {
+         RGB2YCBCR_DSP_RawFinish(&out);
+      }
+   }
+
+   if (DSP_SUCCEEDED(status)) {
+      if (kernel != NULL) {
+         printf("Converting %ux%u frames on the GPP with kernel %s\n",
+                (unsigned int) width, (unsigned int) height, kernel->name);
+      }
+      else {
+         printf("Converting %ux%u frames, chunk size %u bytes\n",
+                (unsigned int) width, (unsigned int) height, (unsigned int) chunk_size);
+      }
+
+      start = RGB2YCBCR_DSP_GetTime();
+
+      while (DSP_SUCCEEDED(status)) {
+         status = RGB2YCBCR_DSP_RawRead(&in, pixels);
+         if (status == DSP_ENOTFOUND) {
+            status = DSP_SOK;
+            break;
+         }
+         if (DSP_FAILED(status)) {
+            break;
+         }
+
+         if (kernel != NULL) {
+            if (inverse) {
+               kernel->inverseFxn(pixels, frame_size);
+            }
+            else {
+               kernel->convertFxn(pixels, frame_size);
+            }
+            if (planes != NULL) {
+               RGB2YCBCR_DSP_Planarize(pixels, planes, width * height, format, width, filter);
+            }
+         }
+         else {
+            status = RGB2YCBCR_DSP_SessionConvert(pixels, frame_size, processor_id);
+         }
+
+         if (DSP_SUCCEEDED(status)) {
+            status = (planes != NULL) ? RGB2YCBCR_DSP_RawWrite(&out, planes, planes_size)
+                                      : RGB2YCBCR_DSP_RawWrite(&out, pixels, frame_size);
+         }
+         if (DSP_SUCCEEDED(status)) {
+            num_frames++;
+         }
+      }
+
+      elapsed = RGB2YCBCR_DSP_GetTime() - start;
+      printf("%u frames in %.3f s, %.2f frames/s\n",
+             (unsigned int) num_frames, elapsed,
+             (elapsed > 0) ? (num_frames / elapsed) : 0.0);
+
+      if (DSP_FAILED(RGB2YCBCR_DSP_RawFinish(&out)) && DSP_SUCCEEDED(status)) {
+         status = DSP_EFAIL;
+      }
+   }
+
+   if (session) {
+      timing_dump(timing_file);
+      RGB2YCBCR_DSP_StatsKeep(FALSE);
+      RGB2YCBCR_DSP_StatsQuiet(FALSE);
+      RGB2YCBCR_DSP_SessionDelete(processor_id);
+   }
+
+   RGB2YCBCR_DSP_RawClose(&in);
+   free(planes);
+   free(pixels);
+
+   return DSP_SUCCEEDED(status) ? 0 : 1;
+}
+
+void timing_dump(
+   Char8 * file_name)
+{
+   if (file_name != NULL) {
+      RGB2YCBCR_DSP_StatsDump(file_name);
+   }
+   RGB2YCBCR_DSP_StatsFree();
+}
+
+/*  ============================================================================
+ *  @func   tune_lookup
+ *
+ *  @desc   Chunk size to plan from. When the buffer size is auto and the
+ *          resolution of the loaded image has been tuned, the tuned chunk
+ *          size is used, and the tuned depth unless one was given.
+ *  ============================================================================
+ */
+Uint32 tune_lookup(
+   Char8 * dsp_executable,
+   Char8 * str_buffer_size,
+   Char8 * str_num_buffers,
+   int     depth_given)
+{
+   RGB2YCBCR_DSP_TuneResult tuned;
+   Uint32                   requested = RGB2YCBCR_DSP_PlanParse(str_buffer_size);
+
+   if (   (requested == 0)
+       && DSP_SUCCEEDED(RGB2YCBCR_DSP_TuneLoad(TUNE_CACHE_FILE, width, height,
+                                               dsp_executable, &tuned))) {
+      requested = tuned.chunkSize;
+      if (!depth_given) {
+         snprintf(str_num_buffers, 10, "%u", (unsigned int) tuned.numBuffers);
+      }
+      printf("Tuned for %dx%d: chunk %u depth %s\n", width, height,
+             (unsigned int) tuned.chunkSize, str_num_buffers);
+   }
+
+   return requested;
+}
+
+/*  ============================================================================
+ *  @func   frame_plan
+ *
+ *  @desc   Plans the conversion of a frame of the loaded size. A planar
+ *          format gets a buffer for its planes, handed to
+ *          RGB2YCBCR_DSP_SetFormat (), and chunks that do not split the
+ *          rows its chroma is subsampled over. Returns the chunk size, or
+ *          0 when the planes can not be made.
+ *  ============================================================================
+ */
+Uint32 frame_plan(
+   Char8 *  dsp_executable,
+   Char8 *  str_buffer_size,
+   Char8 *  str_num_buffers,
+   int      depth_given,
+   Uint32   format,
+   Uint32   filter,
+   Char8 ** planes,
+   Uint32 * planes_size)
+{
+   Uint32 sizes[RGB2YCBCR_DSP_MAX_PLANES];
+   Uint32 num_planes;
+   Uint32 row_unit   = (Uint32) width * NUMBER_OF_CHANNELS;
+   Bool   whole_rows = FALSE;
+   Uint32 chunk_size;
+
+   *planes      = NULL;
+   *planes_size = 0;
+
+   if (format != RGB2YCBCR_DSP_FORMAT_PACKED) {
+      num_planes = RGB2YCBCR_DSP_PlaneSizes(format, width * height, sizes);
+      while (num_planes > 0) {
+         *planes_size += sizes[--num_planes];
+      }
+      *planes = malloc(*planes_size);
+      if (   (*planes == NULL)
+          || DSP_FAILED(RGB2YCBCR_DSP_SetFormat(format, filter, width, height, *planes))) {
+         printf("Can not write a %dx%d image in planes\n", width, height);
+         free(*planes);
+         *planes = NULL;
+         return 0;
+      }
+
+      /* Chroma is subsampled over pairs of rows, a chunk can not split them.
+       * I422 pairs columns only, whole rows are enough
+       */
+      if ((format == RGB2YCBCR_DSP_FORMAT_I420) || (format == RGB2YCBCR_DSP_FORMAT_NV12)) {
+         row_unit  *= 2;
+         whole_rows = TRUE;
+      }
+      else if (format == RGB2YCBCR_DSP_FORMAT_I422) {
+         whole_rows = TRUE;
+      }
+   }
+
+   /* Chunks hold whole pixels, whole rows when they fit */
+   chunk_size = RGB2YCBCR_DSP_PlanChunk(tune_lookup(dsp_executable,
+                                                    str_buffer_size,
+                                                    str_num_buffers,
+                                                    depth_given),
+                                        (Uint32) (width * height) * NUMBER_OF_CHANNELS,
+                                        row_unit,
+                                        atoi(str_num_buffers));
+   if (whole_rows && ((chunk_size % row_unit) != 0)) {
+      chunk_size = row_unit;
+   }
+
+   return chunk_size;
+}
+
 void abort_(
    const char * s, 
    ...)
@@ -219,6 +1338,24 @@ void abort_(
 
 void image_load(
    Char8 * file_name)
+{
+   image_open(file_name);
+
+   /* read file */
+   if (setjmp(png_jmpbuf(png_ptr)))
+      abort_("[read_png_file] Error during read_image");
+
+   row_pointers = (png_bytep*) malloc(sizeof(png_bytep) * height);
+   for (y=0; y<height; y++)
+      row_pointers[y] = (png_byte*) malloc(png_get_rowbytes(png_ptr,info_ptr));
+
+   png_read_image(png_ptr, row_pointers);
+
+   image_close();
+}
+
+void image_open(
+   Char8 * file_name)
 {
    char header[8];    // 8 is the maximum size that can be checked
 
@@ -259,21 +1396,42 @@ void image_load(
    number_of_passes = png_set_interlace_handling(png_ptr);
    png_read_update_info(png_ptr, info_ptr);
 
+   image_fp = fp;
+}
 
-   /* read file */
-   if (setjmp(png_jmpbuf(png_ptr)))
-      abort_("[read_png_file] Error during read_image");
+void image_close(void)
+{
+   fclose(image_fp);
+   image_fp = NULL;
+}
 
-   row_pointers = (png_bytep*) malloc(sizeof(png_bytep) * height);
+void image_store(
+   Char8 * file_name)
+{
+   image_write(file_name);
+
+   /* cleanup heap allocation */
    for (y=0; y<height; y++)
-      row_pointers[y] = (png_byte*) malloc(png_get_rowbytes(png_ptr,info_ptr));
+      free(row_pointers[y]);
 
-   png_read_image(png_ptr, row_pointers);
+   free(row_pointers);
+}
+
+void image_write(
+   Char8 * file_name)
+{
+   image_write_open(file_name);
+
+   /* write bytes */
+   if (setjmp(png_jmpbuf(png_ptr)))
+      abort_("[write_png_file] Error during writing bytes");
+
+   png_write_image(png_ptr, row_pointers);
 
-   fclose(fp);
+   image_write_close();
 }
 
-void image_store(
+void image_write_open(
    Char8 * file_name)
 {
    /* create file */
@@ -305,29 +1463,168 @@ void image_store(
    png_set_IHDR(png_ptr, info_ptr, width, height,
                 bit_depth, color_type, PNG_INTERLACE_NONE,
                 PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+   RGB2YCBCR_DSP_PngSetProfile(png_ptr, png_profile);
 
    png_write_info(png_ptr, info_ptr);
 
+   image_out_fp = fp;
+}
 
-   /* write bytes */
-   if (setjmp(png_jmpbuf(png_ptr)))
-      abort_("[write_png_file] Error during writing bytes");
-
-   png_write_image(png_ptr, row_pointers);
-
-
+void image_write_close(void)
+{
    /* end write */
    if (setjmp(png_jmpbuf(png_ptr)))
       abort_("[write_png_file] Error during end of write");
 
    png_write_end(png_ptr, NULL);
 
+   fclose(image_out_fp);
+   image_out_fp = NULL;
+}
+
+/*  ============================================================================
+ *  @func   image_store_raw
+ *
+ *  @desc   Writes a converted image without libpng, packed pixels as PPM or
+ *          raw, planes as Y4M or raw. The rows of the image are freed.
+ *  ============================================================================
+ */
+void image_store_raw(
+   Char8  * file_name,
+   Uint32   kind,
+   Char8  * data,
+   Uint32   size,
+   Uint32   format,
+   Uint32   filter)
+{
+   RGB2YCBCR_DSP_RawOutput output;
+
+   if (   DSP_FAILED(RGB2YCBCR_DSP_RawCreate(file_name, kind, width, height,
+                                            format, filter, &output))
+       || DSP_FAILED(RGB2YCBCR_DSP_RawWrite(&output, data, size))
+       || DSP_FAILED(RGB2YCBCR_DSP_RawFinish(&output)))
+      abort_("[write_raw_file] Error writing %s", file_name);
+
    /* cleanup heap allocation */
    for (y=0; y<height; y++)
       free(row_pointers[y]);
 
    free(row_pointers);
-   fclose(fp);
+}
+
+/*  ============================================================================
+ *  @func   image_load_chunks
+ *
+ *  @desc   Decodes the image opened by image_open () straight into the
+ *          channel buffers, rowsPerChunk rows per buffer.
+ *  ============================================================================
+ */
+DSP_STATUS image_load_chunks(
+   Pvoid    arg,
+   Char8 ** chunks,
+   Uint32   numChunks,
+   Uint32   chunkSize)
+{
+   ImageFrame * frame = (ImageFrame *) arg;
+
+   for (y = 0; y < height; y++) {
+      row_pointers[y] = (png_bytep) (chunks[y / frame->rowsPerChunk]
+                                     + ((y % frame->rowsPerChunk) * frame->rowBytes));
+   }
+
+   /* read file */
+   if (setjmp(png_jmpbuf(png_ptr)))
+      abort_("[read_png_file] Error during read_image");
+
+   png_read_image(png_ptr, row_pointers);
+
+   image_close();
+
+   return DSP_SOK;
+}
+
+/*  ============================================================================
+ *  @func   image_store_chunks
+ *
+ *  @desc   Encodes the image straight from the channel buffers returned by
+ *          the DSP.
+ *  ============================================================================
+ */
+DSP_STATUS image_store_chunks(
+   Pvoid    arg,
+   Char8 ** chunks,
+   Uint32   numChunks,
+   Uint32   chunkSize)
+{
+   ImageFrame * frame = (ImageFrame *) arg;
+
+   /* The DSP may have returned the chunks in other buffers */
+   for (y = 0; y < height; y++) {
+      row_pointers[y] = (png_bytep) (chunks[y / frame->rowsPerChunk]
+                                     + ((y % frame->rowsPerChunk) * frame->rowBytes));
+   }
+
+   image_write(frame->fileName);
+
+   return DSP_SOK;
+}
+
+/*  ============================================================================
+ *  @func   image_read_strip
+ *
+ *  @desc   Decodes the next rowsPerChunk rows of the input image straight
+ *          into a channel buffer.
+ *  ============================================================================
+ */
+DSP_STATUS image_read_strip(
+   Pvoid    arg,
+   Char8  * buffer,
+   Uint32   index,
+   Uint32   size)
+{
+   ImageFrame * frame = (ImageFrame *) arg;
+   Uint32       row;
+
+   if (setjmp(png_jmpbuf(frame->readPtr)))
+      abort_("[read_png_file] Error during read_row");
+
+   for (row = index * frame->rowsPerChunk;
+        (row < (index + 1) * frame->rowsPerChunk) && (row < (Uint32) height);
+        row++) {
+      png_read_row(frame->readPtr, (png_bytep) buffer, NULL);
+      buffer += frame->rowBytes;
+   }
+
+   return DSP_SOK;
+}
+
+/*  ============================================================================
+ *  @func   image_write_strip
+ *
+ *  @desc   Encodes the rows of a converted strip straight from the channel
+ *          buffer the DSP returned.
+ *  ============================================================================
+ */
+DSP_STATUS image_write_strip(
+   Pvoid    arg,
+   Char8  * buffer,
+   Uint32   index,
+   Uint32   size)
+{
+   ImageFrame * frame = (ImageFrame *) arg;
+   Uint32       row;
+
+   if (setjmp(png_jmpbuf(frame->writePtr)))
+      abort_("[write_png_file] Error during write_row");
+
+   for (row = index * frame->rowsPerChunk;
+        (row < (index + 1) * frame->rowsPerChunk) && (row < (Uint32) height);
+        row++) {
+      png_write_row(frame->writePtr, (png_bytep) buffer);
+      buffer += frame->rowBytes;
+   }
+
+   return DSP_SOK;
 }
 
 #if defined (__cplusplus)
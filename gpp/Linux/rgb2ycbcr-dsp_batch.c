@@ -0,0 +1,658 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_batch.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/Linux/
+ *
+ *  @desc   Batch conversion with PNG decode and encode threads around a
+ *          DSP session.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+/*  ----------------------------------- OS Specific Headers           */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <pthread.h>
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <rgb2ycbcr-dsp.h>
+#include <rgb2ycbcr-dsp_os.h>
+#include <rgb2ycbcr-dsp_stats.h>
+#include <rgb2ycbcr-dsp_png.h>
+#include <rgb2ycbcr-dsp_batch.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_BatchImage
+ *
+ *  @desc   An image on its way through the stages.
+ *
+ *  @field  inName, outName
+ *              File the image is read from and written to.
+ *  @field  png
+ *              Pixels of the image. The DSP converts them in place.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_BatchImage_tag {
+   Char8                  inName [BATCH_MAX_NAME];
+   Char8                  outName [BATCH_MAX_NAME];
+   RGB2YCBCR_DSP_PngImage png;
+} RGB2YCBCR_DSP_BatchImage;
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_BatchQueue
+ *
+ *  @desc   Bounded queue of images between two stages.
+ *
+ *  @field  lock
+ *              Guards the queue.
+ *  @field  notEmpty, notFull
+ *              Signaled when an image is put, and taken.
+ *  @field  images
+ *              Ring of the queued images.
+ *  @field  head, count
+ *              First image of the ring and number of images queued.
+ *  @field  numProducers
+ *              Threads still putting images. Once none is left, an empty
+ *              queue stays empty.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_BatchQueue_tag {
+   pthread_mutex_t            lock;
+   pthread_cond_t             notEmpty;
+   pthread_cond_t             notFull;
+   RGB2YCBCR_DSP_BatchImage * images [BATCH_QUEUE_DEPTH];
+   Uint32                     head;
+   Uint32                     count;
+   Uint32                     numProducers;
+} RGB2YCBCR_DSP_BatchQueue;
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_Batch
+ *
+ *  @desc   State shared by the stages of a batch.
+ *
+ *  @field  lock
+ *              Guards the source of the names and the counters.
+ *  @field  source
+ *              Images of the batch.
+ *  @field  decoded, converted
+ *              Queues into and out of the DSP.
+ *  @field  profile
+ *              Encode profile, one of PNG_PROFILE_XXX.
+ *  @field  decodeBusy, convertBusy, encodeBusy
+ *              Time every stage spent working, summed over its threads.
+ *  @field  numImages, numFailures
+ *              Images written, and images that could not be.
+ *  @field  stopped
+ *              Set once a conversion failed. The session can not convert
+ *              another image, the decoders take no more names.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_Batch_tag {
+   pthread_mutex_t           lock;
+   RGB2YCBCR_DSP_BatchSource source;
+   RGB2YCBCR_DSP_BatchQueue  decoded;
+   RGB2YCBCR_DSP_BatchQueue  converted;
+   Uint32                    profile;
+   Real64                    decodeBusy;
+   Real64                    convertBusy;
+   Real64                    encodeBusy;
+   Uint32                    numImages;
+   Uint32                    numFailures;
+   Bool                      stopped;
+} RGB2YCBCR_DSP_Batch;
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_BatchQueueInit
+ *
+ *  @desc   Initializes an empty queue fed by numProducers threads.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_BatchQueueInit(
+   OUT RGB2YCBCR_DSP_BatchQueue * queue,
+   IN  Uint32                     numProducers)
+{
+   pthread_mutex_init(&queue->lock, NULL);
+   pthread_cond_init(&queue->notEmpty, NULL);
+   pthread_cond_init(&queue->notFull, NULL);
+   queue->head         = 0;
+   queue->count        = 0;
+   queue->numProducers = numProducers;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_BatchQueueDestroy
+ *
+ *  @desc   Releases what RGB2YCBCR_DSP_BatchQueueInit () set up.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_BatchQueueDestroy(
+   IN RGB2YCBCR_DSP_BatchQueue * queue)
+{
+   pthread_cond_destroy(&queue->notFull);
+   pthread_cond_destroy(&queue->notEmpty);
+   pthread_mutex_destroy(&queue->lock);
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_BatchQueuePut
+ *
+ *  @desc   Queues an image, waiting while the queue is full.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_BatchQueuePut(
+   IN RGB2YCBCR_DSP_BatchQueue * queue,
+   IN RGB2YCBCR_DSP_BatchImage * image)
+{
+   pthread_mutex_lock(&queue->lock);
+   while (queue->count == BATCH_QUEUE_DEPTH) {
+      pthread_cond_wait(&queue->notFull, &queue->lock);
+   }
+   queue->images [(queue->head + queue->count) % BATCH_QUEUE_DEPTH] = image;
+   queue->count++;
+   pthread_cond_signal(&queue->notEmpty);
+   pthread_mutex_unlock(&queue->lock);
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_BatchQueueGet
+ *
+ *  @desc   Takes the next image, waiting while the queue is empty. Returns
+ *          NULL once the queue is empty and every producer is done.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC RGB2YCBCR_DSP_BatchImage * RGB2YCBCR_DSP_BatchQueueGet(
+   IN RGB2YCBCR_DSP_BatchQueue * queue)
+{
+   RGB2YCBCR_DSP_BatchImage * image = NULL;
+
+   pthread_mutex_lock(&queue->lock);
+   while ((queue->count == 0) && (queue->numProducers > 0)) {
+      pthread_cond_wait(&queue->notEmpty, &queue->lock);
+   }
+   if (queue->count > 0) {
+      image       = queue->images [queue->head];
+      queue->head = (queue->head + 1) % BATCH_QUEUE_DEPTH;
+      queue->count--;
+      pthread_cond_signal(&queue->notFull);
+   }
+   pthread_mutex_unlock(&queue->lock);
+
+   return image;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_BatchQueueDone
+ *
+ *  @desc   Tells the queue one of its producers is done, and wakes the
+ *          consumers up when it was the last one.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_BatchQueueDone(
+   IN RGB2YCBCR_DSP_BatchQueue * queue)
+{
+   pthread_mutex_lock(&queue->lock);
+   queue->numProducers--;
+   if (queue->numProducers == 0) {
+      pthread_cond_broadcast(&queue->notEmpty);
+   }
+   pthread_mutex_unlock(&queue->lock);
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_BatchImageFree
+ *
+ *  @desc   Frees an image and its pixels.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_BatchImageFree(
+   IN RGB2YCBCR_DSP_BatchImage * image)
+{
+   RGB2YCBCR_DSP_PngFree(&image->png);
+   free(image);
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_BatchDecodeRun
+ *
+ *  @desc   Body of a decode thread. Takes the names one at a time, so the
+ *          threads share the images in the order they become free.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void * RGB2YCBCR_DSP_BatchDecodeRun(Void * arg)
+{
+   RGB2YCBCR_DSP_Batch *      batch = (RGB2YCBCR_DSP_Batch *) arg;
+   RGB2YCBCR_DSP_BatchImage * image;
+   Bool                       found;
+   Real64                     start;
+   DSP_STATUS                 status;
+
+   for (;;) {
+      image = (RGB2YCBCR_DSP_BatchImage *) calloc(1, sizeof(RGB2YCBCR_DSP_BatchImage));
+      if (image == NULL) {
+         break;
+      }
+
+      pthread_mutex_lock(&batch->lock);
+      found =    !batch->stopped
+              && RGB2YCBCR_DSP_BatchNext(&batch->source, image->inName, image->outName);
+      pthread_mutex_unlock(&batch->lock);
+      if (!found) {
+         free(image);
+         break;
+      }
+
+      start  = RGB2YCBCR_DSP_GetTime();
+      status = RGB2YCBCR_DSP_PngRead(image->inName, &image->png);
+
+      pthread_mutex_lock(&batch->lock);
+      batch->decodeBusy += RGB2YCBCR_DSP_GetTime() - start;
+      if (DSP_FAILED(status)) {
+         batch->numFailures++;
+      }
+      pthread_mutex_unlock(&batch->lock);
+
+      if (DSP_FAILED(status)) {
+         printf("Could not read %s\n", image->inName);
+         RGB2YCBCR_DSP_BatchImageFree(image);
+      }
+      else {
+         RGB2YCBCR_DSP_BatchQueuePut(&batch->decoded, image);
+      }
+   }
+
+   RGB2YCBCR_DSP_BatchQueueDone(&batch->decoded);
+
+   return NULL;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_BatchEncodeRun
+ *
+ *  @desc   Body of an encode thread.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void * RGB2YCBCR_DSP_BatchEncodeRun(Void * arg)
+{
+   RGB2YCBCR_DSP_Batch *      batch = (RGB2YCBCR_DSP_Batch *) arg;
+   RGB2YCBCR_DSP_BatchImage * image;
+   Real64                     start;
+   DSP_STATUS                 status;
+
+   while ((image = RGB2YCBCR_DSP_BatchQueueGet(&batch->converted)) != NULL) {
+      start  = RGB2YCBCR_DSP_GetTime();
+      status = RGB2YCBCR_DSP_PngWrite(image->outName, &image->png, batch->profile);
+
+      pthread_mutex_lock(&batch->lock);
+      batch->encodeBusy += RGB2YCBCR_DSP_GetTime() - start;
+      if (DSP_FAILED(status)) {
+         batch->numFailures++;
+      }
+      else {
+         batch->numImages++;
+      }
+      pthread_mutex_unlock(&batch->lock);
+
+      if (DSP_FAILED(status)) {
+         printf("Could not write %s\n", image->outName);
+      }
+      RGB2YCBCR_DSP_BatchImageFree(image);
+   }
+
+   return NULL;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_BatchOpen
+ *
+ *  @desc   Opens the list or the directory of the images.
+ *
+ *  @modif  source
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_BatchOpen(
+   IN  Char8 *                     input,
+   IN  Bool                        isList,
+   IN  Char8 *                     outputDir,
+   OUT RGB2YCBCR_DSP_BatchSource * source)
+{
+   memset(source, 0, sizeof(*source));
+   source->input     = input;
+   source->outputDir = outputDir;
+   if (isList) {
+      source->list = fopen(input, "r");
+   }
+   else {
+      source->dir = opendir(input);
+   }
+   if ((source->list == NULL) && (source->dir == NULL)) {
+      printf("Could not open %s\n", input);
+      return DSP_EFAIL;
+   }
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_BatchNext
+ *
+ *  @desc   A list line that fills the buffer without its end of line is
+ *          read on to its end, and skipped unless only a carriage return
+ *          was left of it.
+ *
+ *  @modif  source
+ *  ============================================================================
+ */
+NORMAL_API Bool RGB2YCBCR_DSP_BatchNext(
+   IN  RGB2YCBCR_DSP_BatchSource * source,
+   OUT Char8 *                     inName,
+   OUT Char8 *                     outName)
+{
+   struct dirent * entry;
+   Char8 *         base;
+   size_t          length;
+   Bool            tooLong;
+   int             c;
+
+   for (;;) {
+      if (source->list != NULL) {
+         if (fgets(inName, BATCH_MAX_NAME, source->list) == NULL) {
+            return FALSE;
+         }
+         length = strcspn(inName, "\r\n");
+         if ((inName [length] == '\0') && (length == (BATCH_MAX_NAME - 1))) {
+            tooLong = FALSE;
+            while (((c = fgetc(source->list)) != EOF) && (c != '\n')) {
+               if (c != '\r') {
+                  tooLong = TRUE;
+               }
+            }
+            if (tooLong) {
+               printf("Name too long, skipping %s...\n", inName);
+               source->numSkipped++;
+               continue;
+            }
+         }
+         inName [length] = '\0';
+         if (length == 0) {
+            continue;
+         }
+      }
+      else {
+         entry = readdir(source->dir);
+         if (entry == NULL) {
+            return FALSE;
+         }
+         length = strlen(entry->d_name);
+         if ((length < 4) || (strcmp(entry->d_name + length - 4, ".png") != 0)) {
+            continue;
+         }
+         if (snprintf(inName, BATCH_MAX_NAME, "%s/%s",
+                      source->input, entry->d_name) >= BATCH_MAX_NAME) {
+            printf("Name too long, skipping %s/%s\n", source->input, entry->d_name);
+            source->numSkipped++;
+            continue;
+         }
+      }
+
+      /* The output keeps the name of the input */
+      base = strrchr(inName, '/');
+      base = (base == NULL) ? inName : base + 1;
+      if (snprintf(outName, BATCH_MAX_NAME, "%s/%s",
+                   source->outputDir, base) >= BATCH_MAX_NAME) {
+         printf("Name too long, skipping %s/%s\n", source->outputDir, base);
+         source->numSkipped++;
+         continue;
+      }
+
+      return TRUE;
+   }
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_BatchClose
+ *
+ *  @desc   Closes the list or the directory of the images.
+ *
+ *  @modif  source
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_BatchClose(
+   IN RGB2YCBCR_DSP_BatchSource * source)
+{
+   if (source->list != NULL) {
+      fclose(source->list);
+      source->list = NULL;
+   }
+   if (source->dir != NULL) {
+      closedir(source->dir);
+      source->dir = NULL;
+   }
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_BatchRun
+ *
+ *  @desc   The calling thread feeds the DSP, so the session is only driven
+ *          from one thread. Each stage stops once the one before it is done
+ *          and its queue is empty.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_BatchRun(
+   IN Char8 * dspExecutable,
+   IN Char8 * input,
+   IN Bool    isList,
+   IN Char8 * outputDir,
+   IN Char8 * strBufferSize,
+   IN Char8 * strNumBuffers,
+   IN Char8 * strNumDspBuffers,
+   IN Char8 * strProcessorId,
+   IN Uint32  numDecoders,
+   IN Uint32  numEncoders,
+   IN Uint32  profile)
+{
+   DSP_STATUS                 status     = DSP_SOK;
+   Uint32                     numStarted = 0;
+   Uint32                     i;
+   Uint8                      processorId;
+   pthread_t                  decoders [BATCH_MAX_THREADS];
+   pthread_t                  encoders [BATCH_MAX_THREADS];
+   RGB2YCBCR_DSP_Batch        batch;
+   RGB2YCBCR_DSP_BatchImage * image;
+   Real64                     start;
+   Real64                     elapsed;
+   Real64                     convertStart;
+   DSP_STATUS                 convertStatus;
+
+   if (   (numDecoders == 0) || (numDecoders > BATCH_MAX_THREADS)
+       || (numEncoders == 0) || (numEncoders > BATCH_MAX_THREADS)) {
+      printf("Between 1 and %u decode and encode threads\n", (unsigned int) BATCH_MAX_THREADS);
+      return DSP_EINVALIDARG;
+   }
+
+   memset(&batch, 0, sizeof(batch));
+   batch.profile = profile;
+   status = RGB2YCBCR_DSP_BatchOpen(input, isList, outputDir, &batch.source);
+   if (DSP_FAILED(status)) {
+      return status;
+   }
+
+   status = RGB2YCBCR_DSP_SessionCreate(dspExecutable,
+                                        strBufferSize,
+                                        strNumBuffers,
+                                        strNumDspBuffers,
+                                        strProcessorId,
+                                        &processorId);
+
+   if (DSP_SUCCEEDED(status)) {
+      /* A table per image would drown the summary */
+      RGB2YCBCR_DSP_StatsQuiet(TRUE);
+
+      pthread_mutex_init(&batch.lock, NULL);
+      RGB2YCBCR_DSP_BatchQueueInit(&batch.decoded, numDecoders);
+      RGB2YCBCR_DSP_BatchQueueInit(&batch.converted, 1);
+
+      start = RGB2YCBCR_DSP_GetTime();
+
+      for (i = 0; i < numEncoders; i++) {
+         if (pthread_create(&encoders [i], NULL, RGB2YCBCR_DSP_BatchEncodeRun, &batch) != 0) {
+            break;
+         }
+      }
+      numStarted = i;
+
+      for (i = 0; i < numDecoders; i++) {
+         if (pthread_create(&decoders [i], NULL, RGB2YCBCR_DSP_BatchDecodeRun, &batch) != 0) {
+            status = DSP_EFAIL;
+            break;
+         }
+      }
+
+      /* The decoders that did not start will never be done */
+      pthread_mutex_lock(&batch.decoded.lock);
+      batch.decoded.numProducers -= numDecoders - i;
+      pthread_mutex_unlock(&batch.decoded.lock);
+      numDecoders = i;
+
+      if ((numStarted == 0) || (numDecoders == 0)) {
+         status = DSP_EFAIL;
+      }
+
+      /* Feed the DSP one image at a time, in the order they are decoded */
+      while ((image = RGB2YCBCR_DSP_BatchQueueGet(&batch.decoded)) != NULL) {
+         convertStart  = RGB2YCBCR_DSP_GetTime();
+         convertStatus = DSP_EFAIL;
+
+         if ((numStarted > 0) && !batch.stopped) {
+            convertStatus = RGB2YCBCR_DSP_SessionConvert(image->png.data,
+                                                         image->png.width * image->png.height * 3,
+                                                         processorId);
+            RGB2YCBCR_DSP_StatsFree();
+            if (DSP_FAILED(convertStatus)) {
+               /* Chunks of the failed image may still be in the channels,
+                * the next image would take them for its own. The images
+                * already decoded are dropped.
+                */
+               printf("Conversion failed, ending the session\n");
+               pthread_mutex_lock(&batch.lock);
+               batch.stopped = TRUE;
+               pthread_mutex_unlock(&batch.lock);
+            }
+         }
+
+         pthread_mutex_lock(&batch.lock);
+         batch.convertBusy += RGB2YCBCR_DSP_GetTime() - convertStart;
+         if (DSP_FAILED(convertStatus)) {
+            batch.numFailures++;
+         }
+         pthread_mutex_unlock(&batch.lock);
+
+         if (DSP_FAILED(convertStatus)) {
+            printf("Could not convert %s\n", image->inName);
+            RGB2YCBCR_DSP_BatchImageFree(image);
+         }
+         else {
+            RGB2YCBCR_DSP_BatchQueuePut(&batch.converted, image);
+         }
+      }
+      RGB2YCBCR_DSP_BatchQueueDone(&batch.converted);
+
+      for (i = 0; i < numDecoders; i++) {
+         pthread_join(decoders [i], NULL);
+      }
+      for (i = 0; i < numStarted; i++) {
+         pthread_join(encoders [i], NULL);
+      }
+      elapsed = RGB2YCBCR_DSP_GetTime() - start;
+      batch.numFailures += batch.source.numSkipped;
+
+      printf("%u images in %.3f s, %.2f images/s, %u failed\n",
+             (unsigned int) batch.numImages,
+             elapsed,
+             (elapsed > 0) ? (batch.numImages / elapsed) : 0.0,
+             (unsigned int) batch.numFailures);
+      if (elapsed > 0) {
+         printf("decode  %2u threads %5.1f%% busy\n", (unsigned int) numDecoders,
+                (numDecoders > 0) ? (100.0 * batch.decodeBusy / (elapsed * numDecoders)) : 0.0);
+         printf("convert %2u thread  %5.1f%% busy\n", 1,
+                100.0 * batch.convertBusy / elapsed);
+         printf("encode  %2u threads %5.1f%% busy\n", (unsigned int) numStarted,
+                (numStarted > 0) ? (100.0 * batch.encodeBusy / (elapsed * numStarted)) : 0.0);
+      }
+      fflush(stdout);
+
+      RGB2YCBCR_DSP_BatchQueueDestroy(&batch.converted);
+      RGB2YCBCR_DSP_BatchQueueDestroy(&batch.decoded);
+      pthread_mutex_destroy(&batch.lock);
+
+      RGB2YCBCR_DSP_StatsQuiet(FALSE);
+      RGB2YCBCR_DSP_SessionDelete(processorId);
+   }
+
+   RGB2YCBCR_DSP_BatchClose(&batch.source);
+
+   if (DSP_SUCCEEDED(status) && (batch.numFailures > 0)) {
+      status = DSP_EFAIL;
+   }
+
+   return status;
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
@@ -0,0 +1,282 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_batch.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/Linux/
+ *
+ *  @desc   Batch conversion of many images. PNG decoding and encoding run on
+ *          pools of GPP threads around a single thread feeding the DSP, so
+ *          the codec work of some images overlaps the conversion of others.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RGB2YCBCR_DSP_BATCH_H)
+#define RGB2YCBCR_DSP_BATCH_H
+
+/*  ----------------------------------- OS Specific Headers           */
+#include <stdio.h>
+#include <dirent.h>
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  BATCH_MAX_THREADS
+ *
+ *  @desc   Largest number of decode or encode threads.
+ *  ============================================================================
+ */
+#define BATCH_MAX_THREADS 16
+
+/** ============================================================================
+ *  @const  BATCH_QUEUE_DEPTH
+ *
+ *  @desc   Number of images a queue between two stages holds. A full queue
+ *          holds back the stage before it, which bounds the images in
+ *          memory.
+ *  ============================================================================
+ */
+#define BATCH_QUEUE_DEPTH 4
+
+/** ============================================================================
+ *  @const  BATCH_MAX_NAME
+ *
+ *  @desc   Size of the buffers holding the name of an image, terminating
+ *          NUL included.
+ *  ============================================================================
+ */
+#define BATCH_MAX_NAME 1024
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_BatchSource
+ *
+ *  @desc   Images of a directory, or of a list naming one per line, along
+ *          with the directory they are written to.
+ *
+ *  @field  list, dir
+ *              Source of the names, whichever is open.
+ *  @field  input, outputDir
+ *              Directory or list of the images, and directory they are
+ *              written to.
+ *  @field  numSkipped
+ *              Images skipped as their names do not fit.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_BatchSource_tag {
+   FILE *  list;
+   DIR *   dir;
+   Char8 * input;
+   Char8 * outputDir;
+   Uint32  numSkipped;
+} RGB2YCBCR_DSP_BatchSource;
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_BatchOpen
+ *
+ *  @desc   Opens the list or the directory of the images.
+ *
+ *  @arg    input
+ *              Directory or list of the images.
+ *
+ *  @arg    isList
+ *              TRUE when input is a list.
+ *
+ *  @arg    outputDir
+ *              Directory the converted images are written to.
+ *
+ *  @arg    source
+ *              Source to initialize.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EFAIL
+ *              The input could not be opened.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_BatchNext, RGB2YCBCR_DSP_BatchClose
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_BatchOpen(
+   IN  Char8 *                     input,
+   IN  Bool                        isList,
+   IN  Char8 *                     outputDir,
+   OUT RGB2YCBCR_DSP_BatchSource * source);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_BatchNext
+ *
+ *  @desc   Names the next image, the next line of the list that is not
+ *          empty or the next .png file of the directory, and the file of
+ *          the output directory it is written to under the same name. An
+ *          image whose names do not fit in BATCH_MAX_NAME bytes, a list
+ *          line included, is reported and counted in numSkipped rather than
+ *          read or written under a truncated name.
+ *
+ *  @arg    source
+ *              Source from RGB2YCBCR_DSP_BatchOpen ().
+ *
+ *  @arg    inName
+ *              Buffer of BATCH_MAX_NAME bytes receiving the name of the image.
+ *
+ *  @arg    outName
+ *              Buffer of BATCH_MAX_NAME bytes receiving the name it is
+ *              written to.
+ *
+ *  @ret    TRUE
+ *              An image was named.
+ *          FALSE
+ *              There is none left.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_BatchOpen
+ *  ============================================================================
+ */
+NORMAL_API Bool RGB2YCBCR_DSP_BatchNext(
+   IN  RGB2YCBCR_DSP_BatchSource * source,
+   OUT Char8 *                     inName,
+   OUT Char8 *                     outName);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_BatchClose
+ *
+ *  @desc   Closes the list or the directory of the images.
+ *
+ *  @arg    source
+ *              Source from RGB2YCBCR_DSP_BatchOpen ().
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_BatchOpen
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_BatchClose(
+   IN RGB2YCBCR_DSP_BatchSource * source);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_BatchRun
+ *
+ *  @desc   Converts every PNG image of a directory, or every image a list
+ *          names one per line, into the output directory under the same
+ *          name. Decode threads read the images, the calling thread has the
+ *          DSP convert them one after the other in a session, and encode
+ *          threads write them. The stages are joined by queues of
+ *          BATCH_QUEUE_DEPTH images. The images per second and the share of
+ *          the run every stage was busy are printed at the end.
+ *
+ *  @arg    dspExecutable
+ *              DSP executable name.
+ *
+ *  @arg    input
+ *              Directory or list of the images.
+ *
+ *  @arg    isList
+ *              TRUE when input is a list.
+ *
+ *  @arg    outputDir
+ *              Directory the converted images are written to.
+ *
+ *  @arg    strBufferSize
+ *              String representation of the chunk size in bytes.
+ *
+ *  @arg    strNumBuffers
+ *              String representation of the number of buffers kept in
+ *              flight.
+ *
+ *  @arg    strNumDspBuffers
+ *              String representation of the number of buffers the DSP
+ *              streams through.
+ *
+ *  @arg    strProcessorId
+ *              String representation of the DSP processor Id.
+ *
+ *  @arg    numDecoders
+ *              Number of decode threads, 1 to BATCH_MAX_THREADS.
+ *
+ *  @arg    numEncoders
+ *              Number of encode threads, 1 to BATCH_MAX_THREADS.
+ *
+ *  @arg    profile
+ *              Encode profile of the images, one of PNG_PROFILE_XXX.
+ *
+ *  @ret    DSP_SOK
+ *              Every image was converted.
+ *          DSP_EINVALIDARG
+ *              Invalid number of threads.
+ *          DSP_EFAIL
+ *              The input could not be opened, or an image failed.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_SessionCreate, RGB2YCBCR_DSP_SessionConvert
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_BatchRun(
+   IN Char8 * dspExecutable,
+   IN Char8 * input,
+   IN Bool    isList,
+   IN Char8 * outputDir,
+   IN Char8 * strBufferSize,
+   IN Char8 * strNumBuffers,
+   IN Char8 * strNumDspBuffers,
+   IN Char8 * strProcessorId,
+   IN Uint32  numDecoders,
+   IN Uint32  numEncoders,
+   IN Uint32  profile);
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RGB2YCBCR_DSP_BATCH_H) */
@@ -0,0 +1,257 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_client.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/Linux/
+ *
+ *  @desc   Client library of the conversion daemon.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+/*  ----------------------------------- OS Specific Headers           */
+#if !defined (_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <rgb2ycbcr-dsp.h>
+#include <rgb2ycbcr-dsp_daemon.h>
+#include <rgb2ycbcr-dsp_client.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ClientConnect
+ *
+ *  @desc   Opens a SOCK_SEQPACKET connection, so every request and reply
+ *          is a message of its own.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_ClientConnect(
+   IN  Char8 * socketPath,
+   OUT Int32 * client)
+{
+   struct sockaddr_un address;
+   int                fd;
+
+   if ((socketPath == NULL) || (client == NULL) ||
+       (strlen(socketPath) >= sizeof(address.sun_path))) {
+      return DSP_EINVALIDARG;
+   }
+
+   fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+   if (fd < 0) {
+      return DSP_EFAIL;
+   }
+
+   memset(&address, 0, sizeof(address));
+   address.sun_family = AF_UNIX;
+   strcpy(address.sun_path, socketPath);
+
+   if (connect(fd, (struct sockaddr *) &address, sizeof(address)) != 0) {
+      close(fd);
+      return DSP_EFAIL;
+   }
+
+   *client = fd;
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ClientDisconnect
+ *
+ *  @desc   Closes the socket.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_ClientDisconnect(
+   IN Int32 client)
+{
+   close(client);
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_FrameCreate
+ *
+ *  @desc   Creates the shared memory, sizes it, seals its size and maps it.
+ *
+ *  @modif  frame
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_FrameCreate(
+   IN  Uint32                size,
+   OUT RGB2YCBCR_DSP_Frame * frame)
+{
+   int   fd;
+   void *data;
+
+   if ((frame == NULL) || (size == 0)) {
+      return DSP_EINVALIDARG;
+   }
+
+#if defined (MFD_ALLOW_SEALING)
+   fd = memfd_create("rgb2ycbcr-frame", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+#else /* if defined (MFD_ALLOW_SEALING) */
+   /* The daemon only maps memory whose size is sealed */
+   fd = -1;
+#endif /* if defined (MFD_ALLOW_SEALING) */
+   if (fd < 0) {
+      return DSP_EMEMORY;
+   }
+
+   if (ftruncate(fd, size) != 0) {
+      close(fd);
+      return DSP_EMEMORY;
+   }
+#if defined (MFD_ALLOW_SEALING)
+   /* The size can no longer change under the daemon mapping */
+   if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW) != 0) {
+      close(fd);
+      return DSP_EMEMORY;
+   }
+#endif /* if defined (MFD_ALLOW_SEALING) */
+
+   data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   if (data == MAP_FAILED) {
+      close(fd);
+      return DSP_EMEMORY;
+   }
+
+   frame->fd   = fd;
+   frame->data = (Char8 *) data;
+   frame->size = size;
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_FrameDelete
+ *
+ *  @desc   Unmaps and closes the shared memory.
+ *
+ *  @modif  frame
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_FrameDelete(
+   IN OUT RGB2YCBCR_DSP_Frame * frame)
+{
+   if ((frame != NULL) && (frame->data != NULL)) {
+      munmap(frame->data, frame->size);
+      close(frame->fd);
+      frame->data = NULL;
+      frame->fd   = -1;
+   }
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ClientConvert
+ *
+ *  @desc   Sends the request with the frame descriptor attached and reads
+ *          the reply.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_ClientConvert(
+   IN Int32                 client,
+   IN RGB2YCBCR_DSP_Frame * frame)
+{
+   static Uint32               nextId = 0;
+   RGB2YCBCR_DSP_DaemonRequest request;
+   RGB2YCBCR_DSP_DaemonReply   reply;
+   struct msghdr               msg;
+   struct iovec                iov;
+   struct cmsghdr *            cmsg;
+   char                        control [CMSG_SPACE(sizeof(int))];
+   int                         fd;
+
+   if ((frame == NULL) || (frame->data == NULL)) {
+      return DSP_EINVALIDARG;
+   }
+
+   request.magic = DAEMON_MAGIC;
+   request.id    = __sync_fetch_and_add(&nextId, 1);
+   request.size  = frame->size;
+
+   memset(&msg, 0, sizeof(msg));
+   memset(control, 0, sizeof(control));
+   iov.iov_base       = &request;
+   iov.iov_len        = sizeof(request);
+   msg.msg_iov        = &iov;
+   msg.msg_iovlen     = 1;
+   msg.msg_control    = control;
+   msg.msg_controllen = sizeof(control);
+
+   fd                 = frame->fd;
+   cmsg               = CMSG_FIRSTHDR(&msg);
+   cmsg->cmsg_level   = SOL_SOCKET;
+   cmsg->cmsg_type    = SCM_RIGHTS;
+   cmsg->cmsg_len     = CMSG_LEN(sizeof(int));
+   memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+
+   if (sendmsg(client, &msg, MSG_NOSIGNAL) != sizeof(request)) {
+      return DSP_EFAIL;
+   }
+
+   if (   (recv(client, &reply, sizeof(reply), 0) != sizeof(reply))
+       || (reply.magic != DAEMON_MAGIC) || (reply.id != request.id)) {
+      return DSP_EFAIL;
+   }
+
+   return reply.status;
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
@@ -0,0 +1,246 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_client.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/Linux/
+ *
+ *  @desc   Client library of the conversion daemon, and a load generator
+ *          built on it.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RGB2YCBCR_DSP_CLIENT_H)
+#define RGB2YCBCR_DSP_CLIENT_H
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_Frame
+ *
+ *  @desc   Frame in shared memory that can be handed to the daemon.
+ *
+ *  @field  fd
+ *              Descriptor of the shared memory.
+ *  @field  data
+ *              The frame, mapped in the client.
+ *  @field  size
+ *              Size of the frame in bytes.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_Frame_tag {
+   Int32   fd;
+   Char8 * data;
+   Uint32  size;
+} RGB2YCBCR_DSP_Frame;
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ClientConnect
+ *
+ *  @desc   Connects to a daemon.
+ *
+ *  @arg    socketPath
+ *              Path the daemon listens on.
+ *
+ *  @arg    client
+ *              Location to receive the connection.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EFAIL
+ *              The daemon could not be reached.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_ClientDisconnect
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_ClientConnect(
+   IN  Char8 * socketPath,
+   OUT Int32 * client);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ClientDisconnect
+ *
+ *  @desc   Closes a connection to the daemon.
+ *
+ *  @arg    client
+ *              Connection from RGB2YCBCR_DSP_ClientConnect ().
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_ClientConnect
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_ClientDisconnect(
+   IN Int32 client);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_FrameCreate
+ *
+ *  @desc   Allocates a frame in a memfd sealed against shrinking and
+ *          growing, the only memory the daemon maps. It fails when the C
+ *          library has no sealing.
+ *
+ *  @arg    size
+ *              Size of the frame in bytes.
+ *
+ *  @arg    frame
+ *              Frame to initialize.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EMEMORY
+ *              The shared memory could not be allocated.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_FrameDelete
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_FrameCreate(
+   IN  Uint32                size,
+   OUT RGB2YCBCR_DSP_Frame * frame);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_FrameDelete
+ *
+ *  @desc   Releases a frame.
+ *
+ *  @arg    frame
+ *              Frame from RGB2YCBCR_DSP_FrameCreate ().
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_FrameCreate
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_FrameDelete(
+   IN OUT RGB2YCBCR_DSP_Frame * frame);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ClientConvert
+ *
+ *  @desc   Has the daemon convert a frame in place and waits for it. Only
+ *          the descriptor of the frame is sent.
+ *
+ *  @arg    client
+ *              Connection from RGB2YCBCR_DSP_ClientConnect ().
+ *
+ *  @arg    frame
+ *              Frame holding interleaved R, G, B bytes.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EFAIL
+ *              The daemon could not be reached.
+ *          <status>
+ *              Why the daemon did not convert the frame.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_DaemonRun
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_ClientConvert(
+   IN Int32                 client,
+   IN RGB2YCBCR_DSP_Frame * frame);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_LoadGen
+ *
+ *  @desc   Load generator. Runs a number of clients in parallel, each
+ *          sending back to back requests, and prints the requests per
+ *          second and the latency distribution. The first frame of every
+ *          client is checked against RGB2YCBCR_DSP_ConvertRef ().
+ *
+ *  @arg    socketPath
+ *              Path the daemon listens on.
+ *
+ *  @arg    numClients
+ *              Number of concurrent clients.
+ *
+ *  @arg    numRequests
+ *              Number of requests each client sends.
+ *
+ *  @arg    frameSize
+ *              Size of the frames in bytes.
+ *
+ *  @ret    DSP_SOK
+ *              Every request succeeded.
+ *          DSP_EFAIL
+ *              A request failed or a frame was not converted right.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_ClientConvert
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_LoadGen(
+   IN Char8 * socketPath,
+   IN Uint32  numClients,
+   IN Uint32  numRequests,
+   IN Uint32  frameSize);
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RGB2YCBCR_DSP_CLIENT_H) */
@@ -0,0 +1,390 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_daemon.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/Linux/
+ *
+ *  @desc   Conversion daemon serving frames in shared memory over a UNIX
+ *          domain socket.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+/*  ----------------------------------- OS Specific Headers           */
+#if !defined (_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <rgb2ycbcr-dsp.h>
+#include <rgb2ycbcr-dsp_os.h>
+#include <rgb2ycbcr-dsp_stats.h>
+#include <rgb2ycbcr-dsp_daemon.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_DaemonStop
+ *
+ *  @desc   Set by the signal handler to leave the serving loop.
+ *  ============================================================================
+ */
+STATIC volatile sig_atomic_t RGB2YCBCR_DSP_DaemonStop = 0;
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_DaemonSignal
+ *
+ *  @desc   Handler of SIGINT and SIGTERM.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_DaemonSignal(
+   int signum)
+{
+   RGB2YCBCR_DSP_DaemonStop = 1;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_DaemonReceive
+ *
+ *  @desc   Reads a request and the descriptor attached to it. Returns
+ *          DSP_ENOTFOUND when the client has gone.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC DSP_STATUS RGB2YCBCR_DSP_DaemonReceive(
+   IN  int                           client,
+   OUT RGB2YCBCR_DSP_DaemonRequest * request,
+   OUT int *                         frameFd)
+{
+   struct msghdr    msg;
+   struct iovec     iov;
+   struct cmsghdr * cmsg;
+   char             control [CMSG_SPACE(sizeof(int))];
+   ssize_t          received;
+
+   *frameFd = -1;
+
+   memset(&msg, 0, sizeof(msg));
+   iov.iov_base       = request;
+   iov.iov_len        = sizeof(*request);
+   msg.msg_iov        = &iov;
+   msg.msg_iovlen     = 1;
+   msg.msg_control    = control;
+   msg.msg_controllen = sizeof(control);
+
+   received = recvmsg(client, &msg, 0);
+   if (received <= 0) {
+      return DSP_ENOTFOUND;
+   }
+
+   for (cmsg = CMSG_FIRSTHDR(&msg) ; cmsg != NULL ; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_RIGHTS)) {
+         memcpy(frameFd, CMSG_DATA(cmsg), sizeof(int));
+      }
+   }
+
+   if (   (received != sizeof(*request)) || (request->magic != DAEMON_MAGIC)
+       || (*frameFd < 0) || (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))) {
+      return DSP_EINVALIDARG;
+   }
+
+   return DSP_SOK;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_DaemonConvert
+ *
+ *  @desc   Maps the frame and converts it on the DSP where it is. The
+ *          memory must be sealed against shrinking and growing, a client
+ *          truncating it while it is mapped would bring the daemon down on
+ *          SIGBUS. Tells through broken whether the conversion itself
+ *          failed, rather than the request.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC DSP_STATUS RGB2YCBCR_DSP_DaemonConvert(
+   IN  int     frameFd,
+   IN  Uint32  size,
+   IN  Uint8   processorId,
+   OUT Bool *  broken)
+{
+   DSP_STATUS  status = DSP_SOK;
+   Char8 *     frame  = NULL;
+   Bool        sealed = FALSE;
+   int         seals  = -1;
+   struct stat frameStat;
+
+   *broken = FALSE;
+
+#if defined (F_GET_SEALS)
+   seals  = fcntl(frameFd, F_GET_SEALS);
+   sealed =    (seals >= 0)
+            && ((seals & (F_SEAL_SHRINK | F_SEAL_GROW)) == (F_SEAL_SHRINK | F_SEAL_GROW));
+#endif /* if defined (F_GET_SEALS) */
+   if (!sealed) {
+      return DSP_EINVALIDARG;
+   }
+
+   if ((size == 0) || (fstat(frameFd, &frameStat) != 0) || (frameStat.st_size < size)) {
+      return DSP_ESIZE;
+   }
+
+   frame = (Char8 *) mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, frameFd, 0);
+   if (frame == (Char8 *) MAP_FAILED) {
+      return DSP_EMEMORY;
+   }
+
+   status = RGB2YCBCR_DSP_SessionConvert(frame, size, processorId);
+   if (DSP_FAILED(status)) {
+      *broken = TRUE;
+   }
+
+   munmap(frame, size);
+
+   return status;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_DaemonServe
+ *
+ *  @desc   Serves one request of a client. Returns DSP_ENOTFOUND when the
+ *          client has gone or can no longer be answered, and DSP_EFAIL when
+ *          the conversion failed, as chunks of that frame may be left in the
+ *          channels and the session can not serve another one.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC DSP_STATUS RGB2YCBCR_DSP_DaemonServe(
+   IN int     client,
+   IN Uint8   processorId)
+{
+   DSP_STATUS                  status;
+   RGB2YCBCR_DSP_DaemonRequest request;
+   RGB2YCBCR_DSP_DaemonReply   reply;
+   int                         frameFd;
+   Bool                        broken = FALSE;
+
+   memset(&request, 0, sizeof(request));
+   status = RGB2YCBCR_DSP_DaemonReceive(client, &request, &frameFd);
+   if (status == DSP_ENOTFOUND) {
+      return status;
+   }
+
+   if (DSP_SUCCEEDED(status)) {
+      status = RGB2YCBCR_DSP_DaemonConvert(frameFd, request.size, processorId, &broken);
+   }
+
+   if (frameFd >= 0) {
+      close(frameFd);
+   }
+
+   reply.magic  = DAEMON_MAGIC;
+   reply.id     = request.id;
+   reply.status = status;
+   if (   (send(client, &reply, sizeof(reply), MSG_NOSIGNAL) != sizeof(reply))
+       && !broken) {
+      return DSP_ENOTFOUND;
+   }
+
+   return broken ? DSP_EFAIL : DSP_SOK;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_DaemonListen
+ *
+ *  @desc   Creates the listening socket.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC int RGB2YCBCR_DSP_DaemonListen(
+   IN Char8 * socketPath)
+{
+   struct sockaddr_un address;
+   int                listener;
+
+   if (strlen(socketPath) >= sizeof(address.sun_path)) {
+      return -1;
+   }
+
+   listener = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+   if (listener < 0) {
+      return -1;
+   }
+
+   memset(&address, 0, sizeof(address));
+   address.sun_family = AF_UNIX;
+   strcpy(address.sun_path, socketPath);
+   unlink(socketPath);
+
+   if (   (bind(listener, (struct sockaddr *) &address, sizeof(address)) != 0)
+       || (listen(listener, DAEMON_MAX_CLIENTS) != 0)) {
+      close(listener);
+      return -1;
+   }
+
+   return listener;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_DaemonRun
+ *
+ *  @desc   Polls the listening socket and the clients. Every client with a
+ *          request pending gets one served per round, so a busy client
+ *          does not hold back the others.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_DaemonRun(
+   IN Char8 * socketPath,
+   IN Char8 * dspExecutable,
+   IN Char8 * strBufferSize,
+   IN Char8 * strNumBuffers,
+   IN Char8 * strNumDspBuffers,
+   IN Char8 * strProcessorId)
+{
+   DSP_STATUS       status     = DSP_SOK;
+   DSP_STATUS       served;
+   struct pollfd    fds [DAEMON_MAX_CLIENTS + 1];
+   Uint32           numFds     = 1;
+   Uint8            processorId;
+   Bool             session    = FALSE;
+   struct sigaction action;
+   Uint32           i;
+   int              client;
+
+   fds [0].fd     = RGB2YCBCR_DSP_DaemonListen(socketPath);
+   fds [0].events = POLLIN;
+   if (fds [0].fd < 0) {
+      printf("Could not listen on %s\n", socketPath);
+      return DSP_EFAIL;
+   }
+
+   /* No SA_RESTART, a signal must wake poll () up */
+   memset(&action, 0, sizeof(action));
+   action.sa_handler = RGB2YCBCR_DSP_DaemonSignal;
+   sigemptyset(&action.sa_mask);
+   sigaction(SIGINT, &action, NULL);
+   sigaction(SIGTERM, &action, NULL);
+
+   status = RGB2YCBCR_DSP_SessionCreate(dspExecutable,
+                                        strBufferSize,
+                                        strNumBuffers,
+                                        strNumDspBuffers,
+                                        strProcessorId,
+                                        &processorId);
+   if (DSP_SUCCEEDED(status)) {
+      session = TRUE;
+
+      /* A table per frame would drown the requests */
+      RGB2YCBCR_DSP_StatsQuiet(TRUE);
+      printf("Serving on %s\n", socketPath);
+      fflush(stdout);
+   }
+
+   while (DSP_SUCCEEDED(status) && !RGB2YCBCR_DSP_DaemonStop) {
+      if (poll(fds, numFds, -1) < 0) {
+         if (errno != EINTR) {
+            status = DSP_EFAIL;
+         }
+         continue;
+      }
+
+      /* New clients, past the limit they are turned away */
+      if (fds [0].revents & POLLIN) {
+         client = accept(fds [0].fd, NULL, NULL);
+         if ((client >= 0) && (numFds < (DAEMON_MAX_CLIENTS + 1))) {
+            fds [numFds].fd      = client;
+            fds [numFds].events  = POLLIN;
+            fds [numFds].revents = 0;
+            numFds++;
+         }
+         else if (client >= 0) {
+            close(client);
+         }
+      }
+
+      for (i = 1 ; (i < numFds) && DSP_SUCCEEDED(status) ; i++) {
+         if (fds [i].revents & (POLLIN | POLLHUP | POLLERR)) {
+            served = RGB2YCBCR_DSP_DaemonServe(fds [i].fd, processorId);
+            if (served == DSP_ENOTFOUND) {
+               close(fds [i].fd);
+               numFds--;
+               fds [i] = fds [numFds];
+               i--;
+            }
+            else if (DSP_FAILED(served)) {
+               printf("Conversion failed, stopping\n");
+               status = served;
+            }
+         }
+      }
+   }
+
+   for (i = 1 ; i < numFds ; i++) {
+      close(fds [i].fd);
+   }
+   close(fds [0].fd);
+   unlink(socketPath);
+
+   /* The DSP is unloaded whatever ended the loop */
+   if (session) {
+      RGB2YCBCR_DSP_SessionDelete(processorId);
+   }
+   RGB2YCBCR_DSP_StatsQuiet(FALSE);
+   RGB2YCBCR_DSP_StatsFree();
+
+   return status;
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
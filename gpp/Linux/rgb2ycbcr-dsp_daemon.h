@@ -0,0 +1,166 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_daemon.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/Linux/
+ *
+ *  @desc   Conversion daemon. It keeps a DSP session open and converts frames
+ *          sent by clients over a UNIX domain socket. The frames live in
+ *          shared memory and only their file descriptor goes through the
+ *          socket.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RGB2YCBCR_DSP_DAEMON_H)
+#define RGB2YCBCR_DSP_DAEMON_H
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  DAEMON_MAGIC
+ *
+ *  @desc   First word of every request and reply.
+ *  ============================================================================
+ */
+#define DAEMON_MAGIC       0x52474259
+
+/** ============================================================================
+ *  @const  DAEMON_MAX_CLIENTS
+ *
+ *  @desc   Number of clients the daemon serves at the same time.
+ *  ============================================================================
+ */
+#define DAEMON_MAX_CLIENTS 32
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_DaemonRequest
+ *
+ *  @desc   Asks the daemon to convert a frame in place. It is sent as one
+ *          SOCK_SEQPACKET message, with the descriptor of the shared memory
+ *          holding the frame attached as SCM_RIGHTS. The memory must be a
+ *          memfd sealed with F_SEAL_SHRINK and F_SEAL_GROW.
+ *
+ *  @field  magic
+ *              DAEMON_MAGIC.
+ *  @field  id
+ *              Chosen by the client, returned in the reply.
+ *  @field  size
+ *              Size of the frame in bytes, from the start of the memory.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_DaemonRequest_tag {
+   Uint32 magic;
+   Uint32 id;
+   Uint32 size;
+} RGB2YCBCR_DSP_DaemonRequest;
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_DaemonReply
+ *
+ *  @desc   Sent back once the frame has been converted.
+ *
+ *  @field  magic
+ *              DAEMON_MAGIC.
+ *  @field  id
+ *              Id of the request.
+ *  @field  status
+ *              DSP_SOK, or why the frame was not converted.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_DaemonReply_tag {
+   Uint32     magic;
+   Uint32     id;
+   DSP_STATUS status;
+} RGB2YCBCR_DSP_DaemonReply;
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_DaemonRun
+ *
+ *  @desc   Opens a DSP session and serves conversion requests on a socket
+ *          until SIGINT or SIGTERM. Requests from the connected clients are
+ *          taken in turn, one at a time, since there is a single DSP.
+ *
+ *  @arg    socketPath
+ *              Path the socket is bound to. A stale socket is replaced.
+ *
+ *  @arg    dspExecutable
+ *              DSP executable name.
+ *
+ *  @arg    strBufferSize
+ *              String representation of the chunk size in bytes.
+ *
+ *  @arg    strNumBuffers
+ *              String representation of the number of buffers kept in
+ *              flight.
+ *
+ *  @arg    strNumDspBuffers
+ *              String representation of the number of buffers the DSP
+ *              streams through.
+ *
+ *  @arg    strProcessorId
+ *              String representation of the DSP processor Id.
+ *
+ *  @ret    DSP_SOK
+ *              The daemon was stopped by a signal.
+ *          DSP_EFAIL
+ *              The socket or the DSP session could not be opened.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_SessionCreate, RGB2YCBCR_DSP_ClientConvert
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_DaemonRun(
+   IN Char8 * socketPath,
+   IN Char8 * dspExecutable,
+   IN Char8 * strBufferSize,
+   IN Char8 * strNumBuffers,
+   IN Char8 * strNumDspBuffers,
+   IN Char8 * strProcessorId);
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RGB2YCBCR_DSP_DAEMON_H) */
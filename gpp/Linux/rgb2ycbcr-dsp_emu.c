@@ -0,0 +1,637 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_emu.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/Linux/
+ *
+ *  @desc   Host emulation of the DSP/BIOS LINK calls used by rgb2ycbcr-dsp.
+ *          A worker thread takes the place of the DSP and runs the same
+ *          conversion as TSKRGB2YCBCR_DSP_execute (), so the GPP pipeline
+ *          can be run and timed on a plain Linux host.
+ *          Only built when RGB2YCBCR_DSP_EMULATION is defined.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if defined (RGB2YCBCR_DSP_EMULATION)
+
+/*  ----------------------------------- OS Specific Headers           */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <rgb2ycbcr-dsp.h>
+#include <rgb2ycbcr-dsp_cvt.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  EMU_QUEUE_LEN
+ *
+ *  @desc   Maximum number of requests queued on an emulated channel.
+ *  ============================================================================
+ */
+#define EMU_QUEUE_LEN      64
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_EmuQueue
+ *
+ *  @desc   FIFO of I/O requests on one side of an emulated channel.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_EmuQueue_tag {
+   ChannelIOInfo req [EMU_QUEUE_LEN];
+   Uint32        head;
+   Uint32        tail;
+} RGB2YCBCR_DSP_EmuQueue;
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_EmuChannel
+ *
+ *  @desc   An emulated channel. Issued requests wait on pending until the
+ *          worker is done with them and moves them to done, where
+ *          CHNL_reclaim () picks them up.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_EmuChannel_tag {
+   RGB2YCBCR_DSP_EmuQueue pending;
+   RGB2YCBCR_DSP_EmuQueue done;
+} RGB2YCBCR_DSP_EmuChannel;
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_EmuDsp
+ *
+ *  @desc   An emulated DSP. Every processor has its own, so several can run
+ *          at once.
+ *
+ *  @field  lock, cond
+ *              Protect the channels and signal changes on them.
+ *  @field  channels
+ *              Emulated channels, indexed by channel id.
+ *  @field  bufferSize, numTransfers, format, width, filter, matrix,
+ *          direction
+ *              Arguments given to the emulated DSP executable on
+ *              PROC_load ().
+ *  @field  poolBuffers, allocated
+ *              Number of buffers in the opened pool and number allocated
+ *              from it, so a pool sized too small fails as it would on the
+ *              target.
+ *  @field  worker, running, stop
+ *              Thread standing in for the DSP, whether it was started and
+ *              the flag asking it to stop.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_EmuDsp_tag {
+   pthread_mutex_t          lock;
+   pthread_cond_t           cond;
+   RGB2YCBCR_DSP_EmuChannel channels [2];
+   Uint32                   bufferSize;
+   Uint32                   numTransfers;
+   Uint32                   format;
+   Uint32                   width;
+   Uint32                   filter;
+   RGB2YCBCR_DSP_Matrix *   matrix;
+   Uint32                   direction;
+   Uint32                   poolBuffers;
+   Uint32                   allocated;
+   pthread_t                worker;
+   Bool                     running;
+   Bool                     stop;
+} RGB2YCBCR_DSP_EmuDsp;
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_EmuDsps
+ *
+ *  @desc   Emulated DSPs, indexed by processor id.
+ *  ============================================================================
+ */
+STATIC RGB2YCBCR_DSP_EmuDsp RGB2YCBCR_DSP_EmuDsps [MAX_PROCESSORS];
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_EmuPut
+ *
+ *  @desc   Appends a request to a queue. Called with the lock held.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_EmuPut(
+   RGB2YCBCR_DSP_EmuQueue * queue,
+   ChannelIOInfo *          ioReq)
+{
+   queue->req [queue->tail % EMU_QUEUE_LEN] = *ioReq;
+   queue->tail++;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_EmuGet
+ *
+ *  @desc   Takes the oldest request off a queue. Called with the lock held.
+ *          Returns FALSE if the queue is empty.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Bool RGB2YCBCR_DSP_EmuGet(
+   RGB2YCBCR_DSP_EmuQueue * queue,
+   ChannelIOInfo *          ioReq)
+{
+   if (queue->head == queue->tail) {
+      return FALSE;
+   }
+
+   *ioReq = queue->req [queue->head % EMU_QUEUE_LEN];
+   queue->head++;
+
+   return TRUE;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_EmuWait
+ *
+ *  @desc   Waits for a request issued on a channel. Returns FALSE if the
+ *          worker is asked to stop first.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Bool RGB2YCBCR_DSP_EmuWait(
+   RGB2YCBCR_DSP_EmuDsp * dsp,
+   ChannelId              chnlId,
+   ChannelIOInfo *        ioReq)
+{
+   Bool found = FALSE;
+
+   pthread_mutex_lock(&dsp->lock);
+   while (   (!dsp->stop)
+          && (!(found = RGB2YCBCR_DSP_EmuGet(&dsp->channels [chnlId].pending, ioReq)))) {
+      pthread_cond_wait(&dsp->cond, &dsp->lock);
+   }
+   pthread_mutex_unlock(&dsp->lock);
+
+   return found;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_EmuComplete
+ *
+ *  @desc   Hands a finished request back to the GPP side of a channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_EmuComplete(
+   RGB2YCBCR_DSP_EmuDsp * dsp,
+   ChannelId              chnlId,
+   ChannelIOInfo *        ioReq)
+{
+   pthread_mutex_lock(&dsp->lock);
+   RGB2YCBCR_DSP_EmuPut(&dsp->channels [chnlId].done, ioReq);
+   pthread_cond_broadcast(&dsp->cond);
+   pthread_mutex_unlock(&dsp->lock);
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_EmuRun
+ *
+ *  @desc   Body of an emulated DSP, arg points to it. Mirrors
+ *          TSKRGB2YCBCR_DSP_execute (): receive a chunk, convert it and send
+ *          it back, for the configured number of transfers (0 meaning until
+ *          stopped or until a chunk with the RGB2YCBCR_DSP_ARG_END arg). The
+ *          chunk is copied into a local buffer as the proc-copy link would.
+ *          With a planar format the planes are written to a second buffer, as
+ *          the DSP task writes them to its scratch buffer, and only their
+ *          size is sent back.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Pvoid RGB2YCBCR_DSP_EmuRun(
+   Pvoid arg)
+{
+   RGB2YCBCR_DSP_EmuDsp * dsp   = (RGB2YCBCR_DSP_EmuDsp *) arg;
+   Int8 *                 buffer;
+   Int8 *                 planes;
+   Int8 *                 converted;
+   ChannelIOInfo          ioReq;
+   Uint32                 size;
+   Uint32                 i;
+   Bool                   ended = FALSE;
+
+   buffer = (Int8 *) malloc(dsp->bufferSize);
+   planes = (Int8 *) malloc(dsp->bufferSize);
+   if ((buffer == NULL) || (planes == NULL)) {
+      free(buffer);
+      free(planes);
+      return NULL;
+   }
+
+   for (i = 0 ;
+        ((dsp->numTransfers == 0) || (i < dsp->numTransfers)) && (!ended) ;
+        i++) {
+      /* Receive a filled buffer from the GPP */
+      if (!RGB2YCBCR_DSP_EmuWait(dsp, CHNL_ID_OUTPUT, &ioReq)) {
+         break;
+      }
+      size = ioReq.size;
+      if (size > dsp->bufferSize) {
+         size = dsp->bufferSize;
+      }
+      memcpy(buffer, ioReq.buffer, size);
+      ended = (ioReq.arg == RGB2YCBCR_DSP_ARG_END);
+      RGB2YCBCR_DSP_EmuComplete(dsp, CHNL_ID_OUTPUT, &ioReq);
+
+      /* Same arithmetic as the DSP */
+      converted = buffer;
+      if (!ended && (dsp->direction == RGB2YCBCR_DSP_DIR_INVERSE)) {
+         RGB2YCBCR_DSP_InverseMatrix((Char8 *) buffer, size, dsp->matrix);
+      }
+      else if (!ended) {
+         RGB2YCBCR_DSP_ConvertMatrix((Char8 *) buffer, size, dsp->matrix);
+         if (dsp->format != RGB2YCBCR_DSP_FORMAT_PACKED) {
+            size      = RGB2YCBCR_DSP_Planarize((Char8 *) buffer,
+                                                (Char8 *) planes,
+                                                size / 3,
+                                                dsp->format,
+                                                dsp->width,
+                                                dsp->filter);
+            converted = planes;
+         }
+      }
+
+      /* Send the processed buffer back to the GPP */
+      if (!RGB2YCBCR_DSP_EmuWait(dsp, CHNL_ID_INPUT, &ioReq)) {
+         break;
+      }
+      memcpy(ioReq.buffer, converted, size);
+      ioReq.size = size;
+      ioReq.arg  = ended ? RGB2YCBCR_DSP_ARG_END : RGB2YCBCR_DSP_ARG_DATA;
+      RGB2YCBCR_DSP_EmuComplete(dsp, CHNL_ID_INPUT, &ioReq);
+   }
+
+   free(buffer);
+   free(planes);
+
+   return NULL;
+}
+
+
+/** ============================================================================
+ *  @func   PROC_setup, PROC_destroy
+ *
+ *  @desc   Nothing to set up on the host.
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS PROC_setup(
+   IN Pvoid linkCfg)
+{
+   return DSP_SOK;
+}
+
+NORMAL_API DSP_STATUS PROC_destroy(Void)
+{
+   return DSP_SOK;
+}
+
+
+
+/** ============================================================================
+ *  @func   PROC_attach, PROC_detach
+ *
+ *  @desc   Set up and tear down the lock of an emulated DSP.
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS PROC_attach(
+   IN ProcessorId procId,
+   IN Pvoid       attr)
+{
+   RGB2YCBCR_DSP_EmuDsp * dsp;
+
+   if (procId >= MAX_PROCESSORS) {
+      return DSP_EINVALIDARG;
+   }
+
+   dsp = &RGB2YCBCR_DSP_EmuDsps [procId];
+   memset(dsp, 0, sizeof(RGB2YCBCR_DSP_EmuDsp));
+   pthread_mutex_init(&dsp->lock, NULL);
+   pthread_cond_init(&dsp->cond, NULL);
+
+   return DSP_SOK;
+}
+
+NORMAL_API DSP_STATUS PROC_detach(
+   IN ProcessorId procId)
+{
+   pthread_mutex_destroy(&RGB2YCBCR_DSP_EmuDsps [procId].lock);
+   pthread_cond_destroy(&RGB2YCBCR_DSP_EmuDsps [procId].cond);
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   PROC_load
+ *
+ *  @desc   Keeps the arguments the DSP executable would get. They are the
+ *          buffer size, the number of transfers, the number of DSP buffers,
+ *          the output format, the frame width, the chroma filter, the
+ *          colorimetry and the direction, as parsed by dsp/main.c. An
+ *          unknown colorimetry falls back to the legacy matrix there too,
+ *          and the inverse always writes packed pixels.
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS PROC_load(
+   IN ProcessorId procId,
+   IN Char8 *     imagePath,
+   IN Uint32      argc,
+   IN Char8 **    argv)
+{
+   RGB2YCBCR_DSP_EmuDsp * dsp = &RGB2YCBCR_DSP_EmuDsps [procId];
+   Uint32                 colorimetry;
+
+   if ((argc < 2) || (argv == NULL) || (argv [0] == NULL) || (argv [1] == NULL)) {
+      return DSP_EINVALIDARG;
+   }
+
+   dsp->bufferSize   = DSPLINK_ALIGN(atoi(argv [0]), DSPLINK_BUF_ALIGN);
+   dsp->numTransfers = atoi(argv [1]);
+   dsp->format       = ((argc > 3) && (argv [3] != NULL)) ? atoi(argv [3])
+                                                       : RGB2YCBCR_DSP_FORMAT_PACKED;
+   dsp->width        = ((argc > 4) && (argv [4] != NULL)) ? atoi(argv [4]) : 0;
+   dsp->filter       = ((argc > 5) && (argv [5] != NULL)) ? atoi(argv [5])
+                                                       : RGB2YCBCR_DSP_FILTER_DROP;
+   dsp->direction    = ((argc > 7) && (argv [7] != NULL)) ? atoi(argv [7])
+                                                       : RGB2YCBCR_DSP_DIR_FORWARD;
+   colorimetry       = ((argc > 6) && (argv [6] != NULL)) ? atoi(argv [6])
+                                                       : RGB2YCBCR_DSP_COLOR_LEGACY;
+   if (dsp->direction == RGB2YCBCR_DSP_DIR_INVERSE) {
+      dsp->format = RGB2YCBCR_DSP_FORMAT_PACKED;
+      dsp->matrix = RGB2YCBCR_DSP_GetInverse(colorimetry);
+      if (dsp->matrix == NULL) {
+         dsp->matrix = RGB2YCBCR_DSP_GetInverse(RGB2YCBCR_DSP_COLOR_LEGACY);
+      }
+   }
+   else {
+      dsp->matrix = RGB2YCBCR_DSP_GetMatrix(colorimetry);
+      if (dsp->matrix == NULL) {
+         dsp->matrix = RGB2YCBCR_DSP_GetMatrix(RGB2YCBCR_DSP_COLOR_LEGACY);
+      }
+   }
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   PROC_start
+ *
+ *  @desc   Starts the thread standing in for the DSP.
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS PROC_start(
+   IN ProcessorId procId)
+{
+   RGB2YCBCR_DSP_EmuDsp * dsp = &RGB2YCBCR_DSP_EmuDsps [procId];
+
+   dsp->stop = FALSE;
+   memset(dsp->channels, 0, sizeof(dsp->channels));
+
+   if (pthread_create(&dsp->worker, NULL, RGB2YCBCR_DSP_EmuRun, dsp) != 0) {
+      return DSP_EFAIL;
+   }
+   dsp->running = TRUE;
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   PROC_stop
+ *
+ *  @desc   Stops the emulated DSP and waits for its thread to finish.
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS PROC_stop(
+   IN ProcessorId procId)
+{
+   RGB2YCBCR_DSP_EmuDsp * dsp = &RGB2YCBCR_DSP_EmuDsps [procId];
+
+   pthread_mutex_lock(&dsp->lock);
+   dsp->stop = TRUE;
+   pthread_cond_broadcast(&dsp->cond);
+   pthread_mutex_unlock(&dsp->lock);
+
+   if (dsp->running) {
+      pthread_join(dsp->worker, NULL);
+      dsp->running = FALSE;
+   }
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   POOL_open, POOL_close
+ *
+ *  @desc   Records how many buffers the pool of a processor was opened
+ *          with.
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS POOL_open(
+   IN PoolId poolId,
+   IN Pvoid  params)
+{
+   RGB2YCBCR_DSP_EmuDsp * dsp       = &RGB2YCBCR_DSP_EmuDsps [POOL_getProcId(poolId)];
+   SMAPOOL_Attrs *        poolAttrs = (SMAPOOL_Attrs *) params;
+   Uint32                 i;
+
+   dsp->poolBuffers = 0;
+   dsp->allocated   = 0;
+   for (i = 0 ; i < poolAttrs->numBufPools ; i++) {
+      dsp->poolBuffers += poolAttrs->numBuffers [i];
+   }
+
+   return DSP_SOK;
+}
+
+NORMAL_API DSP_STATUS POOL_close(
+   IN PoolId poolId)
+{
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   CHNL_create, CHNL_delete
+ *
+ *  @desc   Channels are static on the host.
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS CHNL_create(
+   IN ProcessorId    procId,
+   IN ChannelId      chnlId,
+   IN ChannelAttrs * attrs)
+{
+   return (chnlId <= CHNL_ID_INPUT) ? DSP_SOK : DSP_EINVALIDARG;
+}
+
+NORMAL_API DSP_STATUS CHNL_delete(
+   IN ProcessorId procId,
+   IN ChannelId   chnlId)
+{
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   CHNL_allocateBuffer
+ *
+ *  @desc   Allocates buffers from the host heap, failing once the pool of
+ *          the processor would be exhausted.
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS CHNL_allocateBuffer(
+   IN  ProcessorId procId,
+   IN  ChannelId   chnlId,
+   OUT Char8 **    bufArray,
+   IN  Uint32      size,
+   IN  Uint32      numBufs)
+{
+   RGB2YCBCR_DSP_EmuDsp * dsp = &RGB2YCBCR_DSP_EmuDsps [procId];
+   Uint32                 i;
+
+   if ((dsp->allocated + numBufs) > dsp->poolBuffers) {
+      return DSP_EMEMORY;
+   }
+
+   for (i = 0 ; i < numBufs ; i++) {
+      bufArray [i] = (Char8 *) malloc(size);
+      if (bufArray [i] == NULL) {
+         while (i-- > 0) {
+            free(bufArray [i]);
+         }
+         return DSP_EMEMORY;
+      }
+   }
+   dsp->allocated += numBufs;
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   CHNL_freeBuffer
+ *
+ *  @desc   Returns buffers to the host heap.
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS CHNL_freeBuffer(
+   IN ProcessorId procId,
+   IN ChannelId   chnlId,
+   IN Char8 **    bufArray,
+   IN Uint32      numBufs)
+{
+   Uint32 i;
+
+   for (i = 0 ; i < numBufs ; i++) {
+      free(bufArray [i]);
+   }
+   RGB2YCBCR_DSP_EmuDsps [procId].allocated -= numBufs;
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   CHNL_issue
+ *
+ *  @desc   Queues a request for the emulated DSP.
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS CHNL_issue(
+   IN ProcessorId     procId,
+   IN ChannelId       chnlId,
+   IN ChannelIOInfo * ioReq)
+{
+   RGB2YCBCR_DSP_EmuDsp *     dsp  = &RGB2YCBCR_DSP_EmuDsps [procId];
+   RGB2YCBCR_DSP_EmuChannel * chnl = &dsp->channels [chnlId];
+
+   pthread_mutex_lock(&dsp->lock);
+   if ((chnl->pending.tail - chnl->pending.head) >= EMU_QUEUE_LEN) {
+      pthread_mutex_unlock(&dsp->lock);
+      return DSP_EFAIL;
+   }
+   RGB2YCBCR_DSP_EmuPut(&chnl->pending, ioReq);
+   pthread_cond_broadcast(&dsp->cond);
+   pthread_mutex_unlock(&dsp->lock);
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   CHNL_reclaim
+ *
+ *  @desc   Waits for the oldest request the emulated DSP is done with.
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS CHNL_reclaim(
+   IN  ProcessorId     procId,
+   IN  ChannelId       chnlId,
+   IN  Uint32          timeout,
+   OUT ChannelIOInfo * ioReq)
+{
+   RGB2YCBCR_DSP_EmuDsp * dsp    = &RGB2YCBCR_DSP_EmuDsps [procId];
+   DSP_STATUS             status = DSP_SOK;
+
+   pthread_mutex_lock(&dsp->lock);
+   while (!RGB2YCBCR_DSP_EmuGet(&dsp->channels [chnlId].done, ioReq)) {
+      if (timeout == WAIT_NONE) {
+         status = DSP_ETIMEOUT;
+         break;
+      }
+      pthread_cond_wait(&dsp->cond, &dsp->lock);
+   }
+   pthread_mutex_unlock(&dsp->lock);
+
+   return status;
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+#endif /* defined (RGB2YCBCR_DSP_EMULATION) */
@@ -0,0 +1,263 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_loadgen.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/Linux/
+ *
+ *  @desc   Load generator for the conversion daemon.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+/*  ----------------------------------- OS Specific Headers           */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <rgb2ycbcr-dsp.h>
+#include <rgb2ycbcr-dsp_os.h>
+#include <rgb2ycbcr-dsp_cvt.h>
+#include <rgb2ycbcr-dsp_client.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_LoadClient
+ *
+ *  @desc   State of one client of the load generator.
+ *
+ *  @field  thread
+ *              Thread sending the requests.
+ *  @field  socketPath
+ *              Path the daemon listens on.
+ *  @field  numRequests
+ *              Number of requests to send.
+ *  @field  frameSize
+ *              Size of the frames in bytes.
+ *  @field  latencies
+ *              Latency of every request, in seconds.
+ *  @field  status
+ *              Outcome of the client.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_LoadClient_tag {
+   pthread_t  thread;
+   Char8 *    socketPath;
+   Uint32     numRequests;
+   Uint32     frameSize;
+   Real64 *   latencies;
+   DSP_STATUS status;
+} RGB2YCBCR_DSP_LoadClient;
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_LoadCompare
+ *
+ *  @desc   qsort () comparison of two latencies.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC int RGB2YCBCR_DSP_LoadCompare(const void * a, const void * b)
+{
+   Real64 x = *(const Real64 *) a;
+   Real64 y = *(const Real64 *) b;
+
+   return (x > y) - (x < y);
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_LoadRun
+ *
+ *  @desc   Body of a client. Connects, fills a frame with a pattern and
+ *          sends it back to back. The first reply is checked against the
+ *          reference kernel, the others are only timed.
+ *
+ *  @modif  arg
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void * RGB2YCBCR_DSP_LoadRun(Void * arg)
+{
+   RGB2YCBCR_DSP_LoadClient * load     = (RGB2YCBCR_DSP_LoadClient *) arg;
+   RGB2YCBCR_DSP_Frame        frame;
+   Char8 *                    expected = NULL;
+   Int32                      client   = -1;
+   Real64                     start;
+   Uint32                     i;
+   Uint32                     j;
+
+   frame.data   = NULL;
+   load->status = RGB2YCBCR_DSP_ClientConnect(load->socketPath, &client);
+
+   if (DSP_SUCCEEDED(load->status)) {
+      load->status = RGB2YCBCR_DSP_FrameCreate(load->frameSize, &frame);
+   }
+
+   if (DSP_SUCCEEDED(load->status)) {
+      expected = (Char8 *) malloc(load->frameSize);
+      if (expected == NULL) {
+         load->status = DSP_EMEMORY;
+      }
+   }
+
+   for (i = 0; DSP_SUCCEEDED(load->status) && (i < load->numRequests); i++) {
+      if (i == 0) {
+         /* A pattern that covers every byte value */
+         for (j = 0; j < load->frameSize; j++) {
+            frame.data [j] = (Char8) (j * 7 + (j / 251));
+         }
+         memcpy(expected, frame.data, load->frameSize);
+         RGB2YCBCR_DSP_ConvertRef(expected, load->frameSize);
+      }
+
+      start        = RGB2YCBCR_DSP_GetTime();
+      load->status = RGB2YCBCR_DSP_ClientConvert(client, &frame);
+      load->latencies [i] = RGB2YCBCR_DSP_GetTime() - start;
+
+      if (   (i == 0) && DSP_SUCCEEDED(load->status)
+          && (memcmp(expected, frame.data, load->frameSize) != 0)) {
+         RGB2YCBCR_DSP_1Print("Client got a wrong frame back. Status = [0x%x]\n",
+                              DSP_EFAIL);
+         load->status = DSP_EFAIL;
+      }
+   }
+
+   if (DSP_FAILED(load->status)) {
+      RGB2YCBCR_DSP_1Print("Client request failed. Status = [0x%x]\n",
+                           load->status);
+   }
+
+   free(expected);
+   RGB2YCBCR_DSP_FrameDelete(&frame);
+   if (client >= 0) {
+      RGB2YCBCR_DSP_ClientDisconnect(client);
+   }
+
+   return NULL;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_LoadGen
+ *
+ *  @desc   Starts the clients, waits for them and prints the throughput
+ *          and latency percentiles over every request.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_LoadGen(
+   IN Char8 * socketPath,
+   IN Uint32  numClients,
+   IN Uint32  numRequests,
+   IN Uint32  frameSize)
+{
+   DSP_STATUS                 status    = DSP_SOK;
+   RGB2YCBCR_DSP_LoadClient * clients   = NULL;
+   Real64 *                   latencies = NULL;
+   Uint32                     numTotal  = numClients * numRequests;
+   Uint32                     numStarted = 0;
+   Real64                     start;
+   Real64                     elapsed;
+   Real64                     sum       = 0;
+   Uint32                     i;
+
+   if ((numClients == 0) || (numRequests == 0) || (frameSize == 0)) {
+      return DSP_EINVALIDARG;
+   }
+
+   clients   = (RGB2YCBCR_DSP_LoadClient *) calloc(numClients, sizeof(*clients));
+   latencies = (Real64 *) calloc(numTotal, sizeof(Real64));
+   if ((clients == NULL) || (latencies == NULL)) {
+      free(clients);
+      free(latencies);
+      return DSP_EMEMORY;
+   }
+
+   start = RGB2YCBCR_DSP_GetTime();
+   for (i = 0; i < numClients; i++) {
+      clients [i].socketPath  = socketPath;
+      clients [i].numRequests = numRequests;
+      clients [i].frameSize   = frameSize;
+      clients [i].latencies   = latencies + i * numRequests;
+      if (pthread_create(&clients [i].thread, NULL,
+                         RGB2YCBCR_DSP_LoadRun, &clients [i]) != 0) {
+         status = DSP_EFAIL;
+         break;
+      }
+      numStarted++;
+   }
+
+   for (i = 0; i < numStarted; i++) {
+      pthread_join(clients [i].thread, NULL);
+      if (DSP_FAILED(clients [i].status)) {
+         status = clients [i].status;
+      }
+   }
+   elapsed = RGB2YCBCR_DSP_GetTime() - start;
+
+   if (DSP_SUCCEEDED(status)) {
+      qsort(latencies, numTotal, sizeof(Real64), RGB2YCBCR_DSP_LoadCompare);
+      for (i = 0; i < numTotal; i++) {
+         sum += latencies [i];
+      }
+
+      printf("%u clients, %u requests of %u bytes in %.3f s, %.1f req/s, %.2f MB/s\n",
+             (unsigned int) numClients, (unsigned int) numTotal,
+             (unsigned int) frameSize, elapsed, numTotal / elapsed,
+             ((Real64) numTotal * frameSize) / (elapsed * 1000000.0));
+      printf("latency us : min %.1f mean %.1f p50 %.1f p99 %.1f p99.9 %.1f max %.1f\n",
+             latencies [0] * 1e6,
+             sum / numTotal * 1e6,
+             latencies [(Uint32) (numTotal * 0.50)] * 1e6,
+             latencies [(Uint32) (numTotal * 0.99)] * 1e6,
+             latencies [(Uint32) (numTotal * 0.999)] * 1e6,
+             latencies [numTotal - 1] * 1e6);
+   }
+
+   free(latencies);
+   free(clients);
+
+   return status;
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
@@ -42,6 +42,8 @@
 #include <unistd.h>
 #include <string.h>
 #include <stdarg.h>
+#include <time.h>
+#include <pthread.h>
 #include <png.h>
 
 /*  ----------------------------------- DSP/BIOS Link                 */
@@ -49,6 +51,7 @@
 
 /*  ----------------------------------- Application Header            */
 #include <rgb2ycbcr-dsp.h>
+#include <rgb2ycbcr-dsp_os.h>
 
 
 #if defined (__cplusplus)
@@ -103,6 +106,131 @@ NORMAL_API Uint32 RGB2YCBCR_DSP_Atoll (Char8 * str)
 }
 
 
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_GetTime
+ *
+ *  @desc   Reads CLOCK_MONOTONIC, which is not affected by changes to the
+ *          wall clock.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Real64 RGB2YCBCR_DSP_GetTime (Void)
+{
+   struct timespec now ;
+
+   clock_gettime (CLOCK_MONOTONIC, &now) ;
+   return (Real64) now.tv_sec + ((Real64) now.tv_nsec / 1e9) ;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ThreadCreate
+ *
+ *  @desc   Starts a POSIX thread. The handle holds its pthread_t.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_ThreadCreate (
+   OUT Pvoid *                 thread,
+   IN  RGB2YCBCR_DSP_ThreadFxn fxn,
+   IN  Pvoid                   arg)
+{
+   pthread_t * handle ;
+
+   handle = (pthread_t *) malloc (sizeof (pthread_t)) ;
+   if (handle == NULL) {
+      return DSP_EFAIL ;
+   }
+
+   if (pthread_create (handle, NULL, fxn, arg) != 0) {
+      free (handle) ;
+      return DSP_EFAIL ;
+   }
+
+   *thread = handle ;
+   return DSP_SOK ;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ThreadJoin
+ *
+ *  @desc   Joins the POSIX thread and frees the handle.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_ThreadJoin (
+   IN Pvoid thread)
+{
+   pthread_join (*((pthread_t *) thread), NULL) ;
+   free (thread) ;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_MutexCreate
+ *
+ *  @desc   Allocates and initializes a POSIX mutex.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_MutexCreate (
+   OUT Pvoid * mutex)
+{
+   pthread_mutex_t * handle ;
+
+   handle = (pthread_mutex_t *) malloc (sizeof (pthread_mutex_t)) ;
+   if (handle == NULL) {
+      return DSP_EMEMORY ;
+   }
+
+   pthread_mutex_init (handle, NULL) ;
+   *mutex = handle ;
+   return DSP_SOK ;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_MutexLock, RGB2YCBCR_DSP_MutexUnlock
+ *
+ *  @desc   Lock and unlock the POSIX mutex.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_MutexLock (
+   IN Pvoid mutex)
+{
+   pthread_mutex_lock ((pthread_mutex_t *) mutex) ;
+}
+
+NORMAL_API Void RGB2YCBCR_DSP_MutexUnlock (
+   IN Pvoid mutex)
+{
+   pthread_mutex_unlock ((pthread_mutex_t *) mutex) ;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_MutexDelete
+ *
+ *  @desc   Destroys the POSIX mutex and frees the handle.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_MutexDelete (
+   IN Pvoid mutex)
+{
+   pthread_mutex_destroy ((pthread_mutex_t *) mutex) ;
+   free (mutex) ;
+}
+
+
 #if defined (__cplusplus)
 }
 #endif /* defined (__cplusplus) */
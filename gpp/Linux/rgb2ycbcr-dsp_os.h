@@ -112,6 +112,156 @@ NORMAL_API Uint32 RGB2YCBCR_DSP_Atoll (
    Char8 * str);
 
 
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_GetTime
+ *
+ *  @desc   Returns the time of a monotonic clock, to measure how long
+ *          something takes.
+ *
+ *  @ret    <time>
+ *              Seconds since an unspecified point.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ============================================================================
+ */
+NORMAL_API Real64 RGB2YCBCR_DSP_GetTime (Void);
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_ThreadFxn
+ *
+ *  @desc   Body of a thread started with RGB2YCBCR_DSP_ThreadCreate ().
+ *  ============================================================================
+ */
+typedef Pvoid (*RGB2YCBCR_DSP_ThreadFxn) (Pvoid arg);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ThreadCreate
+ *
+ *  @desc   Starts a thread running fxn (arg).
+ *
+ *  @arg    thread
+ *              Receives the handle to join the thread with.
+ *
+ *  @arg    fxn
+ *              Body of the thread.
+ *
+ *  @arg    arg
+ *              Argument given to fxn.
+ *
+ *  @ret    DSP_SOK
+ *              The thread is running.
+ *          DSP_EFAIL
+ *              The thread could not be started.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_ThreadJoin
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_ThreadCreate (
+   OUT Pvoid *                 thread,
+   IN  RGB2YCBCR_DSP_ThreadFxn fxn,
+   IN  Pvoid                   arg);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ThreadJoin
+ *
+ *  @desc   Waits for a thread to return and releases its handle.
+ *
+ *  @arg    thread
+ *              Handle from RGB2YCBCR_DSP_ThreadCreate ().
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_ThreadCreate
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_ThreadJoin (
+   IN Pvoid thread);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_MutexCreate
+ *
+ *  @desc   Creates a mutex for threads of the same process.
+ *
+ *  @arg    mutex
+ *              Receives the handle of the mutex.
+ *
+ *  @ret    DSP_SOK
+ *              The mutex is ready.
+ *          DSP_EMEMORY
+ *              Out of memory for the mutex.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_MutexDelete
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_MutexCreate (
+   OUT Pvoid * mutex);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_MutexLock, RGB2YCBCR_DSP_MutexUnlock
+ *
+ *  @desc   Take and release a mutex.
+ *
+ *  @arg    mutex
+ *              Handle from RGB2YCBCR_DSP_MutexCreate ().
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_MutexCreate
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_MutexLock (
+   IN Pvoid mutex);
+
+NORMAL_API Void RGB2YCBCR_DSP_MutexUnlock (
+   IN Pvoid mutex);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_MutexDelete
+ *
+ *  @desc   Destroys a mutex nobody holds.
+ *
+ *  @arg    mutex
+ *              Handle from RGB2YCBCR_DSP_MutexCreate ().
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_MutexCreate
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_MutexDelete (
+   IN Pvoid mutex);
+
+
 #if defined (__cplusplus)
 }
 #endif /* defined (__cplusplus) */
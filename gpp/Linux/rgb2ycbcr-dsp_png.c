@@ -0,0 +1,445 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_png.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/Linux/
+ *
+ *  @desc   PNG reading and writing of whole images, with encode profiles.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+/*  ----------------------------------- OS Specific Headers           */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <rgb2ycbcr-dsp.h>
+#include <rgb2ycbcr-dsp_os.h>
+#include <rgb2ycbcr-dsp_png.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_PngSettings
+ *
+ *  @desc   libpng settings of an encode profile.
+ *
+ *  @field  name
+ *              Name of the profile.
+ *  @field  level
+ *              zlib compression level, or -1 to keep the default.
+ *  @field  filters
+ *              PNG_FILTER_XXX flags libpng picks from on every row, or -1
+ *              to keep the default.
+ *  @field  strategy
+ *              zlib strategy, or -1 to keep the default.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_PngSettings_tag {
+   Char8 * name;
+   int     level;
+   int     filters;
+   int     strategy;
+} RGB2YCBCR_DSP_PngSettings;
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_PngProfiles
+ *
+ *  @desc   Settings of the encode profiles, indexed by PNG_PROFILE_XXX.
+ *          Trying every filter on every row costs about as much as
+ *          deflating at a low level, so the fastest profile only predicts
+ *          from the pixel on the left. Z_RLE is quicker still on noisy
+ *          photographs but far bigger on flat areas, so it is left out.
+ *  ============================================================================
+ */
+STATIC RGB2YCBCR_DSP_PngSettings RGB2YCBCR_DSP_PngProfiles [] = {
+   { "default",  -1, -1,              -1         },
+   { "fastest",   1, PNG_FILTER_SUB,  Z_FILTERED },
+   { "balanced",  3, PNG_ALL_FILTERS, Z_FILTERED },
+   { "smallest",  9, PNG_ALL_FILTERS, Z_FILTERED }
+};
+
+#define NUM_PROFILES (sizeof (RGB2YCBCR_DSP_PngProfiles) / sizeof (RGB2YCBCR_DSP_PngProfiles [0]))
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_PngCount
+ *
+ *  @desc   libpng write function counting the bytes of the file instead of
+ *          writing them.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_PngCount(
+   IN png_structp png,
+   IN png_bytep   data,
+   IN png_size_t  length)
+{
+   *(Uint32 *) png_get_io_ptr(png) += (Uint32) length;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_PngFlush
+ *
+ *  @desc   libpng flush function of RGB2YCBCR_DSP_PngCount ().
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_PngFlush(
+   IN png_structp png)
+{
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_PngEncode
+ *
+ *  @desc   Encodes an image with a profile into a file, or only counts the
+ *          bytes of the file into numBytes when fp is NULL.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC DSP_STATUS RGB2YCBCR_DSP_PngEncode(
+   IN  FILE *                   fp,
+   IN  RGB2YCBCR_DSP_PngImage * image,
+   IN  Uint32                   profile,
+   OUT Uint32 *                 numBytes)
+{
+   DSP_STATUS  status = DSP_SOK;
+   png_structp png    = NULL;
+   png_infop   info   = NULL;
+
+   png = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+   if (png != NULL) {
+      info = png_create_info_struct(png);
+   }
+
+   if (info == NULL) {
+      status = DSP_EMEMORY;
+   }
+   else if (setjmp(png_jmpbuf(png))) {
+      status = DSP_EFAIL;
+   }
+   else {
+      if (fp != NULL) {
+         png_init_io(png, fp);
+      }
+      else {
+         *numBytes = 0;
+         png_set_write_fn(png, numBytes, RGB2YCBCR_DSP_PngCount, RGB2YCBCR_DSP_PngFlush);
+      }
+      png_set_IHDR(png, info, image->width, image->height,
+                   8, PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE,
+                   PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+      RGB2YCBCR_DSP_PngSetProfile(png, profile);
+      png_write_info(png, info);
+      png_write_image(png, image->rows);
+      png_write_end(png, NULL);
+   }
+
+   png_destroy_write_struct(&png, &info);
+
+   return status;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_GetPngProfile
+ *
+ *  @desc   Looks up an encode profile by name.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Int32 RGB2YCBCR_DSP_GetPngProfile(
+   IN Char8 * name)
+{
+   Uint32 i;
+
+   for (i = 0 ; i < NUM_PROFILES ; i++) {
+      if (strcmp(name, RGB2YCBCR_DSP_PngProfiles [i].name) == 0) {
+         return i;
+      }
+   }
+
+   return -1;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_PngSetProfile
+ *
+ *  @desc   Sets the settings of a profile the default does not keep.
+ *
+ *  @modif  png
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_PngSetProfile(
+   IN png_structp png,
+   IN Uint32      profile)
+{
+   RGB2YCBCR_DSP_PngSettings * settings;
+
+   if (profile >= NUM_PROFILES) {
+      return;
+   }
+
+   settings = &RGB2YCBCR_DSP_PngProfiles [profile];
+   if (settings->level >= 0) {
+      png_set_compression_level(png, settings->level);
+   }
+   if (settings->filters >= 0) {
+      png_set_filter(png, PNG_FILTER_TYPE_BASE, settings->filters);
+   }
+   if (settings->strategy >= 0) {
+      png_set_compression_strategy(png, settings->strategy);
+   }
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_PngRead
+ *
+ *  @desc   The rows point into a single buffer, so the image can be handed
+ *          to the DSP with no copy.
+ *
+ *  @modif  image
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_PngRead(
+   IN  Char8 *                  fileName,
+   OUT RGB2YCBCR_DSP_PngImage * image)
+{
+   /* Set after the setjmp () it is read back from */
+   volatile DSP_STATUS status = DSP_SOK;
+   png_structp         png    = NULL;
+   png_infop           info   = NULL;
+   png_byte            header [8];
+   Uint32              rowBytes;
+   Uint32              row;
+   FILE *              fp;
+
+   memset(image, 0, sizeof(*image));
+
+   fp = fopen(fileName, "rb");
+   if (fp == NULL) {
+      return DSP_EFAIL;
+   }
+
+   if ((fread(header, 1, 8, fp) != 8) || png_sig_cmp(header, 0, 8)) {
+      fclose(fp);
+      return DSP_EFAIL;
+   }
+
+   png = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+   if (png != NULL) {
+      info = png_create_info_struct(png);
+   }
+
+   if (info == NULL) {
+      status = DSP_EMEMORY;
+   }
+   else if (setjmp(png_jmpbuf(png))) {
+      status = DSP_EFAIL;
+   }
+   else {
+      png_init_io(png, fp);
+      png_set_sig_bytes(png, 8);
+      png_read_info(png, info);
+
+      image->width  = png_get_image_width(png, info);
+      image->height = png_get_image_height(png, info);
+      if (   (png_get_bit_depth(png, info) != 8)
+          || (png_get_color_type(png, info) != PNG_COLOR_TYPE_RGB)) {
+         printf("%s is not an 8 bit RGB image\n", fileName);
+         status = DSP_EFAIL;
+      }
+   }
+
+   if (DSP_SUCCEEDED(status) && !setjmp(png_jmpbuf(png))) {
+      png_set_interlace_handling(png);
+      png_read_update_info(png, info);
+
+      rowBytes    = image->width * 3;
+      image->data = (Char8 *) malloc(rowBytes * image->height);
+      image->rows = (png_bytep *) malloc(sizeof(png_bytep) * image->height);
+      if ((image->data == NULL) || (image->rows == NULL)) {
+         status = DSP_EMEMORY;
+      }
+      else {
+         for (row = 0; row < image->height; row++) {
+            image->rows [row] = (png_bytep) (image->data + (row * rowBytes));
+         }
+         png_read_image(png, image->rows);
+      }
+   }
+   else if (DSP_SUCCEEDED(status)) {
+      status = DSP_EFAIL;
+   }
+
+   png_destroy_read_struct(&png, &info, NULL);
+   fclose(fp);
+
+   return status;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_PngWrite
+ *
+ *  @desc   Writes an image as a PNG with an encode profile.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_PngWrite(
+   IN Char8 *                  fileName,
+   IN RGB2YCBCR_DSP_PngImage * image,
+   IN Uint32                   profile)
+{
+   DSP_STATUS status;
+   FILE *     fp;
+
+   fp = fopen(fileName, "wb");
+   if (fp == NULL) {
+      return DSP_EFAIL;
+   }
+
+   status = RGB2YCBCR_DSP_PngEncode(fp, image, profile, NULL);
+   if (fclose(fp) != 0) {
+      status = DSP_EFAIL;
+   }
+
+   return status;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_PngFree
+ *
+ *  @desc   Frees the pixels of an image.
+ *
+ *  @modif  image
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_PngFree(
+   IN OUT RGB2YCBCR_DSP_PngImage * image)
+{
+   free(image->rows);
+   free(image->data);
+   image->rows = NULL;
+   image->data = NULL;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_PngBench
+ *
+ *  @desc   Every profile encodes the whole set in turn, so the images are
+ *          as warm in the cache for each of them.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_PngBench(
+   IN Char8 ** fileNames,
+   IN Uint32   numFiles)
+{
+   DSP_STATUS               status   = DSP_SOK;
+   RGB2YCBCR_DSP_PngImage * images;
+   Uint32                   numRead  = 0;
+   Uint32                   rawBytes = 0;
+   Uint32                   numBytes;
+   Uint32                   totalBytes;
+   Uint32                   profile;
+   Uint32                   i;
+   Real64                   start;
+   Real64                   elapsed;
+
+   images = (RGB2YCBCR_DSP_PngImage *) calloc(numFiles, sizeof(RGB2YCBCR_DSP_PngImage));
+   if (images == NULL) {
+      return DSP_EMEMORY;
+   }
+
+   for (i = 0 ; (i < numFiles) && DSP_SUCCEEDED(status) ; i++) {
+      status = RGB2YCBCR_DSP_PngRead(fileNames [i], &images [i]);
+      numRead++;
+      if (DSP_FAILED(status)) {
+         printf("Could not read %s\n", fileNames [i]);
+      }
+      else {
+         rawBytes += images [i].width * images [i].height * 3;
+      }
+   }
+
+   if (DSP_SUCCEEDED(status)) {
+      printf("%u images, %u bytes of pixels\n", (unsigned int) numFiles, (unsigned int) rawBytes);
+      printf("%-10s %10s %8s %12s %7s\n", "profile", "encode ms", "MB/s", "bytes", "ratio");
+   }
+
+   for (profile = 0 ; (profile < NUM_PROFILES) && DSP_SUCCEEDED(status) ; profile++) {
+      totalBytes = 0;
+      start      = RGB2YCBCR_DSP_GetTime();
+      for (i = 0 ; (i < numFiles) && DSP_SUCCEEDED(status) ; i++) {
+         status      = RGB2YCBCR_DSP_PngEncode(NULL, &images [i], profile, &numBytes);
+         totalBytes += numBytes;
+      }
+      elapsed = RGB2YCBCR_DSP_GetTime() - start;
+
+      if (DSP_SUCCEEDED(status)) {
+         printf("%-10s %10.1f %8.2f %12u %6.1f%%\n",
+                RGB2YCBCR_DSP_PngProfiles [profile].name,
+                elapsed * 1e3,
+                (elapsed > 0) ? ((Real64) rawBytes / elapsed / 1e6) : 0.0,
+                (unsigned int) totalBytes,
+                (rawBytes > 0) ? (100.0 * totalBytes / rawBytes) : 0.0);
+      }
+   }
+
+   for (i = 0 ; i < numRead ; i++) {
+      RGB2YCBCR_DSP_PngFree(&images [i]);
+   }
+   free(images);
+
+   return status;
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
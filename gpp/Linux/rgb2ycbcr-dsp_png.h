@@ -0,0 +1,264 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_png.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/Linux/
+ *
+ *  @desc   PNG reading and writing of whole images, with encode profiles
+ *          trading the size of the file for the time deflate takes.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RGB2YCBCR_DSP_PNG_H)
+#define RGB2YCBCR_DSP_PNG_H
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/* PNG header to manipulate the image */
+#include <png.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  PNG_PROFILE_DEFAULT, PNG_PROFILE_FASTEST, PNG_PROFILE_BALANCED,
+ *          PNG_PROFILE_SMALLEST
+ *
+ *  @desc   Encode profiles. The default leaves libpng to its own settings,
+ *          zlib level 6 with every filter tried on every row. Fastest
+ *          deflates at level 1 with the Sub filter only, balanced at level
+ *          3 and smallest at level 9, both with every filter.
+ *  ============================================================================
+ */
+#define PNG_PROFILE_DEFAULT  0
+#define PNG_PROFILE_FASTEST  1
+#define PNG_PROFILE_BALANCED 2
+#define PNG_PROFILE_SMALLEST 3
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_PngImage
+ *
+ *  @desc   An 8 bit R, G, B image held in one buffer.
+ *
+ *  @field  width, height
+ *              Size of the image in pixels.
+ *  @field  data
+ *              Interleaved pixels of the whole image.
+ *  @field  rows
+ *              Start of every row in data, as libpng takes them.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_PngImage_tag {
+   Uint32      width;
+   Uint32      height;
+   Char8 *     data;
+   png_bytep * rows;
+} RGB2YCBCR_DSP_PngImage;
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_GetPngProfile
+ *
+ *  @desc   Looks up an encode profile by name: "default", "fastest",
+ *          "balanced" or "smallest".
+ *
+ *  @arg    name
+ *              Name of the profile.
+ *
+ *  @ret    One of PNG_PROFILE_XXX, or -1 if there is none with that name.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_PngSetProfile
+ *  ============================================================================
+ */
+NORMAL_API Int32 RGB2YCBCR_DSP_GetPngProfile(
+   IN Char8 * name);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_PngSetProfile
+ *
+ *  @desc   Sets the compression level, the filters and the zlib strategy of
+ *          a profile on a writer. It must be called before the rows are
+ *          written.
+ *
+ *  @arg    png
+ *              libpng writer.
+ *
+ *  @arg    profile
+ *              One of PNG_PROFILE_XXX.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_GetPngProfile
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_PngSetProfile(
+   IN png_structp png,
+   IN Uint32      profile);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_PngRead
+ *
+ *  @desc   Reads an 8 bit R, G, B PNG image into a buffer of its own. The
+ *          libpng state lives on the stack, so several images can be read
+ *          at once from different threads.
+ *
+ *  @arg    fileName
+ *              File to read.
+ *
+ *  @arg    image
+ *              Receives the image, to be freed with RGB2YCBCR_DSP_PngFree ()
+ *              whatever the outcome.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EMEMORY
+ *              Out of memory.
+ *          DSP_EFAIL
+ *              The file is not an 8 bit R, G, B PNG image.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_PngWrite, RGB2YCBCR_DSP_PngFree
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_PngRead(
+   IN  Char8 *                  fileName,
+   OUT RGB2YCBCR_DSP_PngImage * image);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_PngWrite
+ *
+ *  @desc   Writes an image as a PNG with an encode profile.
+ *
+ *  @arg    fileName
+ *              File to write.
+ *
+ *  @arg    image
+ *              Image to write.
+ *
+ *  @arg    profile
+ *              One of PNG_PROFILE_XXX.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EMEMORY
+ *              Out of memory.
+ *          DSP_EFAIL
+ *              The file could not be written.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_PngRead
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_PngWrite(
+   IN Char8 *                  fileName,
+   IN RGB2YCBCR_DSP_PngImage * image,
+   IN Uint32                   profile);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_PngFree
+ *
+ *  @desc   Frees the pixels of an image.
+ *
+ *  @arg    image
+ *              Image from RGB2YCBCR_DSP_PngRead ().
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_PngRead
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_PngFree(
+   IN OUT RGB2YCBCR_DSP_PngImage * image);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_PngBench
+ *
+ *  @desc   Encodes a set of images with every profile and prints the time
+ *          the encoding took and the size of the files, per profile. The
+ *          images are read once and encoded in memory, so only libpng and
+ *          zlib are timed.
+ *
+ *  @arg    fileNames
+ *              Images of the set.
+ *
+ *  @arg    numFiles
+ *              Number of images.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EFAIL
+ *              An image could not be read or encoded.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_PngSetProfile
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_PngBench(
+   IN Char8 ** fileNames,
+   IN Uint32   numFiles);
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RGB2YCBCR_DSP_PNG_H) */
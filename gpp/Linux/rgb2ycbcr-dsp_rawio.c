@@ -0,0 +1,586 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_rawio.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/Linux/
+ *
+ *  @desc   Reading and writing of uncompressed frames without libpng.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+/*  ----------------------------------- OS Specific Headers           */
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <rgb2ycbcr-dsp.h>
+#include <rgb2ycbcr-dsp_cvt.h>
+#include <rgb2ycbcr-dsp_rawio.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  Y4M_MAGIC, Y4M_FRAME
+ *
+ *  @desc   Start of a YUV4MPEG2 stream header and of a frame header.
+ *  ============================================================================
+ */
+#define Y4M_MAGIC "YUV4MPEG2"
+#define Y4M_FRAME "FRAME"
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_RawSpace
+ *
+ *  @desc   Tells whether a character is white space in a PPM header.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Bool RGB2YCBCR_DSP_RawSpace(
+   IN Char8 c)
+{
+   return ((c == ' ') || (c == '\t') || (c == '\n') || (c == '\r')) ? TRUE : FALSE;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_RawNumber
+ *
+ *  @desc   Reads a decimal number of a PPM header at *offset, after the
+ *          white space and the comments before it, and moves the offset
+ *          past it.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Bool RGB2YCBCR_DSP_RawNumber(
+   IN     RGB2YCBCR_DSP_RawInput * input,
+   IN OUT Uint32 *                 offset,
+   OUT    Uint32 *                 value)
+{
+   Uint32 pos    = *offset;
+   Uint32 digits = 0;
+
+   while (pos < input->mapSize) {
+      if (input->map [pos] == '#') {
+         while ((pos < input->mapSize) && (input->map [pos] != '\n')) {
+            pos++;
+         }
+      }
+      else if (RGB2YCBCR_DSP_RawSpace(input->map [pos])) {
+         pos++;
+      }
+      else {
+         break;
+      }
+   }
+
+   *value = 0;
+   while (   (pos < input->mapSize) && (digits < 9)
+          && (input->map [pos] >= '0') && (input->map [pos] <= '9')) {
+      *value = (*value * 10) + (input->map [pos] - '0');
+      pos++;
+      digits++;
+   }
+
+   *offset = pos;
+
+   return (digits > 0) ? TRUE : FALSE;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_RawPpmHeader
+ *
+ *  @desc   Reads the header of the PPM image at *offset and moves the
+ *          offset to its pixels.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC DSP_STATUS RGB2YCBCR_DSP_RawPpmHeader(
+   IN     RGB2YCBCR_DSP_RawInput * input,
+   IN OUT Uint32 *                 offset,
+   OUT    Uint32 *                 width,
+   OUT    Uint32 *                 height)
+{
+   Uint32 pos = *offset;
+   Uint32 maxValue;
+
+   if (   ((pos + 2) > input->mapSize) || (input->map [pos] != 'P')
+       || (input->map [pos + 1] != '6')) {
+      return DSP_EFAIL;
+   }
+   pos += 2;
+
+   if (   !RGB2YCBCR_DSP_RawNumber(input, &pos, width)
+       || !RGB2YCBCR_DSP_RawNumber(input, &pos, height)
+       || !RGB2YCBCR_DSP_RawNumber(input, &pos, &maxValue)
+       || (pos >= input->mapSize) || !RGB2YCBCR_DSP_RawSpace(input->map [pos])) {
+      return DSP_EFAIL;
+   }
+
+   if ((*width == 0) || (*height == 0) || (maxValue != 255)) {
+      printf("Only 8 bit PPM images are read\n");
+      return DSP_EFAIL;
+   }
+
+   /* A single white space character separates the header from the pixels */
+   *offset = pos + 1;
+
+   return DSP_SOK;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_RawY4mHeader
+ *
+ *  @desc   Reads the YUV4MPEG2 stream header at the start of the file and
+ *          moves input->next to the first frame. Without a C parameter
+ *          the stream is 4:2:0.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC DSP_STATUS RGB2YCBCR_DSP_RawY4mHeader(
+   IN OUT RGB2YCBCR_DSP_RawInput * input)
+{
+   Char8 *      end;
+   Char8 *      token;
+   Bool         is444 = FALSE;
+   unsigned int value;
+
+   end = memchr(input->map, '\n', input->mapSize);
+   if (   (end == NULL)
+       || (strncmp(input->map, Y4M_MAGIC " ", strlen(Y4M_MAGIC) + 1) != 0)) {
+      return DSP_EFAIL;
+   }
+
+   /* Parameters are a letter and a value, separated by single spaces */
+   for (token = input->map + strlen(Y4M_MAGIC) + 1; token < end; token++) {
+      if (token [-1] != ' ') {
+         continue;
+      }
+      if ((token [0] == 'W') && (sscanf(token + 1, "%u", &value) == 1)) {
+         input->width = value;
+      }
+      else if ((token [0] == 'H') && (sscanf(token + 1, "%u", &value) == 1)) {
+         input->height = value;
+      }
+      else if (token [0] == 'C') {
+         is444 = (   (strncmp(token, "C444", 4) == 0)
+                  && ((token [4] == ' ') || (token [4] == '\n'))) ? TRUE : FALSE;
+      }
+   }
+
+   if ((input->width == 0) || (input->height == 0)) {
+      return DSP_EFAIL;
+   }
+
+   if (!is444) {
+      printf("Only 4:4:4 Y4M streams can be converted back to R, G, B\n");
+      return DSP_EFAIL;
+   }
+
+   input->next = (Uint32) (end + 1 - input->map);
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_RawKind
+ *
+ *  @desc   Tells the kind of a file from its name.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Uint32 RGB2YCBCR_DSP_RawKind(
+   IN Char8 * fileName)
+{
+   Char8 * extension = strrchr(fileName, '.');
+
+   if (extension == NULL) {
+      return RAW_KIND_NONE;
+   }
+   if (strcmp(extension, ".ppm") == 0) {
+      return RAW_KIND_PPM;
+   }
+   if (strcmp(extension, ".y4m") == 0) {
+      return RAW_KIND_Y4M;
+   }
+   if (   (strcmp(extension, ".rgb") == 0) || (strcmp(extension, ".yuv") == 0)
+       || (strcmp(extension, ".raw") == 0)) {
+      return RAW_KIND_RAW;
+   }
+
+   return RAW_KIND_NONE;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_RawOpen
+ *
+ *  @desc   Maps a PPM, raw or Y4M file and reads the size of its frames.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_RawOpen(
+   IN  Char8 *                  fileName,
+   IN  Uint32                   kind,
+   IN  Uint32                   width,
+   IN  Uint32                   height,
+   OUT RGB2YCBCR_DSP_RawInput * input)
+{
+   DSP_STATUS  status = DSP_SOK;
+   struct stat fileStat;
+   Uint32      offset = 0;
+   int         fd;
+
+   memset(input, 0, sizeof(RGB2YCBCR_DSP_RawInput));
+   input->kind = kind;
+
+   if ((kind == RAW_KIND_RAW) && ((width == 0) || (height == 0))) {
+      printf("Raw frames need a size, given with -r\n");
+      return DSP_EINVALIDARG;
+   }
+
+   fd = open(fileName, O_RDONLY);
+   if (fd < 0) {
+      printf("Could not open %s\n", fileName);
+      return DSP_EFAIL;
+   }
+
+   if (   (fstat(fd, &fileStat) != 0) || (fileStat.st_size == 0)
+       || (fileStat.st_size != (off_t) (Uint32) fileStat.st_size)) {
+      printf("Can not map %s\n", fileName);
+      close(fd);
+      return DSP_EFAIL;
+   }
+
+   /* The frames are read once, front to back, straight from the page cache */
+   input->mapSize = (Uint32) fileStat.st_size;
+   input->map     = mmap(NULL, input->mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (input->map == MAP_FAILED) {
+      printf("Can not map %s\n", fileName);
+      input->map = NULL;
+      return DSP_EFAIL;
+   }
+   madvise(input->map, input->mapSize, MADV_SEQUENTIAL);
+
+   switch (kind) {
+   case RAW_KIND_PPM:
+      status = RGB2YCBCR_DSP_RawPpmHeader(input, &offset, &input->width, &input->height);
+      break;
+   case RAW_KIND_Y4M:
+      status = RGB2YCBCR_DSP_RawY4mHeader(input);
+      break;
+   default:
+      input->width  = width;
+      input->height = height;
+      break;
+   }
+
+   /* Every size below is a product of these, it must fit in 32 bits */
+   if (   DSP_SUCCEEDED(status)
+       && (   (input->width == 0) || (input->height == 0)
+           || (input->width > (0xFFFFFFFFu / 3 / input->height)))) {
+      printf("Frames of %ux%u are too large\n",
+             (unsigned int) input->width, (unsigned int) input->height);
+      status = DSP_EFAIL;
+   }
+
+   if (DSP_FAILED(status)) {
+      printf("%s is not a file this reads\n", fileName);
+      RGB2YCBCR_DSP_RawClose(input);
+   }
+
+   return status;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_RawRead
+ *
+ *  @desc   Copies the next frame out of the mapping as interleaved pixels.
+ *
+ *  @modif  input->next
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_RawRead(
+   IN OUT RGB2YCBCR_DSP_RawInput * input,
+   OUT    Char8 *                  pixels)
+{
+   Uint32  numPixels = input->width * input->height;
+   Uint32  offset    = input->next;
+   Uint32  width;
+   Uint32  height;
+   Uint32  i;
+   Char8 * end;
+   Char8 * y;
+   Char8 * cb;
+   Char8 * cr;
+
+   /* White space after the last PPM image is not an image */
+   while (   (input->kind == RAW_KIND_PPM) && (offset < input->mapSize)
+          && RGB2YCBCR_DSP_RawSpace(input->map [offset])) {
+      offset++;
+   }
+
+   if (offset >= input->mapSize) {
+      return DSP_ENOTFOUND;
+   }
+
+   if (input->kind == RAW_KIND_PPM) {
+      if (   DSP_FAILED(RGB2YCBCR_DSP_RawPpmHeader(input, &offset, &width, &height))
+          || (width != input->width) || (height != input->height)) {
+         printf("The PPM images are not all %ux%u\n",
+                (unsigned int) input->width, (unsigned int) input->height);
+         return DSP_EFAIL;
+      }
+   }
+   else if (input->kind == RAW_KIND_Y4M) {
+      end = memchr(input->map + offset, '\n', input->mapSize - offset);
+      if (   (end == NULL)
+          || (strncmp(input->map + offset, Y4M_FRAME, strlen(Y4M_FRAME)) != 0)) {
+         printf("Bad Y4M frame header\n");
+         return DSP_EFAIL;
+      }
+      offset = (Uint32) (end + 1 - input->map);
+   }
+
+   if ((input->mapSize - offset) < (numPixels * 3)) {
+      printf("The file ends inside a frame\n");
+      return DSP_EFAIL;
+   }
+
+   if (input->kind == RAW_KIND_Y4M) {
+      /* The planes interleave into Y, Cb, Cr pixels */
+      y  = input->map + offset;
+      cb = y + numPixels;
+      cr = cb + numPixels;
+      for (i = 0; i < numPixels; i++) {
+         pixels [(3 * i)]     = y  [i];
+         pixels [(3 * i) + 1] = cb [i];
+         pixels [(3 * i) + 2] = cr [i];
+      }
+   }
+   else {
+      memcpy(pixels, input->map + offset, numPixels * 3);
+   }
+
+   input->next = offset + (numPixels * 3);
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_RawClose
+ *
+ *  @desc   Unmaps a file.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_RawClose(
+   IN RGB2YCBCR_DSP_RawInput * input)
+{
+   if (input->map != NULL) {
+      munmap(input->map, input->mapSize);
+      input->map = NULL;
+   }
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_RawCreate
+ *
+ *  @desc   Creates a file frames of a format are written to.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_RawCreate(
+   IN  Char8 *                   fileName,
+   IN  Uint32                    kind,
+   IN  Uint32                    width,
+   IN  Uint32                    height,
+   IN  Uint32                    format,
+   IN  Uint32                    filter,
+   OUT RGB2YCBCR_DSP_RawOutput * output)
+{
+   Char8   header [64];
+   Char8 * chroma;
+   int     length = 0;
+
+   memset(output, 0, sizeof(RGB2YCBCR_DSP_RawOutput));
+   output->fd = -1;
+
+   if ((kind == RAW_KIND_PPM) && (format != RGB2YCBCR_DSP_FORMAT_PACKED)) {
+      printf("PPM holds packed pixels only\n");
+      return DSP_EINVALIDARG;
+   }
+   if ((kind == RAW_KIND_Y4M) && (format == RGB2YCBCR_DSP_FORMAT_PACKED)) {
+      printf("Y4M holds planes only\n");
+      return DSP_EINVALIDARG;
+   }
+   if ((kind == RAW_KIND_Y4M) && (format == RGB2YCBCR_DSP_FORMAT_NV12)) {
+      printf("Y4M has no NV12 layout, writing the planes raw\n");
+      kind = RAW_KIND_RAW;
+   }
+
+   output->kind = kind;
+   output->fd   = open(fileName, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+   if (output->fd < 0) {
+      printf("Could not create %s\n", fileName);
+      return DSP_EFAIL;
+   }
+
+   if (kind == RAW_KIND_PPM) {
+      output->headerSize = snprintf(output->header, sizeof(output->header),
+                                    "P6\n%u %u\n255\n",
+                                    (unsigned int) width, (unsigned int) height);
+   }
+   else if (kind == RAW_KIND_Y4M) {
+      if (format == RGB2YCBCR_DSP_FORMAT_I444)
+         chroma = "444";
+      else if (format == RGB2YCBCR_DSP_FORMAT_I422)
+         chroma = "422";
+      else if (filter == RGB2YCBCR_DSP_FILTER_BOX)
+         chroma = "420jpeg";
+      else
+         chroma = "420mpeg2";
+      length = snprintf(header, sizeof(header), Y4M_MAGIC " W%u H%u F25:1 Ip A1:1 C%s\n",
+                        (unsigned int) width, (unsigned int) height, chroma);
+      output->headerSize = snprintf(output->header, sizeof(output->header),
+                                    Y4M_FRAME "\n");
+   }
+
+   if ((length > 0) && (write(output->fd, header, length) != length)) {
+      printf("Could not write %s\n", fileName);
+      close(output->fd);
+      output->fd = -1;
+      return DSP_EFAIL;
+   }
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_RawWrite
+ *
+ *  @desc   Appends a frame, its header and its data in a single writev ().
+ *          A short write carries on from where it stopped.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_RawWrite(
+   IN RGB2YCBCR_DSP_RawOutput * output,
+   IN Char8 *                   data,
+   IN Uint32                    size)
+{
+   struct iovec   iov [2];
+   struct iovec * first  = iov;
+   int            numIov = 0;
+   size_t         left   = size + output->headerSize;
+   ssize_t        written;
+
+   if (output->headerSize > 0) {
+      iov [numIov].iov_base = output->header;
+      iov [numIov].iov_len  = output->headerSize;
+      numIov++;
+   }
+   iov [numIov].iov_base = data;
+   iov [numIov].iov_len  = size;
+   numIov++;
+
+   while (left > 0) {
+      written = writev(output->fd, first, numIov);
+      if (written < 0) {
+         if (errno == EINTR) {
+            continue;
+         }
+         printf("Could not write a frame\n");
+         return DSP_EFAIL;
+      }
+
+      left -= written;
+      while ((numIov > 0) && ((size_t) written >= first->iov_len)) {
+         written -= first->iov_len;
+         first++;
+         numIov--;
+      }
+      if (numIov > 0) {
+         first->iov_base = (Char8 *) first->iov_base + written;
+         first->iov_len -= written;
+      }
+   }
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_RawFinish
+ *
+ *  @desc   Closes a file.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_RawFinish(
+   IN RGB2YCBCR_DSP_RawOutput * output)
+{
+   DSP_STATUS status = DSP_SOK;
+
+   if ((output->fd >= 0) && (close(output->fd) != 0)) {
+      status = DSP_EFAIL;
+   }
+   output->fd = -1;
+
+   return status;
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
@@ -0,0 +1,351 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_rawio.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/Linux/
+ *
+ *  @desc   Reading and writing of uncompressed frames, binary PPM, raw
+ *          pixels and YUV4MPEG2, without going through libpng. Inputs are
+ *          mapped in memory, outputs written with one system call a frame.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RGB2YCBCR_DSP_RAWIO_H)
+#define RGB2YCBCR_DSP_RAWIO_H
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  RAW_KIND_NONE, RAW_KIND_PPM, RAW_KIND_RAW, RAW_KIND_Y4M
+ *
+ *  @desc   Kinds of files. None is a PNG, left to libpng. PPM is binary
+ *          (P6) with a maximum value of 255, one image or several of the
+ *          same size one after the other. Raw holds frames without any
+ *          header, R, G, B pixels or the planes of a format. Y4M is a
+ *          YUV4MPEG2 stream.
+ *  ============================================================================
+ */
+#define RAW_KIND_NONE 0
+#define RAW_KIND_PPM  1
+#define RAW_KIND_RAW  2
+#define RAW_KIND_Y4M  3
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_RawInput
+ *
+ *  @desc   A file of frames mapped in memory.
+ *
+ *  @field  kind
+ *              One of RAW_KIND_XXX.
+ *  @field  map
+ *              Start of the mapping.
+ *  @field  mapSize
+ *              Size of the file.
+ *  @field  next
+ *              Offset of the next frame, its header included.
+ *  @field  width, height
+ *              Size of every frame in pixels.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_RawInput_tag {
+   Uint32  kind;
+   Char8 * map;
+   Uint32  mapSize;
+   Uint32  next;
+   Uint32  width;
+   Uint32  height;
+} RGB2YCBCR_DSP_RawInput;
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_RawOutput
+ *
+ *  @desc   A file frames are appended to.
+ *
+ *  @field  kind
+ *              One of RAW_KIND_XXX, never RAW_KIND_NONE.
+ *  @field  fd
+ *              Descriptor of the file.
+ *  @field  header
+ *              Header written before every frame.
+ *  @field  headerSize
+ *              Size of the header, 0 for raw frames.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_RawOutput_tag {
+   Uint32 kind;
+   int    fd;
+   Char8  header [32];
+   Uint32 headerSize;
+} RGB2YCBCR_DSP_RawOutput;
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_RawKind
+ *
+ *  @desc   Tells the kind of a file from its name: .ppm is PPM, .y4m is
+ *          Y4M, .rgb, .yuv and .raw are raw and anything else is left to
+ *          libpng.
+ *
+ *  @arg    fileName
+ *              Name of the file.
+ *
+ *  @ret    One of RAW_KIND_XXX.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_RawOpen, RGB2YCBCR_DSP_RawCreate
+ *  ============================================================================
+ */
+NORMAL_API Uint32 RGB2YCBCR_DSP_RawKind(
+   IN Char8 * fileName);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_RawOpen
+ *
+ *  @desc   Maps a PPM, raw or Y4M file and reads the size of its frames.
+ *          Raw frames carry no size, it is given. Only 4:4:4 Y4M streams
+ *          are read, as their frames interleave into Y, Cb, Cr pixels the
+ *          inverse converts.
+ *
+ *  @arg    fileName
+ *              File to read.
+ *
+ *  @arg    kind
+ *              One of RAW_KIND_PPM, RAW_KIND_RAW or RAW_KIND_Y4M.
+ *
+ *  @arg    width, height
+ *              Size of the frames of a raw file, ignored for the others.
+ *
+ *  @arg    input
+ *              Receives the mapped file.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EINVALIDARG
+ *              No size for a raw file.
+ *          DSP_EFAIL
+ *              The file can not be mapped, or its header is not one this
+ *              reads.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_RawRead, RGB2YCBCR_DSP_RawClose
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_RawOpen(
+   IN  Char8 *                  fileName,
+   IN  Uint32                   kind,
+   IN  Uint32                   width,
+   IN  Uint32                   height,
+   OUT RGB2YCBCR_DSP_RawInput * input);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_RawRead
+ *
+ *  @desc   Copies the next frame out of the mapping as interleaved pixels,
+ *          R, G, B for PPM and raw, Y, Cb, Cr for Y4M.
+ *
+ *  @arg    input
+ *              File from RGB2YCBCR_DSP_RawOpen ().
+ *
+ *  @arg    pixels
+ *              Receives the frame, 3 bytes per pixel.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_ENOTFOUND
+ *              There are no more frames.
+ *          DSP_EFAIL
+ *              The file ends inside a frame, or a frame of a PPM file has
+ *              another size.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_RawOpen
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_RawRead(
+   IN OUT RGB2YCBCR_DSP_RawInput * input,
+   OUT    Char8 *                  pixels);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_RawClose
+ *
+ *  @desc   Unmaps a file.
+ *
+ *  @arg    input
+ *              File from RGB2YCBCR_DSP_RawOpen ().
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_RawOpen
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_RawClose(
+   IN RGB2YCBCR_DSP_RawInput * input);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_RawCreate
+ *
+ *  @desc   Creates a file frames of a format are written to. PPM takes
+ *          packed pixels. Y4M takes planes, and gets its stream header
+ *          here. The 4:2:0 chroma siting is the closest Y4M has to the
+ *          filter: box filtered chroma sits between the rows and the
+ *          columns (jpeg), the other filters keep it on the left column
+ *          (mpeg2). Y4M has no NV12 layout, those planes are written raw.
+ *
+ *  @arg    fileName
+ *              File to write.
+ *
+ *  @arg    kind
+ *              One of RAW_KIND_PPM, RAW_KIND_RAW or RAW_KIND_Y4M.
+ *
+ *  @arg    width, height
+ *              Size of the frames in pixels.
+ *
+ *  @arg    format
+ *              One of RGB2YCBCR_DSP_FORMAT_XXX.
+ *
+ *  @arg    filter
+ *              Chroma filter of the subsampled formats.
+ *
+ *  @arg    output
+ *              Receives the file.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EINVALIDARG
+ *              PPM with planes, or Y4M with packed pixels.
+ *          DSP_EFAIL
+ *              The file could not be created.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_RawWrite, RGB2YCBCR_DSP_RawFinish
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_RawCreate(
+   IN  Char8 *                   fileName,
+   IN  Uint32                    kind,
+   IN  Uint32                    width,
+   IN  Uint32                    height,
+   IN  Uint32                    format,
+   IN  Uint32                    filter,
+   OUT RGB2YCBCR_DSP_RawOutput * output);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_RawWrite
+ *
+ *  @desc   Appends a frame, its header and its data gathered in a single
+ *          writev ().
+ *
+ *  @arg    output
+ *              File from RGB2YCBCR_DSP_RawCreate ().
+ *
+ *  @arg    data
+ *              Packed pixels or planes of the frame, one after the other.
+ *
+ *  @arg    size
+ *              Size of the data in bytes.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EFAIL
+ *              The frame could not be written.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_RawCreate
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_RawWrite(
+   IN RGB2YCBCR_DSP_RawOutput * output,
+   IN Char8 *                   data,
+   IN Uint32                    size);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_RawFinish
+ *
+ *  @desc   Closes a file.
+ *
+ *  @arg    output
+ *              File from RGB2YCBCR_DSP_RawCreate ().
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EFAIL
+ *              The file could not be closed, some data may be lost.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_RawCreate
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_RawFinish(
+   IN RGB2YCBCR_DSP_RawOutput * output);
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RGB2YCBCR_DSP_RAWIO_H) */
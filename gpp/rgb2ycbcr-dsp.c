@@ -35,6 +35,11 @@
  */
 
 
+/*  ----------------------------------- OS Specific Headers             */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 /*  ----------------------------------- DSP/BIOS Link                   */
 #include <dsplink.h>
 
@@ -46,6 +51,8 @@
 /*  ----------------------------------- Application Header              */
 #include <rgb2ycbcr-dsp.h>
 #include <rgb2ycbcr-dsp_os.h>
+#include <rgb2ycbcr-dsp_cvt.h>
+#include <rgb2ycbcr-dsp_stats.h>
 
 
 #if defined (__cplusplus)
@@ -58,7 +65,15 @@ extern "C" {
  *  @desc   Number of arguments specified to the DSP application.
  *  ============================================================================
  */
-#define NUM_ARGS 3
+#define NUM_ARGS 8
+
+/*  ============================================================================
+ *  @name   MAX_ARG_LENGTH
+ *
+ *  @desc   Room for a number given to the DSP application as an argument.
+ *  ============================================================================
+ */
+#define MAX_ARG_LENGTH 12
 
 /*  ============================================================================
  *  @name   XFER_CHAR
@@ -80,7 +95,10 @@ extern "C" {
 /** ============================================================================
  *  @name   NUMBUFS
  *
- *  @desc   Number of buffers in pool.
+ *  @desc   Number of buffers in pool for a single buffered transfer. Every
+ *          extra stage of the GPP pipeline adds one buffer to the pool, and
+ *          every extra DSP buffer adds two (the SWI mode keeps an input and
+ *          an output ring).
  *  ============================================================================
  */
 #define NUMBUFS 4
@@ -101,6 +119,16 @@ extern "C" {
  */
 STATIC Uint32 RGB2YCBCR_DSP_BufferSize;
 
+/*  ============================================================================
+ *  @name   RGB2YCBCR_DSP_ChunkSize
+ *
+ *  @desc   Number of bytes of data a chunk carries, as given by the caller.
+ *          RGB2YCBCR_DSP_BufferSize is this rounded up to the buffer
+ *          alignment. Only the last chunk of the data may carry less.
+ *  ============================================================================
+ */
+STATIC Uint32 RGB2YCBCR_DSP_ChunkSize;
+
 /*  ============================================================================
  *  @name   RGB2YCBCR_DSP_NumIterations
  *
@@ -109,41 +137,481 @@ STATIC Uint32 RGB2YCBCR_DSP_BufferSize;
  */
 STATIC Uint32 RGB2YCBCR_DSP_NumIterations;
 
+/*  ============================================================================
+ *  @name   RGB2YCBCR_DSP_NumDspBuffers
+ *
+ *  @desc   Number of buffers the DSP streams through, given to the DSP
+ *          executable on load.
+ *  ============================================================================
+ */
+STATIC Uint32 RGB2YCBCR_DSP_NumDspBuffers;
+
+/*  ============================================================================
+ *  @name   RGB2YCBCR_DSP_NumBuffers
+ *
+ *  @desc   Depth of the transfer pipeline, this is the number of channel
+ *          buffers kept in flight between GPP and DSP.
+ *  ============================================================================
+ */
+STATIC Uint32 RGB2YCBCR_DSP_NumBuffers;
+
+/*  ============================================================================
+ *  @name   RGB2YCBCR_DSP_NumFrameBuffers
+ *
+ *  @desc   Number of channel buffers holding a whole frame when the frame is
+ *          converted in place. Zero when the frame is copied through the
+ *          pipeline buffers.
+ *  ============================================================================
+ */
+STATIC Uint32 RGB2YCBCR_DSP_NumFrameBuffers = 0;
+
 /** ============================================================================
- *  @name   RGB2YCBCR_DSP_Buffers
+ *  @name   RGB2YCBCR_DSP_Queue
  *
- *  @desc   Array of buffers used by the rgb2ycbcr-dsp application.
- *          Length of array in this application is 1.
+ *  @desc   Chunks of a frame handed out to several engines, the next one to
+ *          whichever engine asks first.
+ *
+ *  @field  mutex
+ *              Protects next.
+ *  @field  next
+ *              Index of the next chunk to hand out.
+ *  @field  numChunks
+ *              Number of chunks in the frame.
  *  ============================================================================
  */
-STATIC Char8 * RGB2YCBCR_DSP_Buffers[1];
+typedef struct RGB2YCBCR_DSP_Queue_tag {
+   Pvoid  mutex;
+   Uint32 next;
+   Uint32 numChunks;
+} RGB2YCBCR_DSP_Queue;
 
 /** ============================================================================
- *  @name   RGB2YCBCR_DSP_IOReq
+ *  @name   RGB2YCBCR_DSP_Context
+ *
+ *  @desc   State of the transfers with one processor. Every processor has
+ *          its own channel pair and pool, so several can be driven at once.
  *
- *  @desc   It gives information for adding or reclaiming a request.
+ *  @field  buffers
+ *              Channel buffers of the pipeline. Only the first
+ *              RGB2YCBCR_DSP_NumBuffers entries are valid.
+ *  @field  ioReq
+ *              It gives information for adding or reclaiming a request.
+ *  @field  started
+ *              Tells whether the DSP is running. A session starts it once
+ *              for all the conversions, the other entry points on their
+ *              execute phase.
+ *  @field  timed
+ *              Tells whether the chunks are timed by the stats module, which
+ *              only follows one processor at a time.
+ *  @field  stream
+ *              Data stream RGB2YCBCR_DSP_Execute () copies chunks from and
+ *              to.
+ *  @field  processorId
+ *              Id of the processor.
+ *  @field  firstChunk, numChunks
+ *              Chunks of the data the processor converts, the whole data
+ *              unless a frame is shared between processors.
+ *  @field  nextChunk
+ *              Next chunk of firstChunk to numChunks to send.
+ *  @field  queue
+ *              When not NULL, the chunks are taken from this queue instead
+ *              of firstChunk to numChunks.
+ *  @field  kernel
+ *              GPP kernel converting the chunks of a GPP engine.
+ *  @field  dataSize
+ *              Size of the whole data.
+ *  @field  status
+ *              Outcome of the share of the frame.
+ *  @field  elapsed
+ *              Time the share of the frame took, in seconds.
+ *  @field  doneChunks, doneBytes
+ *              Number of chunks and bytes converted by the engine.
  *  ============================================================================
  */
-STATIC ChannelIOInfo RGB2YCBCR_DSP_IOReq;
+typedef struct RGB2YCBCR_DSP_Context_tag {
+   Char8 *                buffers [MAX_PIPELINE_DEPTH];
+   ChannelIOInfo          ioReq;
+   Bool                   started;
+   Bool                   timed;
+   Char8 *                stream;
+   Uint8                  processorId;
+   Uint32                 firstChunk;
+   Uint32                 numChunks;
+   Uint32                 nextChunk;
+   RGB2YCBCR_DSP_Queue *  queue;
+   RGB2YCBCR_DSP_Kernel * kernel;
+   Uint32                 dataSize;
+   DSP_STATUS             status;
+   Real64                 elapsed;
+   Uint32                 doneChunks;
+   Uint32                 doneBytes;
+} RGB2YCBCR_DSP_Context;
 
 /** ============================================================================
- *  @func   RGB2YCBCR_DSP_Create
+ *  @name   RGB2YCBCR_DSP_Contexts
  *
- *  @desc   This function allocates and initializes resources used by
- *          this application.
+ *  @desc   Transfer state of every processor, indexed by processor id.
+ *  ============================================================================
+ */
+STATIC RGB2YCBCR_DSP_Context RGB2YCBCR_DSP_Contexts [MAX_PROCESSORS];
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_Format
  *
- *  @modif  RGB2YCBCR_DSP_Buffers
+ *  @desc   Layout the DSP writes converted chunks in, one of
+ *          RGB2YCBCR_DSP_FORMAT_XXX.
  *  ============================================================================
  */
-NORMAL_API DSP_STATUS RGB2YCBCR_DSP_Create (
+STATIC Uint32 RGB2YCBCR_DSP_Format = RGB2YCBCR_DSP_FORMAT_PACKED;
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_Direction
+ *
+ *  @desc   Direction the DSP converts in, one of RGB2YCBCR_DSP_DIR_XXX.
+ *  ============================================================================
+ */
+STATIC Uint32 RGB2YCBCR_DSP_Direction = RGB2YCBCR_DSP_DIR_FORWARD;
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_Planes
+ *
+ *  @desc   Frame RGB2YCBCR_DSP_Execute () places the planes of each chunk
+ *          in when the format is planar.
+ *  ============================================================================
+ */
+STATIC Char8 * RGB2YCBCR_DSP_Planes = NULL;
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_NumPixels
+ *
+ *  @desc   Number of pixels of the frame being converted.
+ *  ============================================================================
+ */
+STATIC Uint32 RGB2YCBCR_DSP_NumPixels;
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_StrFormat, RGB2YCBCR_DSP_StrWidth,
+ *          RGB2YCBCR_DSP_StrFilter, RGB2YCBCR_DSP_StrColor,
+ *          RGB2YCBCR_DSP_StrDirection
+ *
+ *  @desc   Format, width, chroma filter, colorimetry and direction given to
+ *          the DSP executable on load.
+ *  ============================================================================
+ */
+STATIC Char8 RGB2YCBCR_DSP_StrFormat [MAX_ARG_LENGTH] = "0";
+STATIC Char8 RGB2YCBCR_DSP_StrWidth [MAX_ARG_LENGTH]  = "0";
+STATIC Char8 RGB2YCBCR_DSP_StrFilter [MAX_ARG_LENGTH] = "0";
+STATIC Char8 RGB2YCBCR_DSP_StrColor [MAX_ARG_LENGTH]  = "0";
+STATIC Char8 RGB2YCBCR_DSP_StrDirection [MAX_ARG_LENGTH] = "0";
+
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_PayloadSize
+ *
+ *  @desc   Number of bytes chunk index carries out of dataSize bytes. Every
+ *          chunk is full but the last one, which is sent short rather than
+ *          padded to the buffer size.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Uint32 RGB2YCBCR_DSP_PayloadSize(
+   IN Uint32 dataSize,
+   IN Uint32 index)
+{
+   Uint32 offset = RGB2YCBCR_DSP_ChunkSize * index;
+
+   if (offset >= dataSize) {
+      return 0;
+   }
+
+   return ((dataSize - offset) < RGB2YCBCR_DSP_ChunkSize) ? (dataSize - offset)
+                                                          : RGB2YCBCR_DSP_ChunkSize;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_ReturnSize
+ *
+ *  @desc   Number of bytes the DSP sends back for a chunk carrying
+ *          payloadSize bytes, the size of its planes in the output format.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Uint32 RGB2YCBCR_DSP_ReturnSize(
+   IN Uint32 payloadSize)
+{
+   Uint32 sizes [RGB2YCBCR_DSP_MAX_PLANES];
+   Uint32 numPlanes;
+   Uint32 returnSize = 0;
+
+   if (RGB2YCBCR_DSP_Format == RGB2YCBCR_DSP_FORMAT_PACKED) {
+      return payloadSize;
+   }
+
+   numPlanes = RGB2YCBCR_DSP_PlaneSizes(RGB2YCBCR_DSP_Format, payloadSize / 3, sizes);
+   while (numPlanes > 0) {
+      returnSize += sizes [--numPlanes];
+   }
+
+   return returnSize;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_CopyIn
+ *
+ *  @desc   Fills a channel buffer with a chunk of the stream of the
+ *          context arg points to. Only the size bytes of the chunk are read.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC DSP_STATUS RGB2YCBCR_DSP_CopyIn(
+   IN Pvoid    arg,
+   IN Char8  * buffer,
+   IN Uint32   index,
+   IN Uint32   size)
+{
+   Uint32  j;
+   Uint32  offsetData = RGB2YCBCR_DSP_ChunkSize * index;
+   Char8 * temp       = buffer;
+   Char8 * stream     = ((RGB2YCBCR_DSP_Context *) arg)->stream;
+
+   for (j = 0 ; j < size ; j++) {
+      *temp++ = (stream[j + offsetData]);
+   }
+
+   return DSP_SOK;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_CopyOut
+ *
+ *  @desc   Puts a processed chunk back on the stream of the context arg
+ *          points to.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC DSP_STATUS RGB2YCBCR_DSP_CopyOut(
+   IN Pvoid    arg,
+   IN Char8  * buffer,
+   IN Uint32   index,
+   IN Uint32   size)
+{
+   Uint32  j;
+   Uint32  offsetData = RGB2YCBCR_DSP_ChunkSize * index;
+   Char8 * temp       = buffer;
+   Char8 * stream     = ((RGB2YCBCR_DSP_Context *) arg)->stream;
+
+   for (j = 0 ; j < size ; j++) {
+      (stream[j + offsetData]) = *temp++;
+   }
+
+   return DSP_SOK;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_CopyOutPlanes
+ *
+ *  @desc   Places each plane of a processed chunk in the matching plane of
+ *          RGB2YCBCR_DSP_Planes. The planes of the chunks before it take
+ *          the start of every frame plane. size is the payload the chunk
+ *          was sent with, the buffer only holds its planes.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC DSP_STATUS RGB2YCBCR_DSP_CopyOutPlanes(
+   IN Pvoid    arg,
+   IN Char8  * buffer,
+   IN Uint32   index,
+   IN Uint32   size)
+{
+   Uint32  frameSizes [RGB2YCBCR_DSP_MAX_PLANES];
+   Uint32  offsets [RGB2YCBCR_DSP_MAX_PLANES];
+   Uint32  sizes [RGB2YCBCR_DSP_MAX_PLANES];
+   Uint32  numPlanes;
+   Uint32  plane;
+   Char8 * framePlane = RGB2YCBCR_DSP_Planes;
+
+   numPlanes = RGB2YCBCR_DSP_PlaneSizes(RGB2YCBCR_DSP_Format,
+                                        RGB2YCBCR_DSP_NumPixels,
+                                        frameSizes);
+   RGB2YCBCR_DSP_PlaneSizes(RGB2YCBCR_DSP_Format,
+                            (RGB2YCBCR_DSP_ChunkSize * index) / 3,
+                            offsets);
+   RGB2YCBCR_DSP_PlaneSizes(RGB2YCBCR_DSP_Format, size / 3, sizes);
+
+   for (plane = 0 ; plane < numPlanes ; plane++) {
+      memcpy(framePlane + offsets [plane], buffer, sizes [plane]);
+      buffer     += sizes [plane];
+      framePlane += frameSizes [plane];
+   }
+
+   return DSP_SOK;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_Start
+ *
+ *  @desc   Starts execution on the DSP unless it is already running.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC DSP_STATUS RGB2YCBCR_DSP_Start(
+   IN Uint8 processorId)
+{
+   DSP_STATUS              status = DSP_SOK;
+   RGB2YCBCR_DSP_Context * ctx    = &RGB2YCBCR_DSP_Contexts [processorId];
+
+   if (!ctx->started) {
+      status = PROC_start(processorId);
+      if (DSP_FAILED (status)) {
+         RGB2YCBCR_DSP_1Print("PROC_start failed. Status = [0x%x]\n", status);
+      }
+      else {
+         ctx->started = TRUE;
+      }
+   }
+
+   return status;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_SetFormat
+ *
+ *  @desc   Checks the format against the frame dimensions and keeps it for
+ *          the next create and execute phases.
+ *
+ *  @modif  RGB2YCBCR_DSP_Format, RGB2YCBCR_DSP_Planes,
+ *          RGB2YCBCR_DSP_StrFormat, RGB2YCBCR_DSP_StrWidth,
+ *          RGB2YCBCR_DSP_StrFilter
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_SetFormat(
+   IN Uint32   format,
+   IN Uint32   filter,
+   IN Uint32   width,
+   IN Uint32   height,
+   IN Char8  * output)
+{
+   if (format > RGB2YCBCR_DSP_FORMAT_I422) {
+      RGB2YCBCR_DSP_1Print("==Error: Invalid output format %d ==\n", format);
+      return DSP_EINVALIDARG;
+   }
+
+   if (filter > RGB2YCBCR_DSP_FILTER_BOX) {
+      RGB2YCBCR_DSP_1Print("==Error: Invalid chroma filter %d ==\n", filter);
+      return DSP_EINVALIDARG;
+   }
+
+   /* The DSP keeps the width in 16 bits */
+   if (width > 0xFFFF) {
+      RGB2YCBCR_DSP_1Print("==Error: Frame too wide for the DSP %d ==\n", width);
+      return DSP_EINVALIDARG;
+   }
+
+   if (   ((format == RGB2YCBCR_DSP_FORMAT_I420) || (format == RGB2YCBCR_DSP_FORMAT_NV12))
+       && (((width % 2) != 0) || ((height % 2) != 0))) {
+      RGB2YCBCR_DSP_0Print("==Error: Subsampled formats need even dimensions ==\n");
+      return DSP_EINVALIDARG;
+   }
+
+   if ((format == RGB2YCBCR_DSP_FORMAT_I422) && ((width % 2) != 0)) {
+      RGB2YCBCR_DSP_0Print("==Error: I422 needs an even width ==\n");
+      return DSP_EINVALIDARG;
+   }
+
+   if ((format != RGB2YCBCR_DSP_FORMAT_PACKED) && (output == NULL)) {
+      RGB2YCBCR_DSP_0Print("==Error: No frame for the planes ==\n");
+      return DSP_EINVALIDARG;
+   }
+
+   if (   (format != RGB2YCBCR_DSP_FORMAT_PACKED)
+       && (RGB2YCBCR_DSP_Direction == RGB2YCBCR_DSP_DIR_INVERSE)) {
+      RGB2YCBCR_DSP_0Print("==Error: The inverse writes packed pixels only ==\n");
+      return DSP_EINVALIDARG;
+   }
+
+   RGB2YCBCR_DSP_Format = format;
+   RGB2YCBCR_DSP_Planes = output;
+   sprintf(RGB2YCBCR_DSP_StrFormat, "%u", (unsigned) format);
+   sprintf(RGB2YCBCR_DSP_StrWidth, "%u", (unsigned) width);
+   sprintf(RGB2YCBCR_DSP_StrFilter, "%u", (unsigned) filter);
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_SetColorimetry
+ *
+ *  @desc   Selects the matrix of the GPP kernels and keeps it for the DSP.
+ *
+ *  @modif  RGB2YCBCR_DSP_StrColor
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_SetColorimetry(
+   IN Uint32   colorimetry)
+{
+   if (DSP_FAILED (RGB2YCBCR_DSP_SelectMatrix(colorimetry))) {
+      RGB2YCBCR_DSP_1Print("==Error: Colorimetry %d not built in ==\n", colorimetry);
+      return DSP_EINVALIDARG;
+   }
+
+   sprintf(RGB2YCBCR_DSP_StrColor, "%u", (unsigned) colorimetry);
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_SetDirection
+ *
+ *  @desc   Checks the direction against the format and keeps it for the
+ *          DSP.
+ *
+ *  @modif  RGB2YCBCR_DSP_Direction, RGB2YCBCR_DSP_StrDirection
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_SetDirection(
+   IN Uint32   direction)
+{
+   if (direction > RGB2YCBCR_DSP_DIR_INVERSE) {
+      RGB2YCBCR_DSP_1Print("==Error: Invalid direction %d ==\n", direction);
+      return DSP_EINVALIDARG;
+   }
+
+   if (   (direction == RGB2YCBCR_DSP_DIR_INVERSE)
+       && (RGB2YCBCR_DSP_Format != RGB2YCBCR_DSP_FORMAT_PACKED)) {
+      RGB2YCBCR_DSP_0Print("==Error: The inverse writes packed pixels only ==\n");
+      return DSP_EINVALIDARG;
+   }
+
+   RGB2YCBCR_DSP_Direction = direction;
+   sprintf(RGB2YCBCR_DSP_StrDirection, "%u", (unsigned) direction);
+
+   return DSP_SOK;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_CreateProcessor
+ *
+ *  @desc   Attaches a processor, opens its pool, loads the executable on
+ *          it, creates its channel pair and allocates its pipeline buffers.
+ *          PROC_setup () must have been called.
+ *
+ *  @modif  RGB2YCBCR_DSP_Contexts
+ *  ----------------------------------------------------------------------------
+ */
+STATIC DSP_STATUS RGB2YCBCR_DSP_CreateProcessor(
    IN Char8  * dspExecutable,
    IN Char8  * strBufferSize,
    IN Char8  * strNumIterations,
+   IN Char8  * strNumDspBuffers,
    IN Uint8    processorId)
 {
    DSP_STATUS status                    = DSP_SOK;
    Uint32     numArgs                   = 0;
-   Uint32     numBufs [NUMBUFFERPOOLS]  = {NUMBUFS};
+   Uint32     numBufs [NUMBUFFERPOOLS]  = {0};
 
    ChannelAttrs chnlAttrInput;
    ChannelAttrs chnlAttrOutput;
@@ -153,24 +621,16 @@ NORMAL_API DSP_STATUS RGB2YCBCR_DSP_Create (
    SMAPOOL_Attrs poolAttrs;
 #endif /* if defined (ZCPY_LINK) */
 
-   RGB2YCBCR_DSP_0Print("Entered RGB2YCBCR_DSP_Create ()\n");
-
-   /*
-    *  Create and initialize the proc object.
-    */
-   status = PROC_setup (NULL);
+   RGB2YCBCR_DSP_Contexts [processorId].processorId = processorId;
+   RGB2YCBCR_DSP_Contexts [processorId].started     = FALSE;
+   RGB2YCBCR_DSP_Contexts [processorId].timed       = TRUE;
 
    /*
     *  Attach the Dsp with which the transfers have to be done.
     */
-   if (DSP_SUCCEEDED (status)) {
-      status = PROC_attach (processorId, NULL);
-      if (DSP_FAILED (status)) {
-         RGB2YCBCR_DSP_1Print ("PROC_attach failed . Status = [0x%x]\n", status) ;
-      }
-   }
-   else {
-      RGB2YCBCR_DSP_1Print ("PROC_setup failed. Status =  [0x%x]\n", status);
+   status = PROC_attach (processorId, NULL);
+   if (DSP_FAILED (status)) {
+      RGB2YCBCR_DSP_1Print ("PROC_attach failed . Status = [0x%x]\n", status) ;
    }
 
    /*
@@ -178,6 +638,14 @@ NORMAL_API DSP_STATUS RGB2YCBCR_DSP_Create (
     */
    if (DSP_SUCCEEDED (status)) {
       size [0]              = RGB2YCBCR_DSP_BufferSize;
+      numBufs [0]           = NUMBUFS
+                              + (RGB2YCBCR_DSP_NumBuffers - 1)
+                              + RGB2YCBCR_DSP_NumFrameBuffers
+                              + (2 * (RGB2YCBCR_DSP_NumDspBuffers - 1));
+      /* The DSP task writes the planes of a chunk to a buffer of its own */
+      if (RGB2YCBCR_DSP_Format != RGB2YCBCR_DSP_FORMAT_PACKED) {
+         numBufs [0]++;
+      }
       poolAttrs.bufSizes    = (Uint32 *) &size;
       poolAttrs.numBuffers  = (Uint32 *) &numBufs;
       poolAttrs.numBufPools = NUMBUFFERPOOLS;
@@ -198,6 +666,12 @@ NORMAL_API DSP_STATUS RGB2YCBCR_DSP_Create (
       numArgs = NUM_ARGS;
       args[0] = strBufferSize;
       args[1] = strNumIterations;
+      args[2] = strNumDspBuffers;
+      args[3] = RGB2YCBCR_DSP_StrFormat;
+      args[4] = RGB2YCBCR_DSP_StrWidth;
+      args[5] = RGB2YCBCR_DSP_StrFilter;
+      args[6] = RGB2YCBCR_DSP_StrColor;
+      args[7] = RGB2YCBCR_DSP_StrDirection;
 
       status = PROC_load (processorId, dspExecutable, numArgs, args);
 
@@ -240,9 +714,9 @@ NORMAL_API DSP_STATUS RGB2YCBCR_DSP_Create (
    if (DSP_SUCCEEDED (status)) {
       status = CHNL_allocateBuffer (processorId,
                                     CHNL_ID_OUTPUT,
-                                    RGB2YCBCR_DSP_Buffers,
+                                    RGB2YCBCR_DSP_Contexts [processorId].buffers,
                                     RGB2YCBCR_DSP_BufferSize,
-                                    1);
+                                    RGB2YCBCR_DSP_NumBuffers);
       if (DSP_FAILED (status)) {
          RGB2YCBCR_DSP_1Print ("CHNL_allocateBuffer failed (output)."
                                "Status = [0x%x]\n",
@@ -254,95 +728,215 @@ NORMAL_API DSP_STATUS RGB2YCBCR_DSP_Create (
     *  Initialize the buffer with valid data is now perform on execute phase.
     */
 
-   RGB2YCBCR_DSP_0Print ("Leaving RGB2YCBCR_DSP_Create ()\n") ;
-
    return status ;
 }
 
 
 /** ============================================================================
- *  @func   RGB2YCBCR_DSP_Execute
+ *  @func   RGB2YCBCR_DSP_Create
  *
- *  @desc   This function implements the execute phase for this application.
+ *  @desc   This function allocates and initializes resources used by
+ *          this application.
  *
- *  @modif  None
+ *  @modif  RGB2YCBCR_DSP_Contexts
  *  ============================================================================
  */
-NORMAL_API DSP_STATUS RGB2YCBCR_DSP_Execute(
-   IN Uint32 numIterations,
-   IN Char8  * dataStream,
-   IN Uint32 bufferSize,
-   Uint8     processorId)
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_Create (
+   IN Char8  * dspExecutable,
+   IN Char8  * strBufferSize,
+   IN Char8  * strNumIterations,
+   IN Char8  * strNumDspBuffers,
+   IN Uint8    processorId)
 {
    DSP_STATUS status = DSP_SOK;
-   Uint32     i;
-   Uint32     j;
-   Uint32     offsetData;
-   Char8 *    temp = NULL;
 
-   RGB2YCBCR_DSP_0Print ("Entered RGB2YCBCR_DSP_Execute ()\n") ;
+   RGB2YCBCR_DSP_0Print("Entered RGB2YCBCR_DSP_Create ()\n");
 
    /*
-    *  Start execution on DSP.
+    *  Create and initialize the proc object.
     */
-   status = PROC_start(processorId);
+   status = PROC_setup (NULL);
 
-   /*
-    *  Fill the IO Request structure
-    *  It gives Information for adding or reclaiming an input request.
-    */
    if (DSP_SUCCEEDED (status)) {
-      RGB2YCBCR_DSP_IOReq.buffer = RGB2YCBCR_DSP_Buffers [0];
-      RGB2YCBCR_DSP_IOReq.size   = RGB2YCBCR_DSP_BufferSize;
+      status = RGB2YCBCR_DSP_CreateProcessor(dspExecutable,
+                                             strBufferSize,
+                                             strNumIterations,
+                                             strNumDspBuffers,
+                                             processorId);
    }
    else {
-      RGB2YCBCR_DSP_1Print("PROC_start failed. Status = [0x%x]\n", status);
+      RGB2YCBCR_DSP_1Print ("PROC_setup failed. Status =  [0x%x]\n", status);
    }
 
-   for (i = 1;
-        ((RGB2YCBCR_DSP_NumIterations == 0) || (i <= RGB2YCBCR_DSP_NumIterations))
-         && (DSP_SUCCEEDED (status)); i++) {
+   RGB2YCBCR_DSP_0Print ("Leaving RGB2YCBCR_DSP_Create ()\n") ;
 
-      /* Calculate offset */
-      offsetData = bufferSize * (i - 1);
+   return status ;
+}
 
-      /* Pointer to the Buffer beggining */
-      temp = RGB2YCBCR_DSP_Buffers[0];
 
-      /* Fill buffer with valid data */
-      for (j = 0 ; j < bufferSize ; j++) {
-         *temp++ = (dataStream[j + offsetData]);
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_Record
+ *
+ *  @desc   Records a phase with the stats module if the context is timed.
+ *          Returns the current time either way.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Real64 RGB2YCBCR_DSP_Record(
+   IN RGB2YCBCR_DSP_Context * ctx,
+   IN RGB2YCBCR_DSP_Phase     phase,
+   IN Real64                  start)
+{
+   if (!ctx->timed) {
+      return RGB2YCBCR_DSP_GetTime();
+   }
+
+   return RGB2YCBCR_DSP_StatsRecord(phase, start);
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_NextChunk
+ *
+ *  @desc   Takes the next chunk an engine converts, from the queue of the
+ *          context if it has one. Returns FALSE when there is none left.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Bool RGB2YCBCR_DSP_NextChunk(
+   IN  RGB2YCBCR_DSP_Context * ctx,
+   OUT Uint32 *                index)
+{
+   Bool found = FALSE;
+
+   if (ctx->queue != NULL) {
+      RGB2YCBCR_DSP_MutexLock(ctx->queue->mutex);
+      if (ctx->queue->next < ctx->queue->numChunks) {
+         *index = ctx->queue->next++;
+         found  = TRUE;
       }
+      RGB2YCBCR_DSP_MutexUnlock(ctx->queue->mutex);
+   }
+   else if (ctx->nextChunk < (ctx->firstChunk + ctx->numChunks)) {
+      *index = ctx->nextChunk++;
+      found  = TRUE;
+   }
+
+   return found;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_Pipeline
+ *
+ *  @desc   Streams the chunks of a context through its processor, the
+ *          chunks firstChunk to numChunks or those taken from its queue.
+ *          Up to RGB2YCBCR_DSP_NumBuffers chunks are kept in flight, so the
+ *          GPP fills the next buffer and empties the previous one while the
+ *          DSP converts the current one. Chunks come back from the DSP in
+ *          the same order they were sent. A chunk is only taken when a
+ *          buffer is free for it, so a queue hands the DSP no more than it
+ *          can keep busy with. Each chunk is sent with the size of the data
+ *          it carries, so the last one goes short and the DSP converts no
+ *          padding. The fill and drain functions are given the index of a
+ *          chunk in the whole data. When the context is timed, every step
+ *          of a chunk is timed and the summary is printed when the run
+ *          ends.
+ *
+ *  @modif  ctx
+ *  ----------------------------------------------------------------------------
+ */
+STATIC DSP_STATUS RGB2YCBCR_DSP_Pipeline(
+   IN RGB2YCBCR_DSP_Context * ctx,
+   IN RGB2YCBCR_DSP_ChunkFxn  fillFxn,
+   IN RGB2YCBCR_DSP_ChunkFxn  drainFxn,
+   IN Pvoid                   arg)
+{
+   DSP_STATUS status      = DSP_SOK;
+   Uint8      processorId = ctx->processorId;
+   Uint32     dataSize    = ctx->dataSize;
+   Uint32     issued      = 0;
+   Uint32     posted      = 0;
+   Uint32     completed   = 0;
+   Uint32     numBytes    = 0;
+   Bool       more        = TRUE;
+   Uint32     chunk [MAX_PIPELINE_DEPTH];
+   Real64     issueTime [MAX_PIPELINE_DEPTH];
+   Real64     start;
+
+   ctx->nextChunk = ctx->firstChunk;
+
+   /*
+    *  Start execution on DSP.
+    */
+   status = RGB2YCBCR_DSP_Start(processorId);
+   if (DSP_SUCCEEDED (status) && ctx->timed) {
+      RGB2YCBCR_DSP_StatsStart((ctx->queue != NULL) ? ctx->queue->numChunks
+                                                    : ctx->numChunks);
+   }
+
+   /*
+    *  Prime the pipeline: fill every buffer with a chunk and send it to
+    *  the DSP straight away.
+    */
+   while ((issued < RGB2YCBCR_DSP_NumBuffers) && (DSP_SUCCEEDED (status))
+          && (more = RGB2YCBCR_DSP_NextChunk(ctx, &chunk [issued % MAX_PIPELINE_DEPTH]))) {
+      /* Fill buffer with valid data */
+      start  = RGB2YCBCR_DSP_GetTime();
+      status = fillFxn(arg, ctx->buffers [issued], chunk [issued % MAX_PIPELINE_DEPTH],
+                       RGB2YCBCR_DSP_PayloadSize(dataSize, chunk [issued % MAX_PIPELINE_DEPTH]));
+      start  = RGB2YCBCR_DSP_Record(ctx, RGB2YCBCR_DSP_Phase_CopyIn, start);
 
-      /* Start counting time from here */
       /*
        *  Send data to DSP.
        *  Issue 'filled' buffer to the channel.
        */
-      status = CHNL_issue(processorId, CHNL_ID_OUTPUT, &RGB2YCBCR_DSP_IOReq);
-      if (DSP_FAILED (status)) {
-         RGB2YCBCR_DSP_1Print("CHNL_issue failed (output). Status = [0x%x]\n", status);
-      }
-
-      /*
-       *  Reclaim 'empty' buffer from the channel
-       */
       if (DSP_SUCCEEDED (status)) {
-         status = CHNL_reclaim (processorId, CHNL_ID_OUTPUT, WAIT_FOREVER, &RGB2YCBCR_DSP_IOReq);
-
+         ctx->ioReq.buffer = ctx->buffers [issued];
+         ctx->ioReq.size   = RGB2YCBCR_DSP_PayloadSize(dataSize, chunk [issued % MAX_PIPELINE_DEPTH]);
+         ctx->ioReq.arg    = RGB2YCBCR_DSP_ARG_DATA;
+         issueTime [issued % MAX_PIPELINE_DEPTH] = start;
+         status = CHNL_issue(processorId, CHNL_ID_OUTPUT, &ctx->ioReq);
+         RGB2YCBCR_DSP_Record(ctx, RGB2YCBCR_DSP_Phase_Issue, start);
          if (DSP_FAILED (status)) {
-            RGB2YCBCR_DSP_1Print ("CHNL_reclaim failed (output). Status = [0x%x]\n", status);
+            RGB2YCBCR_DSP_1Print("CHNL_issue failed (output). Status = [0x%x]\n", status);
+         }
+         else {
+            issued++;
          }
       }
+   }
 
+   while ((completed < issued) && (DSP_SUCCEEDED (status))) {
       /*
-       *  Receive data from DSP
-       *  Issue 'empty' buffer to the channel.
+       *  Hand the buffers the DSP has already taken back to the channel
+       *  as receive buffers. The chunk we are about to wait for must have
+       *  one, and posting one more lets the DSP return the next chunk
+       *  without waiting on the GPP.
        */
-      if (DSP_SUCCEEDED (status)) {
-         status = CHNL_issue (processorId, CHNL_ID_INPUT, &RGB2YCBCR_DSP_IOReq) ;
+      while ((posted < issued) && (posted <= (completed + 1))
+             && (DSP_SUCCEEDED (status))) {
+         /*
+          *  Reclaim 'empty' buffer from the channel
+          */
+         start  = RGB2YCBCR_DSP_GetTime();
+         status = CHNL_reclaim (processorId, CHNL_ID_OUTPUT, WAIT_FOREVER, &ctx->ioReq);
          if (DSP_FAILED (status)) {
-            RGB2YCBCR_DSP_1Print ("CHNL_issue failed (input). Status = [0x%x]\n", status);
+            RGB2YCBCR_DSP_1Print ("CHNL_reclaim failed (output). Status = [0x%x]\n", status);
+         }
+
+         /*
+          *  Receive data from DSP
+          *  Issue 'empty' buffer to the channel.
+          */
+         if (DSP_SUCCEEDED (status)) {
+            ctx->ioReq.size = RGB2YCBCR_DSP_BufferSize;
+            status = CHNL_issue (processorId, CHNL_ID_INPUT, &ctx->ioReq) ;
+            RGB2YCBCR_DSP_Record(ctx, RGB2YCBCR_DSP_Phase_Issue, start);
+            if (DSP_FAILED (status)) {
+               RGB2YCBCR_DSP_1Print ("CHNL_issue failed (input). Status = [0x%x]\n", status);
+            }
+            else {
+               posted++;
+            }
          }
       }
 
@@ -350,62 +944,341 @@ NORMAL_API DSP_STATUS RGB2YCBCR_DSP_Execute(
        *  Reclaim 'filled' buffer from the channel
        */
       if (DSP_SUCCEEDED (status)) {
-         status = CHNL_reclaim (processorId, CHNL_ID_INPUT, WAIT_FOREVER, &RGB2YCBCR_DSP_IOReq);
+         status = CHNL_reclaim (processorId, CHNL_ID_INPUT, WAIT_FOREVER, &ctx->ioReq);
          if (DSP_FAILED (status)) {
             RGB2YCBCR_DSP_1Print ("CHNL_reclaim failed (input). Status = [0x%x]\n", status) ;
          }
       }
 
-      /* Stop counting time */
-
-      /* We have transfered all data and got it back */
-      if (DSP_SUCCEEDED (status)) {
-         // Print execution time
-      }
-      else {
+      if (DSP_FAILED (status)) {
          // We fail
          break;
       }
 
-      /* Pointer to the Buffer beggining */
-      temp = RGB2YCBCR_DSP_Buffers[0];
-      /* Put proccesed data back on the data stream */
-      offsetData = bufferSize * (i - 1);
-      for (j = 0 ; j < bufferSize ; j++) {
-         (dataStream[j + offsetData]) = *temp++;
+      /* The chunk has been through the link and the DSP and back */
+      start = RGB2YCBCR_DSP_Record(ctx, RGB2YCBCR_DSP_Phase_RoundTrip,
+                                   issueTime [completed % MAX_PIPELINE_DEPTH]);
+
+      /* A planar chunk comes back with only the bytes of its planes */
+      if (ctx->ioReq.size != RGB2YCBCR_DSP_ReturnSize(RGB2YCBCR_DSP_PayloadSize(dataSize, chunk [completed % MAX_PIPELINE_DEPTH]))) {
+         RGB2YCBCR_DSP_1Print("Chunk returned with %d bytes\n", ctx->ioReq.size);
+         status = DSP_EFAIL;
+         break;
+      }
+
+      /* The link may hand back a different buffer than the one we issued */
+      ctx->buffers [completed % RGB2YCBCR_DSP_NumBuffers] = ctx->ioReq.buffer;
+
+      /* Hand the processed chunk to the consumer */
+      status = drainFxn(arg, ctx->ioReq.buffer, chunk [completed % MAX_PIPELINE_DEPTH],
+                        RGB2YCBCR_DSP_PayloadSize(dataSize, chunk [completed % MAX_PIPELINE_DEPTH]));
+      start  = RGB2YCBCR_DSP_Record(ctx, RGB2YCBCR_DSP_Phase_CopyOut, start);
+      numBytes += RGB2YCBCR_DSP_PayloadSize(dataSize, chunk [completed % MAX_PIPELINE_DEPTH]);
+      completed++;
+
+      /* Refill the buffer we just emptied with the next chunk */
+      if (more && (DSP_SUCCEEDED (status))) {
+         more = RGB2YCBCR_DSP_NextChunk(ctx, &chunk [issued % MAX_PIPELINE_DEPTH]);
+      }
+
+      if (more && (DSP_SUCCEEDED (status))) {
+         status = fillFxn(arg, ctx->ioReq.buffer, chunk [issued % MAX_PIPELINE_DEPTH],
+                          RGB2YCBCR_DSP_PayloadSize(dataSize, chunk [issued % MAX_PIPELINE_DEPTH]));
+         start  = RGB2YCBCR_DSP_Record(ctx, RGB2YCBCR_DSP_Phase_CopyIn, start);
+      }
+
+      if (more && (DSP_SUCCEEDED (status))) {
+         ctx->ioReq.size = RGB2YCBCR_DSP_PayloadSize(dataSize, chunk [issued % MAX_PIPELINE_DEPTH]);
+         ctx->ioReq.arg  = RGB2YCBCR_DSP_ARG_DATA;
+         issueTime [issued % MAX_PIPELINE_DEPTH] = start;
+         status = CHNL_issue(processorId, CHNL_ID_OUTPUT, &ctx->ioReq);
+         RGB2YCBCR_DSP_Record(ctx, RGB2YCBCR_DSP_Phase_Issue, start);
+         if (DSP_FAILED (status)) {
+            RGB2YCBCR_DSP_1Print("CHNL_issue failed (output). Status = [0x%x]\n", status);
+         }
+         else {
+            issued++;
+         }
       }
    }
 
-   RGB2YCBCR_DSP_0Print ("Leaving RGB2YCBCR_DSP_Execute ()\n") ;
+   ctx->doneChunks = completed;
+   ctx->doneBytes  = numBytes;
+
+   if (ctx->timed) {
+      RGB2YCBCR_DSP_StatsStop(numBytes);
+   }
 
    return status ;
 }
 
 
 /** ============================================================================
- *  @func   RGB2YCBCR_DSP_Delete
+ *  @func   RGB2YCBCR_DSP_Execute
  *
- *  @desc   This function releases resources allocated earlier by call to
- *          RGB2YCBCR_DSP_Create ().
- *          During cleanup, the allocated resources are being freed
- *          unconditionally. Actual applications may require stricter check
- *          against return values for robustness.
+ *  @desc   This function implements the execute phase for this application.
+ *          Chunks are copied between the data stream and the channel
+ *          buffers as they go through the pipeline.
  *
- *  @modif  RGB2YCBCR_DSP_Buffers
+ *  @modif  RGB2YCBCR_DSP_Contexts
  *  ============================================================================
  */
-NORMAL_API Void RGB2YCBCR_DSP_Delete(
-   Uint8 processorId)
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_Execute(
+   IN Uint32 numIterations,
+   IN Char8  * dataStream,
+   IN Uint32 dataSize,
+   Uint8     processorId)
+{
+   RGB2YCBCR_DSP_Context * ctx = &RGB2YCBCR_DSP_Contexts [processorId];
+
+   ctx->stream             = dataStream;
+   ctx->dataSize           = dataSize;
+   ctx->firstChunk         = 0;
+   ctx->numChunks          = numIterations;
+   ctx->queue              = NULL;
+   RGB2YCBCR_DSP_NumPixels = dataSize / 3;
+
+   return RGB2YCBCR_DSP_Pipeline(ctx,
+                                 RGB2YCBCR_DSP_CopyIn,
+                                 (RGB2YCBCR_DSP_Format == RGB2YCBCR_DSP_FORMAT_PACKED)
+                                    ? RGB2YCBCR_DSP_CopyOut
+                                    : RGB2YCBCR_DSP_CopyOutPlanes,
+                                 ctx);
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ExecuteStream
+ *
+ *  @desc   This function implements the streaming execute phase, with
+ *          RGB2YCBCR_DSP_Pipeline () over the whole data.
+ *
+ *  @modif  RGB2YCBCR_DSP_Contexts
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_ExecuteStream(
+   IN Uint32                 numIterations,
+   IN Uint32                 dataSize,
+   IN RGB2YCBCR_DSP_ChunkFxn fillFxn,
+   IN RGB2YCBCR_DSP_ChunkFxn drainFxn,
+   IN Pvoid                  arg,
+   IN Uint8                  processorId)
+{
+   DSP_STATUS              status = DSP_SOK;
+   RGB2YCBCR_DSP_Context * ctx    = &RGB2YCBCR_DSP_Contexts [processorId];
+
+   RGB2YCBCR_DSP_0Print ("Entered RGB2YCBCR_DSP_ExecuteStream ()\n") ;
+
+   ctx->dataSize   = dataSize;
+   ctx->firstChunk = 0;
+   ctx->numChunks  = numIterations;
+   ctx->queue      = NULL;
+
+   status = RGB2YCBCR_DSP_Pipeline(ctx,
+                                   fillFxn,
+                                   drainFxn,
+                                   arg);
+
+   RGB2YCBCR_DSP_0Print ("Leaving RGB2YCBCR_DSP_ExecuteStream ()\n") ;
+
+   return status ;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ExecuteInPlace
+ *
+ *  @desc   This function implements the execute phase when the frame already
+ *          lives in channel buffers. Each chunk buffer is sent as is and
+ *          replaced by the buffer holding its result, so nothing is copied
+ *          on the GPP. Up to RGB2YCBCR_DSP_NumBuffers chunks are in flight,
+ *          the last one sent with only the data it carries. The channel
+ *          calls and the round trips are timed.
+ *
+ *  @modif  chunks
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_ExecuteInPlace(
+   IN     Uint32   numChunks,
+   IN     Uint32   dataSize,
+   IN OUT Char8 ** chunks,
+   IN     Uint8    processorId)
+{
+   DSP_STATUS    status    = DSP_SOK;
+   Uint32        issued    = 0;
+   Uint32        posted    = 0;
+   Uint32        completed = 0;
+   Uint32        numBytes  = 0;
+   ChannelIOInfo ioReq;
+   Real64        issueTime [MAX_PIPELINE_DEPTH];
+   Real64        start;
+
+   RGB2YCBCR_DSP_0Print ("Entered RGB2YCBCR_DSP_ExecuteInPlace ()\n") ;
+
+   /*
+    *  Start execution on DSP.
+    */
+   status = RGB2YCBCR_DSP_Start(processorId);
+   if (DSP_SUCCEEDED (status)) {
+      RGB2YCBCR_DSP_StatsStart(numChunks);
+   }
+
+   while ((completed < numChunks) && (DSP_SUCCEEDED (status))) {
+      /*
+       *  Keep the pipeline full: send the next chunks while fewer than
+       *  RGB2YCBCR_DSP_NumBuffers are on their way.
+       */
+      while ((issued < numChunks) && ((issued - completed) < RGB2YCBCR_DSP_NumBuffers)
+             && (DSP_SUCCEEDED (status))) {
+         ioReq.buffer = chunks [issued];
+         ioReq.size   = RGB2YCBCR_DSP_PayloadSize(dataSize, issued);
+         ioReq.arg    = RGB2YCBCR_DSP_ARG_DATA;
+         start  = RGB2YCBCR_DSP_GetTime();
+         issueTime [issued % MAX_PIPELINE_DEPTH] = start;
+         status = CHNL_issue(processorId, CHNL_ID_OUTPUT, &ioReq);
+         RGB2YCBCR_DSP_StatsRecord(RGB2YCBCR_DSP_Phase_Issue, start);
+         if (DSP_FAILED (status)) {
+            RGB2YCBCR_DSP_1Print("CHNL_issue failed (output). Status = [0x%x]\n", status);
+         }
+         else {
+            issued++;
+         }
+      }
+
+      /*
+       *  Post receive buffers for the chunk we wait for and the next one.
+       */
+      while ((posted < issued) && (posted <= (completed + 1))
+             && (DSP_SUCCEEDED (status))) {
+         start  = RGB2YCBCR_DSP_GetTime();
+         status = CHNL_reclaim (processorId, CHNL_ID_OUTPUT, WAIT_FOREVER, &ioReq);
+         if (DSP_FAILED (status)) {
+            RGB2YCBCR_DSP_1Print ("CHNL_reclaim failed (output). Status = [0x%x]\n", status);
+         }
+
+         if (DSP_SUCCEEDED (status)) {
+            ioReq.size = RGB2YCBCR_DSP_BufferSize;
+            status = CHNL_issue (processorId, CHNL_ID_INPUT, &ioReq) ;
+            RGB2YCBCR_DSP_StatsRecord(RGB2YCBCR_DSP_Phase_Issue, start);
+            if (DSP_FAILED (status)) {
+               RGB2YCBCR_DSP_1Print ("CHNL_issue failed (input). Status = [0x%x]\n", status);
+            }
+            else {
+               posted++;
+            }
+         }
+      }
+
+      /*
+       *  Reclaim 'filled' buffer from the channel, it now holds the chunk.
+       */
+      if (DSP_SUCCEEDED (status)) {
+         status = CHNL_reclaim (processorId, CHNL_ID_INPUT, WAIT_FOREVER, &ioReq);
+         if (DSP_FAILED (status)) {
+            RGB2YCBCR_DSP_1Print ("CHNL_reclaim failed (input). Status = [0x%x]\n", status) ;
+         }
+         else {
+            RGB2YCBCR_DSP_StatsRecord(RGB2YCBCR_DSP_Phase_RoundTrip,
+                                      issueTime [completed % MAX_PIPELINE_DEPTH]);
+            chunks [completed] = ioReq.buffer;
+
+            /* A planar chunk comes back with only the bytes of its planes */
+            if (ioReq.size != RGB2YCBCR_DSP_ReturnSize(RGB2YCBCR_DSP_PayloadSize(dataSize, completed))) {
+               RGB2YCBCR_DSP_1Print("Chunk returned with %d bytes\n", ioReq.size);
+               status = DSP_EFAIL;
+            }
+            else {
+               numBytes += ioReq.size;
+               completed++;
+            }
+         }
+      }
+   }
+
+   RGB2YCBCR_DSP_StatsStop(numBytes);
+
+   RGB2YCBCR_DSP_0Print ("Leaving RGB2YCBCR_DSP_ExecuteInPlace ()\n") ;
+
+   return status ;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_AllocateFrame
+ *
+ *  @desc   Allocates the channel buffers that hold a whole frame for
+ *          RGB2YCBCR_DSP_ExecuteInPlace ().
+ *
+ *  @modif  chunks
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_AllocateFrame(
+   OUT Char8 ** chunks,
+   IN  Uint32   numChunks,
+   IN  Uint8    processorId)
+{
+   DSP_STATUS status = DSP_SOK;
+
+   status = CHNL_allocateBuffer (processorId,
+                                 CHNL_ID_OUTPUT,
+                                 chunks,
+                                 RGB2YCBCR_DSP_BufferSize,
+                                 numChunks);
+   if (DSP_FAILED (status)) {
+      RGB2YCBCR_DSP_1Print ("CHNL_allocateBuffer failed (frame)."
+                            "Status = [0x%x]\n",
+                            status);
+   }
+
+   return status;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_FreeFrame
+ *
+ *  @desc   Frees the channel buffers allocated by
+ *          RGB2YCBCR_DSP_AllocateFrame ().
+ *
+ *  @modif  chunks
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_FreeFrame(
+   IN Char8 ** chunks,
+   IN Uint32   numChunks,
+   IN Uint8    processorId)
+{
+   DSP_STATUS status = DSP_SOK;
+
+   status = CHNL_freeBuffer (processorId, CHNL_ID_OUTPUT, chunks, numChunks);
+   if (DSP_FAILED (status)) {
+      RGB2YCBCR_DSP_1Print ("CHNL_freeBuffer () failed (frame). Status = [0x%x]\n", status);
+   }
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_DeleteProcessor
+ *
+ *  @desc   Releases what RGB2YCBCR_DSP_CreateProcessor () set up for a
+ *          processor and stops it. The resources are freed unconditionally.
+ *
+ *  @modif  RGB2YCBCR_DSP_Contexts
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_DeleteProcessor(
+   IN Uint8 processorId)
 {
    DSP_STATUS status    = DSP_SOK;
    DSP_STATUS tmpStatus = DSP_SOK;
 
-   RGB2YCBCR_DSP_0Print ("Entered RGB2YCBCR_DSP_Delete ()\n");
-
    /*
     *  Free the buffer(s) allocated for channel to DSP
     */
-   tmpStatus = CHNL_freeBuffer (processorId, CHNL_ID_OUTPUT, RGB2YCBCR_DSP_Buffers, 1);
+   tmpStatus = CHNL_freeBuffer (processorId,
+                                CHNL_ID_OUTPUT,
+                                RGB2YCBCR_DSP_Contexts [processorId].buffers,
+                                RGB2YCBCR_DSP_NumBuffers);
    if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
       RGB2YCBCR_DSP_1Print ("CHNL_freeBuffer () failed (output). Status = [0x%x]\n", tmpStatus);
    }
@@ -427,6 +1300,7 @@ NORMAL_API Void RGB2YCBCR_DSP_Delete(
     *  Stop execution on DSP.
     */
    status = PROC_stop (processorId);
+   RGB2YCBCR_DSP_Contexts [processorId].started = FALSE;
 
    /*
     *  Close the pool
@@ -443,97 +1317,1007 @@ NORMAL_API Void RGB2YCBCR_DSP_Delete(
    if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
       RGB2YCBCR_DSP_1Print ("PROC_detach () failed. Status = [0x%x]\n", tmpStatus);
    }
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_Delete
+ *
+ *  @desc   This function releases resources allocated earlier by call to
+ *          RGB2YCBCR_DSP_Create ().
+ *          During cleanup, the allocated resources are being freed
+ *          unconditionally. Actual applications may require stricter check
+ *          against return values for robustness.
+ *
+ *  @modif  RGB2YCBCR_DSP_Contexts
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_Delete(
+   Uint8 processorId)
+{
+   DSP_STATUS status = DSP_SOK;
+
+   RGB2YCBCR_DSP_0Print ("Entered RGB2YCBCR_DSP_Delete ()\n");
+
+   RGB2YCBCR_DSP_DeleteProcessor(processorId);
 
    /*
     *  Destroy the PROC object.
     */
-   tmpStatus = PROC_destroy ();
-   if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
-      RGB2YCBCR_DSP_1Print ("PROC_destroy () failed. Status = [0x%x]\n", tmpStatus);
+   status = PROC_destroy ();
+   if (DSP_FAILED (status)) {
+      RGB2YCBCR_DSP_1Print ("PROC_destroy () failed. Status = [0x%x]\n", status);
    }
 
    RGB2YCBCR_DSP_0Print ("Leaving RGB2YCBCR_DSP_Delete ()\n") ;
 }
 
 
-/** ============================================================================
- *  @func   RGB2YCBCR_DSP_Main
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_Setup
  *
- *  @desc   Entry point for the application
+ *  @desc   Validates the string arguments shared by the application entry
+ *          points and keeps their values for the create and execute phases.
  *
- *  @modif  None
- *  ============================================================================
+ *  @modif  RGB2YCBCR_DSP_BufferSize, RGB2YCBCR_DSP_NumIterations,
+ *          RGB2YCBCR_DSP_NumBuffers, RGB2YCBCR_DSP_NumDspBuffers
+ *  ----------------------------------------------------------------------------
  */
-NORMAL_API Void RGB2YCBCR_DSP_Main(
+STATIC DSP_STATUS RGB2YCBCR_DSP_Setup(
+   IN  Char8  * strBufferSize,
+   IN  Char8  * strNumIterations,
+   IN  Char8  * strNumBuffers,
+   IN  Char8  * strNumDspBuffers,
+   IN  Char8  * strProcessorId,
+   OUT Uint8  * processorId)
+{
+   DSP_STATUS status = DSP_SOK;
+
+   /*
+    *  Validate the buffer size and number of iterations specified.
+    */
+   RGB2YCBCR_DSP_ChunkSize  = RGB2YCBCR_DSP_Atoi(strBufferSize);
+   RGB2YCBCR_DSP_BufferSize = DSPLINK_ALIGN(RGB2YCBCR_DSP_ChunkSize, DSPLINK_BUF_ALIGN);
+
+   if (RGB2YCBCR_DSP_BufferSize == 0) {
+      status = DSP_ESIZE;
+   }
+
+   /* Get the number of Iterations */
+   RGB2YCBCR_DSP_NumIterations = RGB2YCBCR_DSP_Atoi(strNumIterations);
+   if (0 == RGB2YCBCR_DSP_NumIterations)
+   {
+      RGB2YCBCR_DSP_1Print("==Erro: Invalid number of iterations %d ==\n", RGB2YCBCR_DSP_NumIterations);
+      status = DSP_EFAIL;
+   }
+
+   /* Get the depth of the transfer pipeline */
+   RGB2YCBCR_DSP_NumBuffers = RGB2YCBCR_DSP_Atoi(strNumBuffers);
+   if ((RGB2YCBCR_DSP_NumBuffers == 0) || (RGB2YCBCR_DSP_NumBuffers > MAX_PIPELINE_DEPTH)) {
+      RGB2YCBCR_DSP_1Print("==Error: Invalid pipeline depth %d ==\n", RGB2YCBCR_DSP_NumBuffers);
+      status = DSP_EFAIL;
+   }
+
+   /* Get the number of buffers the DSP streams through */
+   RGB2YCBCR_DSP_NumDspBuffers = RGB2YCBCR_DSP_Atoi(strNumDspBuffers);
+   if (RGB2YCBCR_DSP_NumDspBuffers == 0) {
+      RGB2YCBCR_DSP_1Print("==Error: Invalid number of DSP buffers %d ==\n", RGB2YCBCR_DSP_NumDspBuffers);
+      status = DSP_EFAIL;
+   }
+
+   /* Find out the processor id to work with */
+   *processorId = RGB2YCBCR_DSP_Atoi(strProcessorId);
+   if (*processorId >= MAX_DSPS) {
+      RGB2YCBCR_DSP_1Print ("==Error: Invalid processor id  specified %d ==\n", *processorId);
+      status = DSP_EFAIL;
+   }
+
+   return status;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_ParseProcessors
+ *
+ *  @desc   Reads a comma separated list of processor ids, such as "0,1".
+ *          Returns the number of ids, or 0 if one of them is invalid or
+ *          given twice.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Uint32 RGB2YCBCR_DSP_ParseProcessors(
+   IN  Char8 * strProcessorIds,
+   OUT Uint8 * processorIds)
+{
+   Uint32  numProcessors = 0;
+   Uint32  i;
+   Char8 * end;
+   unsigned long id;
+
+   do {
+      id = strtoul(strProcessorIds, &end, 10);
+      if ((end == strProcessorIds) || (id >= MAX_DSPS) || (numProcessors >= MAX_DSPS)) {
+         RGB2YCBCR_DSP_0Print("==Error: Invalid processor id list ==\n");
+         return 0;
+      }
+      for (i = 0 ; i < numProcessors ; i++) {
+         if (processorIds [i] == id) {
+            RGB2YCBCR_DSP_1Print("==Error: Processor id given twice %d ==\n", id);
+            return 0;
+         }
+      }
+      processorIds [numProcessors++] = (Uint8) id;
+      strProcessorIds = end + 1;
+   } while (*end == ',');
+
+   if (*end != '\0') {
+      RGB2YCBCR_DSP_0Print("==Error: Invalid processor id list ==\n");
+      return 0;
+   }
+
+   return numProcessors;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_ShardRun
+ *
+ *  @desc   Body of the thread driving one processor of a shared frame. It
+ *          streams the share of the context through the pipeline and keeps
+ *          the outcome and the time taken in the context.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Pvoid RGB2YCBCR_DSP_ShardRun(
+   IN Pvoid arg)
+{
+   RGB2YCBCR_DSP_Context * ctx   = (RGB2YCBCR_DSP_Context *) arg;
+   Real64                  start = RGB2YCBCR_DSP_GetTime();
+
+   ctx->status  = RGB2YCBCR_DSP_Pipeline(ctx,
+                                         RGB2YCBCR_DSP_CopyIn,
+                                         (RGB2YCBCR_DSP_Format == RGB2YCBCR_DSP_FORMAT_PACKED)
+                                            ? RGB2YCBCR_DSP_CopyOut
+                                            : RGB2YCBCR_DSP_CopyOutPlanes,
+                                         ctx);
+   ctx->elapsed = RGB2YCBCR_DSP_GetTime() - start;
+
+   return NULL;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_Shard
+ *
+ *  @desc   Create, execute and delete phases of a frame shared between
+ *          processors. The chunks are split in contiguous shares of about
+ *          the same size, one per processor, and every processor is loaded
+ *          with the number of chunks of its share. A thread per processor
+ *          streams its share through its own channel pair and pool. The
+ *          copies place every chunk at its own offset, so the output comes
+ *          out in order with no extra pass. The stats module follows one
+ *          processor at a time, so the shares are not timed chunk by chunk;
+ *          the time of every share and the throughput of the frame are
+ *          printed instead.
+ *
+ *  @modif  RGB2YCBCR_DSP_Contexts
+ *  ----------------------------------------------------------------------------
+ */
+STATIC DSP_STATUS RGB2YCBCR_DSP_Shard(
    IN Char8  * dspExecutable,
    IN Char8  * dataStream,
    IN Uint32   dataSize,
    IN Char8  * strBufferSize,
-   IN Char8  * strNumIterations,
-   IN Char8  * strProcessorId)
+   IN Char8  * strNumDspBuffers,
+   IN Uint8  * processorIds,
+   IN Uint32   numProcessors)
 {
-   DSP_STATUS status      = DSP_SOK;
-   Uint8      processorId = 0;
+   DSP_STATUS              status     = DSP_SOK;
+   DSP_STATUS              tmpStatus  = DSP_SOK;
+   Uint32                  firstChunk = 0;
+   Uint32                  numCreated = 0;
+   Uint32                  numRunning = 0;
+   Uint32                  numChunks;
+   Uint32                  i;
+   Pvoid                   threads [MAX_DSPS];
+   Char8                   strNumChunks [MAX_ARG_LENGTH];
+   RGB2YCBCR_DSP_Context * ctx;
+   Real64                  start;
+   Real64                  elapsed;
+
+   /* Every processor loaded gets at least one chunk */
+   if (numProcessors > RGB2YCBCR_DSP_NumIterations) {
+      numProcessors = RGB2YCBCR_DSP_NumIterations;
+   }
 
-   RGB2YCBCR_DSP_0Print("=============== tecSat Application : RGB2YCBCR_DSP ==========\n");
+   RGB2YCBCR_DSP_NumPixels = dataSize / 3;
 
-   if ((dspExecutable != NULL) && (dataStream != NULL) && (dataSize != 0) && 
-       (strBufferSize != NULL) && (strNumIterations != NULL) && (strProcessorId != NULL)) {
-      /*
-       *  Validate the buffer size and number of iterations specified.
-       */
-      RGB2YCBCR_DSP_BufferSize = DSPLINK_ALIGN(RGB2YCBCR_DSP_Atoi(strBufferSize), DSPLINK_BUF_ALIGN);
+   /*
+    *  Create and initialize the proc object, once for all processors.
+    */
+   status = PROC_setup (NULL);
+   if (DSP_FAILED (status)) {
+      RGB2YCBCR_DSP_1Print ("PROC_setup failed. Status =  [0x%x]\n", status);
+   }
 
-      if (RGB2YCBCR_DSP_BufferSize == 0) {
-         status = DSP_ESIZE;
-      }
+   for (i = 0 ; (i < numProcessors) && DSP_SUCCEEDED (status) ; i++) {
+      /* The first shares take a chunk more when they do not split evenly */
+      numChunks = (RGB2YCBCR_DSP_NumIterations / numProcessors)
+                  + ((i < (RGB2YCBCR_DSP_NumIterations % numProcessors)) ? 1 : 0);
+      sprintf(strNumChunks, "%u", (unsigned) numChunks);
+
+      status = RGB2YCBCR_DSP_CreateProcessor(dspExecutable,
+                                             strBufferSize,
+                                             strNumChunks,
+                                             strNumDspBuffers,
+                                             processorIds [i]);
+      numCreated++;
+
+      ctx             = &RGB2YCBCR_DSP_Contexts [processorIds [i]];
+      ctx->timed      = FALSE;
+      ctx->queue      = NULL;
+      ctx->stream     = dataStream;
+      ctx->dataSize   = dataSize;
+      ctx->firstChunk = firstChunk;
+      ctx->numChunks  = numChunks;
+      ctx->status     = DSP_SOK;
+      ctx->elapsed    = 0;
+      firstChunk     += ctx->numChunks;
+   }
 
-      /* Get the number of Iterations */
-      RGB2YCBCR_DSP_NumIterations = RGB2YCBCR_DSP_Atoi(strNumIterations);
-      if (0 == RGB2YCBCR_DSP_NumIterations)
-      {
-         RGB2YCBCR_DSP_1Print("==Erro: Invalid number of iterations %d ==\n", RGB2YCBCR_DSP_NumIterations);
-         status = DSP_EFAIL;
+   /*
+    *  Execute the shares in parallel.
+    */
+   start = RGB2YCBCR_DSP_GetTime();
+   while ((numRunning < numProcessors) && DSP_SUCCEEDED (status)) {
+      status = RGB2YCBCR_DSP_ThreadCreate(&threads [numRunning],
+                                          RGB2YCBCR_DSP_ShardRun,
+                                          &RGB2YCBCR_DSP_Contexts [processorIds [numRunning]]);
+      if (DSP_FAILED (status)) {
+         RGB2YCBCR_DSP_1Print ("Can not start the thread of processor %d\n", processorIds [numRunning]);
       }
-
-      /* Find out the processor id to work with */
-      processorId = RGB2YCBCR_DSP_Atoi(strProcessorId);
-      if (processorId >= MAX_DSPS) {
-         RGB2YCBCR_DSP_1Print ("==Error: Invalid processor id  specified %d ==\n", processorId);
-         status = DSP_EFAIL;
+      else {
+         numRunning++;
       }
+   }
 
-      /*
-       *  Specify the dsp executable file name and the buffer size for
-       *  rgb2ycbcr-dsp creation phase.
-       */
-      if (DSP_SUCCEEDED(status)) {
-         RGB2YCBCR_DSP_1Print ("==== Executing tecSat sample for DSP processor Id %d ====\n", processorId);
-
-         status = RGB2YCBCR_DSP_Create(dspExecutable, strBufferSize, strNumIterations, processorId);
-
-         /*
-          *  Execute the data transfer rgb2ycbcr-dsp.
-          */
-         if (DSP_SUCCEEDED(status)) {
-            status = RGB2YCBCR_DSP_Execute(RGB2YCBCR_DSP_NumIterations, dataStream, RGB2YCBCR_DSP_BufferSize, processorId);
-         }
+   for (i = 0 ; i < numRunning ; i++) {
+      RGB2YCBCR_DSP_ThreadJoin(threads [i]);
+      ctx = &RGB2YCBCR_DSP_Contexts [processorIds [i]];
+      if (DSP_SUCCEEDED (status) && DSP_FAILED (ctx->status)) {
+         status = ctx->status;
+      }
+   }
+   elapsed = RGB2YCBCR_DSP_GetTime() - start;
 
-         /*
-          *  Perform cleanup operation.
-          */
-         RGB2YCBCR_DSP_Delete(processorId);
+   if (DSP_SUCCEEDED (status)) {
+      for (i = 0 ; i < numRunning ; i++) {
+         ctx = &RGB2YCBCR_DSP_Contexts [processorIds [i]];
+         printf("DSP %u: chunks %u to %u in %.6f s\n",
+                (unsigned int) ctx->processorId,
+                (unsigned int) ctx->firstChunk,
+                (unsigned int) (ctx->firstChunk + ctx->numChunks - 1),
+                ctx->elapsed);
       }
+      printf("%u bytes on %u DSPs in %.6f s, %.2f MB/s\n",
+             (unsigned int) dataSize,
+             (unsigned int) numRunning,
+             elapsed,
+             (elapsed > 0) ? ((Real64) dataSize / elapsed / 1e6) : 0.0);
+      fflush(stdout);
    }
-   else {
-      status = DSP_EINVALIDARG;
-      RGB2YCBCR_DSP_0Print("ERROR! Invalid arguments specified for while executing "
-                            "rgb2ycbcr-dsp application\n") ;
+
+   /*
+    *  Perform cleanup operation.
+    */
+   for (i = 0 ; i < numCreated ; i++) {
+      RGB2YCBCR_DSP_DeleteProcessor(processorIds [i]);
    }
 
-   RGB2YCBCR_DSP_0Print ("====================================================\n") ;
+   tmpStatus = PROC_destroy ();
+   if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+      RGB2YCBCR_DSP_1Print ("PROC_destroy () failed. Status = [0x%x]\n", tmpStatus);
+   }
+
+   return status;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_SendEnd
+ *
+ *  @desc   Sends a buffer with the RGB2YCBCR_DSP_ARG_END arg to a processor
+ *          loaded with zero transfers, and waits for the DSP to hand it
+ *          back once it has left its loop.
+ *
+ *  @modif  ctx
+ *  ----------------------------------------------------------------------------
+ */
+STATIC DSP_STATUS RGB2YCBCR_DSP_SendEnd(
+   IN RGB2YCBCR_DSP_Context * ctx)
+{
+   DSP_STATUS status = DSP_SOK;
+
+   ctx->ioReq.buffer = ctx->buffers [0];
+   ctx->ioReq.size   = RGB2YCBCR_DSP_BufferSize;
+   ctx->ioReq.arg    = RGB2YCBCR_DSP_ARG_END;
+   status = CHNL_issue(ctx->processorId, CHNL_ID_OUTPUT, &ctx->ioReq);
+   if (DSP_FAILED (status)) {
+      RGB2YCBCR_DSP_1Print("CHNL_issue failed (output). Status = [0x%x]\n", status);
+   }
+
+   if (DSP_SUCCEEDED (status)) {
+      status = CHNL_reclaim(ctx->processorId, CHNL_ID_OUTPUT, WAIT_FOREVER, &ctx->ioReq);
+      if (DSP_FAILED (status)) {
+         RGB2YCBCR_DSP_1Print("CHNL_reclaim failed (output). Status = [0x%x]\n", status);
+      }
+   }
+
+   if (DSP_SUCCEEDED (status)) {
+      ctx->ioReq.size = RGB2YCBCR_DSP_BufferSize;
+      status = CHNL_issue(ctx->processorId, CHNL_ID_INPUT, &ctx->ioReq);
+      if (DSP_FAILED (status)) {
+         RGB2YCBCR_DSP_1Print("CHNL_issue failed (input). Status = [0x%x]\n", status);
+      }
+   }
+
+   /* The DSP sends the buffer back once it has left its loop */
+   if (DSP_SUCCEEDED (status)) {
+      status = CHNL_reclaim(ctx->processorId, CHNL_ID_INPUT, WAIT_FOREVER, &ctx->ioReq);
+      if (DSP_FAILED (status)) {
+         RGB2YCBCR_DSP_1Print("CHNL_reclaim failed (input). Status = [0x%x]\n", status);
+      }
+      else {
+         ctx->buffers [0] = ctx->ioReq.buffer;
+      }
+   }
+
+   return status;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_HybridRun
+ *
+ *  @desc   Body of the thread driving one processor of a hybrid run. The
+ *          processor takes chunks from the shared queue until it is empty,
+ *          then is told to leave its loop.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Pvoid RGB2YCBCR_DSP_HybridRun(
+   IN Pvoid arg)
+{
+   RGB2YCBCR_DSP_Context * ctx       = (RGB2YCBCR_DSP_Context *) arg;
+   Real64                  start     = RGB2YCBCR_DSP_GetTime();
+   DSP_STATUS              tmpStatus = DSP_SOK;
+
+   ctx->status  = RGB2YCBCR_DSP_Pipeline(ctx,
+                                         RGB2YCBCR_DSP_CopyIn,
+                                         (RGB2YCBCR_DSP_Format == RGB2YCBCR_DSP_FORMAT_PACKED)
+                                            ? RGB2YCBCR_DSP_CopyOut
+                                            : RGB2YCBCR_DSP_CopyOutPlanes,
+                                         ctx);
+   ctx->elapsed = RGB2YCBCR_DSP_GetTime() - start;
+
+   /* The DSP was loaded to loop, it needs the end buffer to stop */
+   if (ctx->started && DSP_SUCCEEDED (ctx->status)) {
+      tmpStatus = RGB2YCBCR_DSP_SendEnd(ctx);
+      if (DSP_SUCCEEDED (ctx->status)) {
+         ctx->status = tmpStatus;
+      }
+   }
+
+   return NULL;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_GppRun
+ *
+ *  @desc   GPP engine of a hybrid run. It takes chunks from the shared queue
+ *          and converts them with the kernel of the context, as the DSP
+ *          would: packed chunks in place in the stream, planar ones through
+ *          a scratch copy whose planes are placed like those the DSP sends
+ *          back.
+ *
+ *  @modif  ctx
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Pvoid RGB2YCBCR_DSP_GppRun(
+   IN Pvoid arg)
+{
+   RGB2YCBCR_DSP_Context *  ctx        = (RGB2YCBCR_DSP_Context *) arg;
+   RGB2YCBCR_DSP_ConvertFxn convertFxn = ctx->kernel->convertFxn;
+   Char8 *                  pixels     = NULL;
+   Char8 *                  planes     = NULL;
+   Real64                   start      = RGB2YCBCR_DSP_GetTime();
+   Uint32                   index;
+   Uint32                   size;
+   Char8 *                  chunk;
+
+   if (RGB2YCBCR_DSP_Direction == RGB2YCBCR_DSP_DIR_INVERSE) {
+      convertFxn = ctx->kernel->inverseFxn;
+   }
+
+   /* The DSP leaves the data unconverted when it writes planes */
+   if (RGB2YCBCR_DSP_Format != RGB2YCBCR_DSP_FORMAT_PACKED) {
+      pixels = (Char8 *) malloc(RGB2YCBCR_DSP_ChunkSize);
+      planes = (Char8 *) malloc(RGB2YCBCR_DSP_ChunkSize);
+      if ((pixels == NULL) || (planes == NULL)) {
+         ctx->status = DSP_EMEMORY;
+      }
+   }
+
+   while (DSP_SUCCEEDED (ctx->status) && RGB2YCBCR_DSP_NextChunk(ctx, &index)) {
+      size  = RGB2YCBCR_DSP_PayloadSize(ctx->dataSize, index);
+      chunk = ctx->stream + (RGB2YCBCR_DSP_ChunkSize * index);
+
+      if (pixels == NULL) {
+         convertFxn(chunk, size);
+      }
+      else {
+         memcpy(pixels, chunk, size);
+         convertFxn(pixels, size);
+         RGB2YCBCR_DSP_Planarize(pixels,
+                                 planes,
+                                 size / 3,
+                                 RGB2YCBCR_DSP_Format,
+                                 RGB2YCBCR_DSP_Atoi(RGB2YCBCR_DSP_StrWidth),
+                                 RGB2YCBCR_DSP_Atoi(RGB2YCBCR_DSP_StrFilter));
+         ctx->status = RGB2YCBCR_DSP_CopyOutPlanes(ctx, planes, index, size);
+      }
+
+      ctx->doneChunks++;
+      ctx->doneBytes += size;
+   }
+
+   free(planes);
+   free(pixels);
+   ctx->elapsed = RGB2YCBCR_DSP_GetTime() - start;
+
+   return NULL;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_Throughput
+ *
+ *  @desc   Prints the chunks and bytes an engine of a hybrid run converted
+ *          and its throughput while it ran.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_Throughput(
+   IN Char8 *                 engine,
+   IN RGB2YCBCR_DSP_Context * ctx)
+{
+   printf("%s: %u chunks, %u bytes in %.6f s, %.2f MB/s\n",
+          engine,
+          (unsigned int) ctx->doneChunks,
+          (unsigned int) ctx->doneBytes,
+          ctx->elapsed,
+          (ctx->elapsed > 0) ? ((Real64) ctx->doneBytes / ctx->elapsed / 1e6) : 0.0);
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_Main
+ *
+ *  @desc   Entry point for the application
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_Main(
+   IN Char8  * dspExecutable,
+   IN Char8  * dataStream,
+   IN Uint32   dataSize,
+   IN Char8  * strBufferSize,
+   IN Char8  * strNumIterations,
+   IN Char8  * strNumBuffers,
+   IN Char8  * strNumDspBuffers,
+   IN Char8  * strProcessorId)
+{
+   DSP_STATUS status        = DSP_SOK;
+   Uint8      processorId   = 0;
+   Uint32     numProcessors = 0;
+   Uint8      processorIds [MAX_DSPS];
+
+   RGB2YCBCR_DSP_0Print("=============== tecSat Application : RGB2YCBCR_DSP ==========\n");
+
+   if ((dspExecutable != NULL) && (dataStream != NULL) && (dataSize != 0) && 
+       (strBufferSize != NULL) && (strNumIterations != NULL) && (strNumBuffers != NULL) &&
+       (strNumDspBuffers != NULL) && (strProcessorId != NULL)) {
+      status = RGB2YCBCR_DSP_Setup(strBufferSize,
+                                   strNumIterations,
+                                   strNumBuffers,
+                                   strNumDspBuffers,
+                                   strProcessorId,
+                                   &processorId);
+
+      if (DSP_SUCCEEDED(status)) {
+         numProcessors = RGB2YCBCR_DSP_ParseProcessors(strProcessorId, processorIds);
+         if (numProcessors == 0) {
+            status = DSP_EINVALIDARG;
+         }
+      }
+
+      /*
+       *  Share the frame when several processors are given.
+       */
+      if (DSP_SUCCEEDED(status) && (numProcessors > 1)) {
+         RGB2YCBCR_DSP_1Print ("==== Executing tecSat sample on DSP processors, count %d ====\n", numProcessors);
+
+         status = RGB2YCBCR_DSP_Shard(dspExecutable,
+                                      dataStream,
+                                      dataSize,
+                                      strBufferSize,
+                                      strNumDspBuffers,
+                                      processorIds,
+                                      numProcessors);
+      }
+      else if (DSP_SUCCEEDED(status)) {
+         RGB2YCBCR_DSP_1Print ("==== Executing tecSat sample for DSP processor Id %d ====\n", processorId);
+
+         /*
+          *  Specify the dsp executable file name and the buffer size for
+          *  rgb2ycbcr-dsp creation phase.
+          */
+
+         status = RGB2YCBCR_DSP_Create(dspExecutable, strBufferSize, strNumIterations, strNumDspBuffers, processorId);
+
+         /*
+          *  Execute the data transfer rgb2ycbcr-dsp.
+          */
+         if (DSP_SUCCEEDED(status)) {
+            status = RGB2YCBCR_DSP_Execute(RGB2YCBCR_DSP_NumIterations, dataStream, dataSize, processorId);
+         }
+
+         /*
+          *  Perform cleanup operation.
+          */
+         RGB2YCBCR_DSP_Delete(processorId);
+      }
+   }
+   else {
+      status = DSP_EINVALIDARG;
+      RGB2YCBCR_DSP_0Print("ERROR! Invalid arguments specified for while executing "
+                            "rgb2ycbcr-dsp application\n") ;
+   }
+
+   RGB2YCBCR_DSP_0Print ("====================================================\n") ;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_MainHybrid
+ *
+ *  @desc   Entry point for the application when the GPP converts alongside
+ *          the DSPs. The chunks are kept in one queue. Every processor is
+ *          loaded to loop and driven by a thread of its own, and the
+ *          calling thread converts with the GPP kernel. Each engine takes
+ *          the next chunk from the queue as soon as it has room for it, so
+ *          the faster one ends up with more of the frame. The chunks each
+ *          engine converted and its throughput are printed at the end.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_MainHybrid(
+   IN Char8  * dspExecutable,
+   IN Char8  * dataStream,
+   IN Uint32   dataSize,
+   IN Char8  * strBufferSize,
+   IN Char8  * strNumIterations,
+   IN Char8  * strNumBuffers,
+   IN Char8  * strNumDspBuffers,
+   IN Char8  * strProcessorId,
+   IN Char8  * kernelName)
+{
+   DSP_STATUS              status        = DSP_SOK;
+   DSP_STATUS              tmpStatus     = DSP_SOK;
+   Uint8                   processorId   = 0;
+   Uint32                  numProcessors = 0;
+   Uint32                  numCreated    = 0;
+   Uint32                  numRunning    = 0;
+   Uint32                  i;
+   Uint8                   processorIds [MAX_DSPS];
+   Pvoid                   threads [MAX_DSPS];
+   Char8                   engine [16];
+   RGB2YCBCR_DSP_Queue     queue;
+   RGB2YCBCR_DSP_Context   gpp;
+   RGB2YCBCR_DSP_Context * ctx;
+   Real64                  start;
+   Real64                  elapsed;
+
+   RGB2YCBCR_DSP_0Print("=============== tecSat Hybrid : RGB2YCBCR_DSP ===============\n");
+
+   if ((dspExecutable == NULL) || (dataStream == NULL) || (dataSize == 0) ||
+       (strBufferSize == NULL) || (strNumIterations == NULL) || (strNumBuffers == NULL) ||
+       (strNumDspBuffers == NULL) || (strProcessorId == NULL) || (kernelName == NULL)) {
+      RGB2YCBCR_DSP_0Print("ERROR! Invalid arguments specified for the hybrid run\n");
+      return;
+   }
+
+   status = RGB2YCBCR_DSP_Setup(strBufferSize,
+                                strNumIterations,
+                                strNumBuffers,
+                                strNumDspBuffers,
+                                strProcessorId,
+                                &processorId);
+
+   if (DSP_SUCCEEDED(status)) {
+      numProcessors = RGB2YCBCR_DSP_ParseProcessors(strProcessorId, processorIds);
+      if (numProcessors == 0) {
+         status = DSP_EINVALIDARG;
+      }
+   }
+
+   memset(&gpp, 0, sizeof(gpp));
+   if (DSP_SUCCEEDED(status)) {
+      gpp.kernel = RGB2YCBCR_DSP_GetKernel(kernelName);
+      if (gpp.kernel == NULL) {
+         RGB2YCBCR_DSP_0Print("==Error: Unknown GPP kernel ==\n");
+         status = DSP_EINVALIDARG;
+      }
+   }
+
+   if (DSP_FAILED(status)) {
+      return;
+   }
+
+   queue.next      = 0;
+   queue.numChunks = RGB2YCBCR_DSP_NumIterations;
+   status = RGB2YCBCR_DSP_MutexCreate(&queue.mutex);
+   if (DSP_FAILED (status)) {
+      RGB2YCBCR_DSP_0Print ("Can not create the chunk queue\n");
+      return;
+   }
+
+   RGB2YCBCR_DSP_NumPixels = dataSize / 3;
+
+   gpp.queue    = &queue;
+   gpp.stream   = dataStream;
+   gpp.dataSize = dataSize;
+   gpp.status   = DSP_SOK;
+
+   /*
+    *  Create and initialize the proc object, once for all processors.
+    */
+   status = PROC_setup (NULL);
+   if (DSP_FAILED (status)) {
+      RGB2YCBCR_DSP_1Print ("PROC_setup failed. Status =  [0x%x]\n", status);
+   }
+
+   /* The processors loop until the queue is empty */
+   for (i = 0 ; (i < numProcessors) && DSP_SUCCEEDED (status) ; i++) {
+      status = RGB2YCBCR_DSP_CreateProcessor(dspExecutable,
+                                             strBufferSize,
+                                             "0",
+                                             strNumDspBuffers,
+                                             processorIds [i]);
+      numCreated++;
+
+      ctx             = &RGB2YCBCR_DSP_Contexts [processorIds [i]];
+      ctx->timed      = (numProcessors == 1);
+      ctx->queue      = &queue;
+      ctx->stream     = dataStream;
+      ctx->dataSize   = dataSize;
+      ctx->firstChunk = 0;
+      ctx->numChunks  = 0;
+      ctx->status     = DSP_SOK;
+      ctx->elapsed    = 0;
+      ctx->doneChunks = 0;
+      ctx->doneBytes  = 0;
+   }
+
+   /*
+    *  Execute on the processors and the GPP at once.
+    */
+   start = RGB2YCBCR_DSP_GetTime();
+   while ((numRunning < numCreated) && DSP_SUCCEEDED (status)) {
+      status = RGB2YCBCR_DSP_ThreadCreate(&threads [numRunning],
+                                          RGB2YCBCR_DSP_HybridRun,
+                                          &RGB2YCBCR_DSP_Contexts [processorIds [numRunning]]);
+      if (DSP_FAILED (status)) {
+         RGB2YCBCR_DSP_1Print ("Can not start the thread of processor %d\n", processorIds [numRunning]);
+      }
+      else {
+         numRunning++;
+      }
+   }
+
+   /* Without every processor running the GPP does not take any chunk */
+   if (DSP_SUCCEEDED (status)) {
+      RGB2YCBCR_DSP_GppRun(&gpp);
+      status = gpp.status;
+   }
+
+   for (i = 0 ; i < numRunning ; i++) {
+      RGB2YCBCR_DSP_ThreadJoin(threads [i]);
+      ctx = &RGB2YCBCR_DSP_Contexts [processorIds [i]];
+      if (DSP_SUCCEEDED (status) && DSP_FAILED (ctx->status)) {
+         status = ctx->status;
+      }
+   }
+   elapsed = RGB2YCBCR_DSP_GetTime() - start;
+
+   if (DSP_SUCCEEDED (status)) {
+      for (i = 0 ; i < numRunning ; i++) {
+         ctx = &RGB2YCBCR_DSP_Contexts [processorIds [i]];
+         snprintf(engine, sizeof(engine), "DSP %u", (unsigned int) ctx->processorId);
+         RGB2YCBCR_DSP_Throughput(engine, ctx);
+      }
+      snprintf(engine, sizeof(engine), "GPP %s", gpp.kernel->name);
+      RGB2YCBCR_DSP_Throughput(engine, &gpp);
+      printf("%u bytes on %u DSPs and the GPP in %.6f s, %.2f MB/s\n",
+             (unsigned int) dataSize,
+             (unsigned int) numRunning,
+             elapsed,
+             (elapsed > 0) ? ((Real64) dataSize / elapsed / 1e6) : 0.0);
+      fflush(stdout);
+   }
+
+   /*
+    *  Perform cleanup operation.
+    */
+   for (i = 0 ; i < numCreated ; i++) {
+      RGB2YCBCR_DSP_DeleteProcessor(processorIds [i]);
+   }
+
+   tmpStatus = PROC_destroy ();
+   if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+      RGB2YCBCR_DSP_1Print ("PROC_destroy () failed. Status = [0x%x]\n", tmpStatus);
+   }
+
+   RGB2YCBCR_DSP_MutexDelete(queue.mutex);
+
+   RGB2YCBCR_DSP_0Print ("====================================================\n") ;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_MainStream
+ *
+ *  @desc   Entry point for the application when the data is streamed
+ *          through the pipeline by the caller's fill and drain functions.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_MainStream(
+   IN Char8  * dspExecutable,
+   IN Uint32   dataSize,
+   IN Char8  * strBufferSize,
+   IN Char8  * strNumIterations,
+   IN Char8  * strNumBuffers,
+   IN Char8  * strNumDspBuffers,
+   IN Char8  * strProcessorId,
+   IN RGB2YCBCR_DSP_ChunkFxn fillFxn,
+   IN RGB2YCBCR_DSP_ChunkFxn drainFxn,
+   IN Pvoid    arg)
+{
+   DSP_STATUS status      = DSP_SOK;
+   Uint8      processorId = 0;
+
+   RGB2YCBCR_DSP_0Print("=============== tecSat Application : RGB2YCBCR_DSP ==========\n");
+
+   if ((dspExecutable != NULL) && (fillFxn != NULL) && (drainFxn != NULL) && (dataSize != 0) &&
+       (strBufferSize != NULL) && (strNumIterations != NULL) && (strNumBuffers != NULL) &&
+       (strNumDspBuffers != NULL) && (strProcessorId != NULL)) {
+      status = RGB2YCBCR_DSP_Setup(strBufferSize,
+                                   strNumIterations,
+                                   strNumBuffers,
+                                   strNumDspBuffers,
+                                   strProcessorId,
+                                   &processorId);
+
+      if (DSP_SUCCEEDED(status)) {
+         RGB2YCBCR_DSP_1Print ("==== Executing tecSat sample for DSP processor Id %d ====\n", processorId);
+
+         status = RGB2YCBCR_DSP_Create(dspExecutable, strBufferSize, strNumIterations, strNumDspBuffers, processorId);
+
+         /*
+          *  Execute the data transfer rgb2ycbcr-dsp.
+          */
+         if (DSP_SUCCEEDED(status)) {
+            status = RGB2YCBCR_DSP_ExecuteStream(RGB2YCBCR_DSP_NumIterations, dataSize, fillFxn, drainFxn, arg, processorId);
+         }
+
+         /*
+          *  Perform cleanup operation.
+          */
+         RGB2YCBCR_DSP_Delete(processorId);
+      }
+   }
+   else {
+      status = DSP_EINVALIDARG;
+      RGB2YCBCR_DSP_0Print("ERROR! Invalid arguments specified for while executing "
+                            "rgb2ycbcr-dsp application\n") ;
+   }
+
+   RGB2YCBCR_DSP_0Print ("====================================================\n") ;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_MainInPlace
+ *
+ *  @desc   Entry point for the application when the frame lives in channel
+ *          buffers. The frame is loaded straight into the buffers and
+ *          stored from the buffers the DSP returns, without copies on the
+ *          GPP.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_MainInPlace(
+   IN Char8  * dspExecutable,
+   IN Uint32   dataSize,
+   IN Char8  * strBufferSize,
+   IN Char8  * strNumIterations,
+   IN Char8  * strNumBuffers,
+   IN Char8  * strNumDspBuffers,
+   IN Char8  * strProcessorId,
+   IN Char8 ** chunks,
+   IN RGB2YCBCR_DSP_FrameFxn loadFxn,
+   IN RGB2YCBCR_DSP_FrameFxn storeFxn,
+   IN Pvoid    arg)
+{
+   DSP_STATUS status      = DSP_SOK;
+   Uint8      processorId = 0;
+
+   RGB2YCBCR_DSP_0Print("=============== tecSat Application : RGB2YCBCR_DSP ==========\n");
+
+   if ((dspExecutable != NULL) && (chunks != NULL) && (loadFxn != NULL) && (dataSize != 0) &&
+       (storeFxn != NULL) && (strBufferSize != NULL) && (strNumIterations != NULL) &&
+       (strNumBuffers != NULL) && (strNumDspBuffers != NULL) && (strProcessorId != NULL)) {
+      status = RGB2YCBCR_DSP_Setup(strBufferSize,
+                                   strNumIterations,
+                                   strNumBuffers,
+                                   strNumDspBuffers,
+                                   strProcessorId,
+                                   &processorId);
+
+      if (DSP_SUCCEEDED(status)) {
+         RGB2YCBCR_DSP_1Print ("==== Executing tecSat sample for DSP processor Id %d ====\n", processorId);
+
+         /* The pool must hold the whole frame */
+         RGB2YCBCR_DSP_NumFrameBuffers = RGB2YCBCR_DSP_NumIterations;
+
+         status = RGB2YCBCR_DSP_Create(dspExecutable, strBufferSize, strNumIterations, strNumDspBuffers, processorId);
+
+         if (DSP_SUCCEEDED(status)) {
+            status = RGB2YCBCR_DSP_AllocateFrame(chunks, RGB2YCBCR_DSP_NumIterations, processorId);
+
+            if (DSP_SUCCEEDED(status)) {
+               status = loadFxn(arg, chunks, RGB2YCBCR_DSP_NumIterations, RGB2YCBCR_DSP_ChunkSize);
+
+               /*
+                *  Execute the data transfer rgb2ycbcr-dsp.
+                */
+               if (DSP_SUCCEEDED(status)) {
+                  status = RGB2YCBCR_DSP_ExecuteInPlace(RGB2YCBCR_DSP_NumIterations, dataSize, chunks, processorId);
+               }
+
+               if (DSP_SUCCEEDED(status)) {
+                  status = storeFxn(arg, chunks, RGB2YCBCR_DSP_NumIterations, RGB2YCBCR_DSP_ChunkSize);
+               }
+
+               RGB2YCBCR_DSP_FreeFrame(chunks, RGB2YCBCR_DSP_NumIterations, processorId);
+            }
+         }
+
+         /*
+          *  Perform cleanup operation.
+          */
+         RGB2YCBCR_DSP_Delete(processorId);
+         RGB2YCBCR_DSP_NumFrameBuffers = 0;
+      }
+   }
+   else {
+      status = DSP_EINVALIDARG;
+      RGB2YCBCR_DSP_0Print("ERROR! Invalid arguments specified for while executing "
+                            "rgb2ycbcr-dsp application\n") ;
+   }
+
+   RGB2YCBCR_DSP_0Print ("====================================================\n") ;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_SessionCreate
+ *
+ *  @desc   Creates the session. The DSP is loaded with zero transfers, which
+ *          makes it loop until RGB2YCBCR_DSP_SessionDelete ().
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_SessionCreate(
+   IN  Char8 * dspExecutable,
+   IN  Char8 * strBufferSize,
+   IN  Char8 * strNumBuffers,
+   IN  Char8 * strNumDspBuffers,
+   IN  Char8 * strProcessorId,
+   OUT Uint8 * processorId)
+{
+   DSP_STATUS status = DSP_SOK;
+
+   RGB2YCBCR_DSP_0Print("=============== tecSat Session : RGB2YCBCR_DSP ==============\n");
+
+   if ((dspExecutable == NULL) || (strBufferSize == NULL) || (strNumBuffers == NULL) ||
+       (strNumDspBuffers == NULL) || (strProcessorId == NULL) || (processorId == NULL)) {
+      RGB2YCBCR_DSP_0Print("ERROR! Invalid arguments specified for the session\n");
+      return DSP_EINVALIDARG;
+   }
+
+   /* The number of chunks changes with every data stream */
+   status = RGB2YCBCR_DSP_Setup(strBufferSize,
+                                "1",
+                                strNumBuffers,
+                                strNumDspBuffers,
+                                strProcessorId,
+                                processorId);
+
+   if (DSP_SUCCEEDED(status)) {
+      status = RGB2YCBCR_DSP_Create(dspExecutable, strBufferSize, "0", strNumDspBuffers, *processorId);
+
+      if (DSP_SUCCEEDED(status)) {
+         status = RGB2YCBCR_DSP_Start(*processorId);
+      }
+
+      if (DSP_FAILED(status)) {
+         RGB2YCBCR_DSP_Delete(*processorId);
+      }
+   }
+
+   return status;
 }
 
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_SessionConvert
+ *
+ *  @desc   Runs the execute phase over the data stream.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_SessionConvert(
+   IN Char8 * dataStream,
+   IN Uint32  dataSize,
+   IN Uint8   processorId)
+{
+   Uint32 numIterations;
+
+   if ((dataStream == NULL) || (dataSize == 0)) {
+      return DSP_EINVALIDARG;
+   }
+
+   numIterations = (dataSize + RGB2YCBCR_DSP_ChunkSize - 1) / RGB2YCBCR_DSP_ChunkSize;
+
+   return RGB2YCBCR_DSP_Execute(numIterations, dataStream, dataSize, processorId);
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_SessionDelete
+ *
+ *  @desc   Sends a buffer with the RGB2YCBCR_DSP_ARG_END arg so the DSP
+ *          leaves its loop, then runs the delete phase.
+ *
+ *  @modif  RGB2YCBCR_DSP_Contexts
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_SessionDelete(
+   IN Uint8 processorId)
+{
+   RGB2YCBCR_DSP_SendEnd(&RGB2YCBCR_DSP_Contexts [processorId]);
+
+   RGB2YCBCR_DSP_Delete(processorId);
+
+   RGB2YCBCR_DSP_0Print ("====================================================\n") ;
+}
+
+
 #if defined (__cplusplus)
 }
 #endif /* defined (__cplusplus) */
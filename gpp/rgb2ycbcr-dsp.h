@@ -65,6 +65,291 @@ extern "C" {
 #define CHNL_ID_INPUT      1
 
 
+/** ============================================================================
+ *  @const  RGB2YCBCR_DSP_ARG_DATA, RGB2YCBCR_DSP_ARG_END
+ *
+ *  @desc   Values passed as the arg of a buffer sent to the DSP. A buffer
+ *          with RGB2YCBCR_DSP_ARG_END is sent back unconverted and ends a
+ *          session. They must match the ones in dsp/rgb2ycbcr-dsp_config.h.
+ *  ============================================================================
+ */
+#define RGB2YCBCR_DSP_ARG_DATA 0
+#define RGB2YCBCR_DSP_ARG_END  0xE0D
+
+
+/** ============================================================================
+ *  @const  RGB2YCBCR_DSP_FORMAT_PACKED, RGB2YCBCR_DSP_FORMAT_I444,
+ *          RGB2YCBCR_DSP_FORMAT_I420, RGB2YCBCR_DSP_FORMAT_NV12,
+ *          RGB2YCBCR_DSP_FORMAT_I422
+ *
+ *  @desc   Layouts of the converted frame. PACKED keeps Y, Cb, Cr
+ *          interleaved. The other ones are a Y plane followed by Cb and Cr
+ *          planes, full size for I444, one sample per 2x1 pixels for I422,
+ *          one per 2x2 pixels for I420 and as a single plane of Cb, Cr
+ *          pairs for NV12. The DSP is given the format on load and sends
+ *          back only the bytes of the planes. They must match the ones in
+ *          dsp/rgb2ycbcr-dsp_config.h.
+ *  ============================================================================
+ */
+#define RGB2YCBCR_DSP_FORMAT_PACKED 0
+#define RGB2YCBCR_DSP_FORMAT_I444   1
+#define RGB2YCBCR_DSP_FORMAT_I420   2
+#define RGB2YCBCR_DSP_FORMAT_NV12   3
+#define RGB2YCBCR_DSP_FORMAT_I422   4
+
+
+/** ============================================================================
+ *  @const  RGB2YCBCR_DSP_FILTER_DROP, RGB2YCBCR_DSP_FILTER_AVG2,
+ *          RGB2YCBCR_DSP_FILTER_BOX
+ *
+ *  @desc   Chroma filters of the subsampled formats. DROP keeps the top
+ *          left pixel, AVG2 averages the two rows of I420 and NV12 or the
+ *          two columns of I422, BOX averages every pixel a sample covers.
+ *          They must match the ones in dsp/rgb2ycbcr-dsp_config.h.
+ *  ============================================================================
+ */
+#define RGB2YCBCR_DSP_FILTER_DROP   0
+#define RGB2YCBCR_DSP_FILTER_AVG2   1
+#define RGB2YCBCR_DSP_FILTER_BOX    2
+
+
+/** ============================================================================
+ *  @const  RGB2YCBCR_DSP_COLOR_XXX
+ *
+ *  @desc   Colorimetries the pixels can be converted with. LEGACY is the
+ *          matrix this sample has always used. The other ones are the
+ *          BT.601, BT.709 and BT.2020 matrices, with Y in 16..235 and
+ *          chroma in 16..240 (limited), or every level used (FULL).
+ *          They must match the ones in dsp/rgb2ycbcr-dsp_config.h.
+ *  ============================================================================
+ */
+#define RGB2YCBCR_DSP_COLOR_LEGACY       0
+#define RGB2YCBCR_DSP_COLOR_BT601        1
+#define RGB2YCBCR_DSP_COLOR_BT601_FULL   2
+#define RGB2YCBCR_DSP_COLOR_BT709        3
+#define RGB2YCBCR_DSP_COLOR_BT709_FULL   4
+#define RGB2YCBCR_DSP_COLOR_BT2020       5
+#define RGB2YCBCR_DSP_COLOR_BT2020_FULL  6
+
+
+/** ============================================================================
+ *  @const  RGB2YCBCR_DSP_DIR_FORWARD, RGB2YCBCR_DSP_DIR_INVERSE
+ *
+ *  @desc   Direction of the conversion, R, G, B to Y, Cb, Cr or back. The
+ *          inverse reads and writes packed pixels only. They must match
+ *          the ones in dsp/rgb2ycbcr-dsp_config.h.
+ *  ============================================================================
+ */
+#define RGB2YCBCR_DSP_DIR_FORWARD   0
+#define RGB2YCBCR_DSP_DIR_INVERSE   1
+
+
+/** ============================================================================
+ *  @const  RGB2YCBCR_DSP_MAX_PLANES
+ *
+ *  @desc   Largest number of planes of a format.
+ *  ============================================================================
+ */
+#define RGB2YCBCR_DSP_MAX_PLANES    3
+
+
+/** ============================================================================
+ *  @const  MAX_PIPELINE_DEPTH
+ *
+ *  @desc   Maximum number of buffers kept in flight between GPP and DSP.
+ *  ============================================================================
+ */
+#define MAX_PIPELINE_DEPTH 16
+
+
+/** ============================================================================
+ *  @const  DEFAULT_PIPELINE_DEPTH
+ *
+ *  @desc   Number of buffers kept in flight when none is given. A depth of
+ *          1 sends a chunk and waits for it to come back before the next.
+ *  ============================================================================
+ */
+#define DEFAULT_PIPELINE_DEPTH 1
+
+
+/** ============================================================================
+ *  @const  DEFAULT_DSP_BUFFERS
+ *
+ *  @desc   Number of buffers the DSP streams through when none is given.
+ *  ============================================================================
+ */
+#define DEFAULT_DSP_BUFFERS 1
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_FrameFxn
+ *
+ *  @desc   Signature of the functions that load a frame into, or store a
+ *          frame from, the channel buffers given to
+ *          RGB2YCBCR_DSP_MainInPlace ().
+ *
+ *  @arg    arg
+ *              Argument given to RGB2YCBCR_DSP_MainInPlace ().
+ *
+ *  @arg    chunks
+ *              Channel buffers holding the frame, one chunk each.
+ *
+ *  @arg    numChunks
+ *              Number of entries in chunks.
+ *
+ *  @arg    chunkSize
+ *              Number of bytes of data in every chunk but the last one.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EFAIL
+ *              The frame could not be loaded or stored.
+ *  ============================================================================
+ */
+typedef DSP_STATUS (*RGB2YCBCR_DSP_FrameFxn) (
+   IN Pvoid    arg,
+   IN Char8 ** chunks,
+   IN Uint32   numChunks,
+   IN Uint32   chunkSize);
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_ChunkFxn
+ *
+ *  @desc   Signature of the functions that fill a channel buffer with the
+ *          next chunk, or drain a converted chunk from it, for
+ *          RGB2YCBCR_DSP_ExecuteStream (). Chunks are filled and drained in
+ *          order.
+ *
+ *  @arg    arg
+ *              Argument given to RGB2YCBCR_DSP_ExecuteStream ().
+ *
+ *  @arg    buffer
+ *              Channel buffer to fill or drain.
+ *
+ *  @arg    index
+ *              Index of the chunk in the stream.
+ *
+ *  @arg    size
+ *              Number of bytes of data in the chunk. It is the chunk size
+ *              for all chunks but the last one, which may be shorter.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EFAIL
+ *              The chunk could not be filled or drained.
+ *  ============================================================================
+ */
+typedef DSP_STATUS (*RGB2YCBCR_DSP_ChunkFxn) (
+   IN Pvoid    arg,
+   IN Char8  * buffer,
+   IN Uint32   index,
+   IN Uint32   size);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_SetFormat
+ *
+ *  @desc   Selects the layout RGB2YCBCR_DSP_Main () converts the next frame
+ *          to. With a planar format the DSP writes the planes of each
+ *          chunk and the GPP places them in the planes of the output frame,
+ *          so the data stream is left as it was. I422 needs an even width
+ *          and chunks of whole rows, I420 and NV12 even dimensions and
+ *          chunks of whole pairs of rows.
+ *
+ *  @arg    format
+ *              One of RGB2YCBCR_DSP_FORMAT_XXX.
+ *
+ *  @arg    filter
+ *              Chroma filter of the subsampled formats, one of
+ *              RGB2YCBCR_DSP_FILTER_XXX.
+ *
+ *  @arg    width
+ *              Width of the frame in pixels.
+ *
+ *  @arg    height
+ *              Height of the frame in pixels.
+ *
+ *  @arg    output
+ *              Buffer receiving the planes, as large as the planes
+ *              RGB2YCBCR_DSP_PlaneSizes () gives for the frame. Ignored for
+ *              RGB2YCBCR_DSP_FORMAT_PACKED.
+ *
+ *  @ret    DSP_SOK
+ *              The format is used from now on.
+ *          DSP_EINVALIDARG
+ *              Unknown format or filter, dimensions the format can not be
+ *              used with, or a planar format with the inverse direction.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_Main, RGB2YCBCR_DSP_PlaneSizes
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_SetFormat(
+   IN Uint32   format,
+   IN Uint32   filter,
+   IN Uint32   width,
+   IN Uint32   height,
+   IN Char8  * output);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_SetColorimetry
+ *
+ *  @desc   Selects the matrix the pixels are converted with, on the GPP
+ *          kernels and on the DSP. The DSP is given it when it is loaded,
+ *          so it applies from the next RGB2YCBCR_DSP_Create () on.
+ *
+ *  @arg    colorimetry
+ *              One of RGB2YCBCR_DSP_COLOR_XXX.
+ *
+ *  @ret    DSP_SOK
+ *              The matrix is used from now on.
+ *          DSP_EINVALIDARG
+ *              The colorimetry is unknown or not built in.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_Create, RGB2YCBCR_DSP_SelectMatrix
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_SetColorimetry(
+   IN Uint32   colorimetry);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_SetDirection
+ *
+ *  @desc   Selects whether the DSP converts R, G, B to Y, Cb, Cr or Y, Cb,
+ *          Cr back to R, G, B, with the inverse of the colorimetry
+ *          selected. The DSP is given it when it is loaded, so it applies
+ *          from the next RGB2YCBCR_DSP_Create () on. The inverse works on
+ *          packed pixels only.
+ *
+ *  @arg    direction
+ *              One of RGB2YCBCR_DSP_DIR_XXX.
+ *
+ *  @ret    DSP_SOK
+ *              The direction is used from now on.
+ *          DSP_EINVALIDARG
+ *              Unknown direction, or inverse with a planar format.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_Create, RGB2YCBCR_DSP_SetFormat
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_SetDirection(
+   IN Uint32   direction);
+
+
 /** ============================================================================
  *  @func   RGB2YCBCR_DSP_Create
  *
@@ -81,6 +366,9 @@ extern "C" {
  *              Number of iterations a data buffer is transferred between
  *              GPP and DSP in string format.
  *
+ *  @arg    strNumDspBuffers
+ *              Number of buffers the DSP streams through in string format.
+ *
  *  @arg    processorId
  *             Id of the DSP Processor. 
  *
@@ -100,6 +388,7 @@ NORMAL_API DSP_STATUS RGB2YCBCR_DSP_Create(
    IN Char8  * dspExecutable,
    IN Char8  * strBufferSize,
    IN Char8  * strNumIterations,
+   IN Char8  * strNumDspBuffers,
    IN Uint8    processorId);
 
 
@@ -107,12 +396,24 @@ NORMAL_API DSP_STATUS RGB2YCBCR_DSP_Create(
  *  @func   RGB2YCBCR_DSP_Execute
  *
  *  @desc   This function implements the execute phase for this application.
+ *          Chunks of the data stream are pipelined through the buffers
+ *          allocated on create phase.
  *
  *  @ret    DSP_SOK
  *              Operation Successfully completed.
  *          DSP_EFAIL
  *              Execution failed.
  *
+ *  @arg    numIterations
+ *              Number of chunks the data stream is split into.
+ *
+ *  @arg    dataStream
+ *              Data to convert, results are written back in place.
+ *
+ *  @arg    dataSize
+ *              Size of the data stream in bytes. Only this many bytes are
+ *              read and written, the last chunk carries what is left.
+ *
  *  @arg    processorId
  *             Id of the DSP Processor. 
  *
@@ -128,9 +429,160 @@ NORMAL_API DSP_STATUS RGB2YCBCR_DSP_Create(
 NORMAL_API DSP_STATUS RGB2YCBCR_DSP_Execute(
    IN Uint32 numIterations,
    IN Char8  * dataStream,
-   IN Uint32 bufferSize,
+   IN Uint32 dataSize,
    Uint8     processorId);
 
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ExecuteStream
+ *
+ *  @desc   This function implements the execute phase when chunks are
+ *          produced and consumed on the fly. Each buffer is filled by
+ *          fillFxn right before it is sent and drained by drainFxn as soon
+ *          as it comes back, so only the buffers in flight hold data.
+ *
+ *  @arg    numIterations
+ *              Number of chunks in the stream.
+ *
+ *  @arg    dataSize
+ *              Size of the stream in bytes, the last chunk is sent with
+ *              what is left.
+ *
+ *  @arg    fillFxn
+ *              Fills a buffer with the next chunk.
+ *
+ *  @arg    drainFxn
+ *              Consumes a converted chunk.
+ *
+ *  @arg    arg
+ *              Argument passed to fillFxn and drainFxn.
+ *
+ *  @arg    processorId
+ *             Id of the DSP Processor. 
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EFAIL
+ *              Execution failed.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_Execute
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_ExecuteStream(
+   IN Uint32                 numIterations,
+   IN Uint32                 dataSize,
+   IN RGB2YCBCR_DSP_ChunkFxn fillFxn,
+   IN RGB2YCBCR_DSP_ChunkFxn drainFxn,
+   IN Pvoid                  arg,
+   IN Uint8                  processorId);
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ExecuteInPlace
+ *
+ *  @desc   This function implements the execute phase when the frame already
+ *          lives in channel buffers allocated by RGB2YCBCR_DSP_AllocateFrame.
+ *          No data is copied on the GPP.
+ *
+ *  @arg    numChunks
+ *              Number of chunks the frame is split into.
+ *
+ *  @arg    dataSize
+ *              Size of the frame in bytes, the last chunk is sent with
+ *              what is left.
+ *
+ *  @arg    chunks
+ *              Channel buffers holding the frame. On return each entry
+ *              points to the buffer holding the converted chunk, which may
+ *              not be the buffer that was sent.
+ *
+ *  @arg    processorId
+ *             Id of the DSP Processor. 
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EFAIL
+ *              Execution failed.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_AllocateFrame , RGB2YCBCR_DSP_Execute
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_ExecuteInPlace(
+   IN     Uint32   numChunks,
+   IN     Uint32   dataSize,
+   IN OUT Char8 ** chunks,
+   IN     Uint8    processorId);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_AllocateFrame
+ *
+ *  @desc   Allocates channel buffers to hold a whole frame. The pool must
+ *          have been opened with room for them.
+ *
+ *  @arg    chunks
+ *              Array receiving the buffers.
+ *
+ *  @arg    numChunks
+ *              Number of buffers to allocate.
+ *
+ *  @arg    processorId
+ *             Id of the DSP Processor. 
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EMEMORY
+ *              Not enough buffers in the pool.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_FreeFrame
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_AllocateFrame(
+   OUT Char8 ** chunks,
+   IN  Uint32   numChunks,
+   IN  Uint8    processorId);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_FreeFrame
+ *
+ *  @desc   Frees the channel buffers holding a frame.
+ *
+ *  @arg    chunks
+ *              Buffers to free.
+ *
+ *  @arg    numChunks
+ *              Number of buffers to free.
+ *
+ *  @arg    processorId
+ *             Id of the DSP Processor. 
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_AllocateFrame
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_FreeFrame(
+   IN Char8 ** chunks,
+   IN Uint32   numChunks,
+   IN Uint8    processorId);
+
+
 /** ============================================================================
  *  @func   RGB2YCBCR_DSP_Delete
  *
@@ -165,6 +617,10 @@ NORMAL_API Void RGB2YCBCR_DSP_Delete(
  *  @func   RGB2YCBCR_DSP_Main
  *
  *  @desc   The OS independent driver function for the rgb2ycbcr-dsp application.
+ *          Given several processors, the chunks of the frame are split in
+ *          contiguous shares, one per processor, and converted on all of
+ *          them at once. Every processor has its own channel pair and pool
+ *          and the chunks are put back at their place in the frame.
  *
  *  @arg    dspExecutable
  *              Name of the DSP executable file.
@@ -182,8 +638,15 @@ NORMAL_API Void RGB2YCBCR_DSP_Delete(
  *              Number of iterations a data buffer is transferred between
  *              GPP and DSP in string format.
  *
+ *  @arg    strNumBuffers
+ *              Depth of the transfer pipeline in string format.
+ *
+ *  @arg    strNumDspBuffers
+ *              Number of buffers the DSP streams through in string format.
+ *
  *  @arg    strProcessorId
- *             Id of the DSP Processor in string format. 
+ *             Id of the DSP Processor in string format, or a comma
+ *             separated list of ids such as "0,1" to share the frame.
  *
  *  @ret    DSP_SOK
  *
@@ -200,8 +663,299 @@ NORMAL_API Void RGB2YCBCR_DSP_Main(
    IN Uint32   dataSize,
    IN Char8  * strBufferSize,
    IN Char8  * strNumIterations,
+   IN Char8  * strNumBuffers,
+   IN Char8  * strNumDspBuffers,
    IN Char8  * strProcessorId);
 
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_MainHybrid
+ *
+ *  @desc   Converts the frame on the DSPs and the GPP at once. The chunks
+ *          are handed out from a shared queue, each engine taking the next
+ *          one when it is free, so the split follows the speed of each.
+ *          The chunks, bytes and throughput of every engine are printed at
+ *          the end of the run.
+ *
+ *  @arg    dspExecutable
+ *              Name of the DSP executable file.
+ *
+ *  @arg    dataStream
+ *              Pointer to data to stream
+ *
+ *  @arg    dataSize
+ *              Size data to stream
+ *
+ *  @arg    strBufferSize
+ *              Size of the Buffer to use.
+ *
+ *  @arg    strNumIterations
+ *              Number of chunks in the data in string format.
+ *
+ *  @arg    strNumBuffers
+ *              Depth of the transfer pipeline in string format.
+ *
+ *  @arg    strNumDspBuffers
+ *              Number of buffers the DSP streams through in string format.
+ *
+ *  @arg    strProcessorId
+ *             Id of the DSP Processor in string format, or a comma
+ *             separated list of ids such as "0,1".
+ *
+ *  @arg    kernelName
+ *             Name of the GPP kernel, as RGB2YCBCR_DSP_GetKernel () takes.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_Main, RGB2YCBCR_DSP_GetKernel
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_MainHybrid(
+   IN Char8  * dspExecutable,
+   IN Char8  * dataStream,
+   IN Uint32   dataSize,
+   IN Char8  * strBufferSize,
+   IN Char8  * strNumIterations,
+   IN Char8  * strNumBuffers,
+   IN Char8  * strNumDspBuffers,
+   IN Char8  * strProcessorId,
+   IN Char8  * kernelName);
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_MainStream
+ *
+ *  @desc   The OS independent driver function for the rgb2ycbcr-dsp
+ *          application when the data is streamed. Chunks are produced by
+ *          fillFxn as the pipeline has room for them and handed to drainFxn
+ *          as they come back, so memory use depends on the pipeline depth
+ *          and not on the size of the data.
+ *
+ *  @arg    dspExecutable
+ *              Name of the DSP executable file.
+ *
+ *  @arg    dataSize
+ *              Size of the data in bytes.
+ *
+ *  @arg    strBufferSize
+ *              Size of each chunk buffer.
+ *
+ *  @arg    strNumIterations
+ *              Number of chunks in string format.
+ *
+ *  @arg    strNumBuffers
+ *              Depth of the transfer pipeline in string format.
+ *
+ *  @arg    strNumDspBuffers
+ *              Number of buffers the DSP streams through in string format.
+ *
+ *  @arg    strProcessorId
+ *             Id of the DSP Processor in string format. 
+ *
+ *  @arg    fillFxn
+ *              Fills a buffer with the next chunk.
+ *
+ *  @arg    drainFxn
+ *              Consumes a converted chunk.
+ *
+ *  @arg    arg
+ *              Argument passed to fillFxn and drainFxn.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_ExecuteStream
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_MainStream(
+   IN Char8  * dspExecutable,
+   IN Uint32   dataSize,
+   IN Char8  * strBufferSize,
+   IN Char8  * strNumIterations,
+   IN Char8  * strNumBuffers,
+   IN Char8  * strNumDspBuffers,
+   IN Char8  * strProcessorId,
+   IN RGB2YCBCR_DSP_ChunkFxn fillFxn,
+   IN RGB2YCBCR_DSP_ChunkFxn drainFxn,
+   IN Pvoid    arg);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_MainInPlace
+ *
+ *  @desc   The OS independent driver function for the rgb2ycbcr-dsp
+ *          application when the frame is converted in place. The frame is
+ *          loaded straight into channel buffers and stored from the buffers
+ *          the DSP returns.
+ *
+ *  @arg    dspExecutable
+ *              Name of the DSP executable file.
+ *
+ *  @arg    dataSize
+ *              Size of the data in bytes.
+ *
+ *  @arg    strBufferSize
+ *              Size of each chunk buffer.
+ *
+ *  @arg    strNumIterations
+ *              Number of chunks the frame is split into in string format.
+ *
+ *  @arg    strNumBuffers
+ *              Number of chunks kept in flight in string format.
+ *
+ *  @arg    strNumDspBuffers
+ *              Number of buffers the DSP streams through in string format.
+ *
+ *  @arg    strProcessorId
+ *             Id of the DSP Processor in string format. 
+ *
+ *  @arg    chunks
+ *              Array of strNumIterations entries for the chunk buffers.
+ *
+ *  @arg    loadFxn
+ *              Function filling the chunk buffers with the frame.
+ *
+ *  @arg    storeFxn
+ *              Function storing the converted frame from the chunk buffers.
+ *
+ *  @arg    arg
+ *              Argument given to loadFxn and storeFxn.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_Main, RGB2YCBCR_DSP_ExecuteInPlace
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_MainInPlace(
+   IN Char8  * dspExecutable,
+   IN Uint32   dataSize,
+   IN Char8  * strBufferSize,
+   IN Char8  * strNumIterations,
+   IN Char8  * strNumBuffers,
+   IN Char8  * strNumDspBuffers,
+   IN Char8  * strProcessorId,
+   IN Char8 ** chunks,
+   IN RGB2YCBCR_DSP_FrameFxn loadFxn,
+   IN RGB2YCBCR_DSP_FrameFxn storeFxn,
+   IN Pvoid    arg);
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_SessionCreate
+ *
+ *  @desc   Loads the DSP executable, opens the pool and the channels and
+ *          starts the DSP once for many conversions. The DSP is told to
+ *          loop until the session is deleted. There is a single session per
+ *          process, and the other entry points must not be used while it
+ *          is open.
+ *
+ *  @arg    dspExecutable
+ *              DSP executable name.
+ *
+ *  @arg    strBufferSize
+ *              String representation of the chunk size in bytes.
+ *
+ *  @arg    strNumBuffers
+ *              String representation of the number of buffers kept in
+ *              flight.
+ *
+ *  @arg    strNumDspBuffers
+ *              String representation of the number of buffers the DSP
+ *              streams through.
+ *
+ *  @arg    strProcessorId
+ *              String representation of the DSP processor Id.
+ *
+ *  @arg    processorId
+ *              Location to receive the DSP processor Id.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EFAIL
+ *              The session could not be opened. Nothing is left allocated.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_SessionConvert, RGB2YCBCR_DSP_SessionDelete
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_SessionCreate(
+   IN  Char8 * dspExecutable,
+   IN  Char8 * strBufferSize,
+   IN  Char8 * strNumBuffers,
+   IN  Char8 * strNumDspBuffers,
+   IN  Char8 * strProcessorId,
+   OUT Uint8 * processorId);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_SessionConvert
+ *
+ *  @desc   Converts a data stream on the DSP of an open session. The
+ *          stream is split into chunks of the session buffer size, the last
+ *          one carrying what is left, so the stream needs no padding.
+ *
+ *  @arg    dataStream
+ *              Data to convert, results are written back in place.
+ *
+ *  @arg    dataSize
+ *              Size of the data stream in bytes.
+ *
+ *  @arg    processorId
+ *              Id of the DSP Processor.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EINVALIDARG
+ *              No data to convert.
+ *          DSP_EFAIL
+ *              Execution failed.
+ *
+ *  @enter  RGB2YCBCR_DSP_SessionCreate () succeeded.
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_SessionCreate
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_SessionConvert(
+   IN Char8 * dataStream,
+   IN Uint32  dataSize,
+   IN Uint8   processorId);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_SessionDelete
+ *
+ *  @desc   Sends the end of session to the DSP, waits for it to come back
+ *          and releases everything RGB2YCBCR_DSP_SessionCreate () set up.
+ *
+ *  @arg    processorId
+ *              Id of the DSP Processor.
+ *
+ *  @ret    None
+ *
+ *  @enter  RGB2YCBCR_DSP_SessionCreate () succeeded.
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_SessionCreate
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_SessionDelete(
+   IN Uint8 processorId);
+
+
 /** ============================================================================
  *  @func   RGB2YCBCR_DSP_0Print
  *
@@ -0,0 +1,1186 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_cvt.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/
+ *
+ *  @desc   Color space conversion kernels running on the GPP. The scalar
+ *          reference repeats the DSP kernel arithmetic, the vector kernels
+ *          compute the same values several pixels at a time.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+/*  ----------------------------------- OS Specific Headers           */
+#include <stdlib.h>
+#include <string.h>
+#if defined (__ARM_NEON__) || defined (__ARM_NEON)
+#include <arm_neon.h>
+#define RGB2YCBCR_DSP_NEON
+#elif defined (__SSE2__)
+#include <emmintrin.h>
+#define RGB2YCBCR_DSP_SSE2
+#endif
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <rgb2ycbcr-dsp.h>
+#include <rgb2ycbcr-dsp_cvt.h>
+#include <rgb2ycbcr-dsp_coeffs.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  DIV100_MAGIC
+ *
+ *  @desc   Reciprocal of 100 scaled by 2^37. For any 32 bit n,
+ *          (n * DIV100_MAGIC) >> 37 is n / 100 rounded down, so the vector
+ *          kernels divide by 100 exactly without a divide instruction.
+ *  ============================================================================
+ */
+#define DIV100_MAGIC 0x51EB851F
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_Matrices
+ *
+ *  @desc   Matrix of each colorimetry, indexed by RGB2YCBCR_DSP_COLOR_XXX.
+ *          The values are in dsp/rgb2ycbcr-dsp_coeffs.h.
+ *  ============================================================================
+ */
+STATIC RGB2YCBCR_DSP_Matrix RGB2YCBCR_DSP_Matrices [] = {
+   RGB2YCBCR_DSP_MATRICES
+};
+
+#define NUM_MATRICES (sizeof (RGB2YCBCR_DSP_Matrices) / sizeof (RGB2YCBCR_DSP_Matrices [0]))
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_Inverses
+ *
+ *  @desc   Inverse matrix of each colorimetry, in Q12, indexed by
+ *          RGB2YCBCR_DSP_COLOR_XXX. The values are in
+ *          dsp/rgb2ycbcr-dsp_coeffs.h.
+ *  ============================================================================
+ */
+STATIC RGB2YCBCR_DSP_Matrix RGB2YCBCR_DSP_Inverses [] = {
+   RGB2YCBCR_DSP_INVERSES
+};
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_ColorNames
+ *
+ *  @desc   Names of the colorimetries, indexed by RGB2YCBCR_DSP_COLOR_XXX.
+ *  ============================================================================
+ */
+STATIC Char8 * RGB2YCBCR_DSP_ColorNames [] = {
+   "legacy",
+   "bt601",
+   "bt601-full",
+   "bt709",
+   "bt709-full",
+   "bt2020",
+   "bt2020-full"
+};
+
+#define NUM_COLORS (sizeof (RGB2YCBCR_DSP_ColorNames) / sizeof (RGB2YCBCR_DSP_ColorNames [0]))
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_CurrentMatrix, RGB2YCBCR_DSP_CurrentInverse
+ *
+ *  @desc   Matrices the kernels convert with.
+ *  ============================================================================
+ */
+STATIC RGB2YCBCR_DSP_Matrix * RGB2YCBCR_DSP_CurrentMatrix  = &RGB2YCBCR_DSP_Matrices [0];
+STATIC RGB2YCBCR_DSP_Matrix * RGB2YCBCR_DSP_CurrentInverse = &RGB2YCBCR_DSP_Inverses [0];
+
+
+/** ============================================================================
+ *  @name   INVERSE_BIAS
+ *
+ *  @desc   Rounding term of the inverse minus the input offsets a row of an
+ *          inverse matrix is applied to, as on the DSP.
+ *  ============================================================================
+ */
+#define INVERSE_BIAS(m, row) (2048 - (  ((m)->k [row][0] * (m)->c [0])     \
+                                      + ((m)->k [row][1] * (m)->c [1])     \
+                                      + ((m)->k [row][2] * (m)->c [2])))
+
+/** ============================================================================
+ *  @name   CLAMP_PIXEL
+ *
+ *  @desc   Clamps a result to a pixel level, as the saturating packs of the
+ *          vector kernels and of the DSP do.
+ *  ============================================================================
+ */
+#define CLAMP_PIXEL(v) (((v) < 0) ? 0 : (((v) > 255) ? 255 : (v)))
+
+
+#if defined (RGB2YCBCR_DSP_NEON)
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_ScaleNeon
+ *
+ *  @desc   Applies SCALE to four signed sums.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC int32x4_t RGB2YCBCR_DSP_ScaleNeon(
+   int32x4_t n)
+{
+#if defined (RGB2YCBCR_DSP_EXACT_DIV)
+   /* vqdmulh gives (2 * n * m) >> 32, the shift completes the >> 37 */
+   int32x4_t q = vshrq_n_s32(vqdmulhq_s32(n, vdupq_n_s32(DIV100_MAGIC)), 6);
+
+   /* Round towards zero for negative sums, as C division does */
+   return vsubq_s32(q, vshrq_n_s32(n, 31));
+#else /* if defined (RGB2YCBCR_DSP_EXACT_DIV) */
+   /* vrshr adds the rounding half before shifting */
+   return vrshrq_n_s32(n, 12);
+#endif /* if defined (RGB2YCBCR_DSP_EXACT_DIV) */
+}
+
+/** ----------------------------------------------------------------------------
+ *  @name   RGB2YCBCR_DSP_ROWNEON
+ *
+ *  @desc   Applies one row of the matrix to eight pixels and narrows the
+ *          results to bytes, saturating to 0..255.
+ *  ----------------------------------------------------------------------------
+ */
+#define RGB2YCBCR_DSP_ROWNEON(out, r, g, b, d1, d2, d3, c)                     \
+   do {                                                                        \
+      int32x4_t sumLo = vmull_n_s16(vget_low_s16(r), (d1));                    \
+      int32x4_t sumHi = vmull_n_s16(vget_high_s16(r), (d1));                   \
+      sumLo = vmlal_n_s16(sumLo, vget_low_s16(g), (d2));                       \
+      sumHi = vmlal_n_s16(sumHi, vget_high_s16(g), (d2));                      \
+      sumLo = vmlal_n_s16(sumLo, vget_low_s16(b), (d3));                       \
+      sumHi = vmlal_n_s16(sumHi, vget_high_s16(b), (d3));                      \
+      sumLo = vaddq_s32(RGB2YCBCR_DSP_ScaleNeon(sumLo), vdupq_n_s32(c));      \
+      sumHi = vaddq_s32(RGB2YCBCR_DSP_ScaleNeon(sumHi), vdupq_n_s32(c));      \
+      (out) = vqmovun_s16(vcombine_s16(vqmovn_s32(sumLo), vqmovn_s32(sumHi))); \
+   } while (0)
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_ConvertNeon
+ *
+ *  @desc   NEON kernel. vld3 splits eight pixels into unsigned R, G and B
+ *          vectors, the matrix is applied on 32 bit lanes and vqmovun
+ *          clamps Y, Cb and Cr on the way back to bytes before vst3
+ *          interleaves them.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_ConvertNeon(
+   IN OUT Char8 * buffer,
+   IN     Uint32  size)
+{
+   uint8_t *   pixels    = (uint8_t *) buffer;
+   Uint32      numPixels = size / 3;
+   Uint32      i;
+   uint8x8x3_t rgb;
+   uint8x8x3_t ycbcr;
+   int16x8_t   r, g, b;
+   RGB2YCBCR_DSP_Matrix * m = RGB2YCBCR_DSP_CurrentMatrix;
+
+   for (i = 0 ; (i + 8) <= numPixels ; i += 8) {
+      rgb = vld3_u8(pixels);
+      r   = vreinterpretq_s16_u16(vmovl_u8(rgb.val [0]));
+      g   = vreinterpretq_s16_u16(vmovl_u8(rgb.val [1]));
+      b   = vreinterpretq_s16_u16(vmovl_u8(rgb.val [2]));
+
+      RGB2YCBCR_DSP_ROWNEON(ycbcr.val [0], r, g, b, m->k [0][0], m->k [0][1], m->k [0][2], m->c [0]);
+      RGB2YCBCR_DSP_ROWNEON(ycbcr.val [1], r, g, b, m->k [1][0], m->k [1][1], m->k [1][2], m->c [1]);
+      RGB2YCBCR_DSP_ROWNEON(ycbcr.val [2], r, g, b, m->k [2][0], m->k [2][1], m->k [2][2], m->c [2]);
+
+      vst3_u8(pixels, ycbcr);
+      pixels += 24;
+   }
+
+   /* Pixels left over, and any partial pixel, go through the reference */
+   RGB2YCBCR_DSP_ConvertMatrix((Char8 *) pixels, size - (i * 3), m);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @name   RGB2YCBCR_DSP_INVNEON
+ *
+ *  @desc   Applies one row of an inverse matrix to eight pixels and
+ *          narrows the results to bytes, saturating to 0..255.
+ *  ----------------------------------------------------------------------------
+ */
+#define RGB2YCBCR_DSP_INVNEON(out, y, cb, cr, m, row)                          \
+   do {                                                                        \
+      int32x4_t bias  = vdupq_n_s32(INVERSE_BIAS(m, row));                     \
+      int32x4_t sumLo = vmlal_n_s16(bias, vget_low_s16(y), (m)->k [row][0]);   \
+      int32x4_t sumHi = vmlal_n_s16(bias, vget_high_s16(y), (m)->k [row][0]);  \
+      sumLo = vmlal_n_s16(sumLo, vget_low_s16(cb), (m)->k [row][1]);           \
+      sumHi = vmlal_n_s16(sumHi, vget_high_s16(cb), (m)->k [row][1]);          \
+      sumLo = vmlal_n_s16(sumLo, vget_low_s16(cr), (m)->k [row][2]);           \
+      sumHi = vmlal_n_s16(sumHi, vget_high_s16(cr), (m)->k [row][2]);          \
+      (out) = vqmovun_s16(vcombine_s16(vqmovn_s32(vshrq_n_s32(sumLo, 12)),     \
+                                       vqmovn_s32(vshrq_n_s32(sumHi, 12))));   \
+   } while (0)
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_InverseNeon
+ *
+ *  @desc   NEON inverse kernel. vld3 splits eight pixels into unsigned Y,
+ *          Cb and Cr vectors and vqmovun clamps the results on the way
+ *          back to bytes.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_InverseNeon(
+   IN OUT Char8 * buffer,
+   IN     Uint32  size)
+{
+   uint8_t *   pixels    = (uint8_t *) buffer;
+   Uint32      numPixels = size / 3;
+   Uint32      i;
+   uint8x8x3_t ycbcr;
+   uint8x8x3_t rgb;
+   int16x8_t   y, cb, cr;
+   RGB2YCBCR_DSP_Matrix * m = RGB2YCBCR_DSP_CurrentInverse;
+
+   for (i = 0 ; (i + 8) <= numPixels ; i += 8) {
+      ycbcr = vld3_u8(pixels);
+      y     = vreinterpretq_s16_u16(vmovl_u8(ycbcr.val [0]));
+      cb    = vreinterpretq_s16_u16(vmovl_u8(ycbcr.val [1]));
+      cr    = vreinterpretq_s16_u16(vmovl_u8(ycbcr.val [2]));
+
+      RGB2YCBCR_DSP_INVNEON(rgb.val [0], y, cb, cr, m, 0);
+      RGB2YCBCR_DSP_INVNEON(rgb.val [1], y, cb, cr, m, 1);
+      RGB2YCBCR_DSP_INVNEON(rgb.val [2], y, cb, cr, m, 2);
+
+      vst3_u8(pixels, rgb);
+      pixels += 24;
+   }
+
+   /* Pixels left over, and any partial pixel, go through the reference */
+   RGB2YCBCR_DSP_InverseMatrix((Char8 *) pixels, size - (i * 3), m);
+}
+#endif /* defined (RGB2YCBCR_DSP_NEON) */
+
+
+#if defined (RGB2YCBCR_DSP_SSE2)
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_ScaleSse2
+ *
+ *  @desc   Applies SCALE to four signed sums.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC __m128i RGB2YCBCR_DSP_ScaleSse2(
+   __m128i n)
+{
+#if defined (RGB2YCBCR_DSP_EXACT_DIV)
+   __m128i sign  = _mm_srai_epi32(n, 31);
+   __m128i abs   = _mm_sub_epi32(_mm_xor_si128(n, sign), sign);
+   __m128i magic = _mm_set1_epi32(DIV100_MAGIC);
+   __m128i even;
+   __m128i odd;
+
+   /* pmuludq only multiplies lanes 0 and 2, shift 1 and 3 down for it */
+   even = _mm_srli_epi64(_mm_mul_epu32(abs, magic), 37);
+   odd  = _mm_srli_epi64(_mm_mul_epu32(_mm_srli_epi64(abs, 32), magic), 37);
+
+   /* Put the sign back, which rounds towards zero as C division does */
+   return _mm_sub_epi32(_mm_xor_si128(_mm_or_si128(even, _mm_slli_epi64(odd, 32)), sign), sign);
+#else /* if defined (RGB2YCBCR_DSP_EXACT_DIV) */
+   return _mm_srai_epi32(_mm_add_epi32(n, _mm_set1_epi32(2048)), 12);
+#endif /* if defined (RGB2YCBCR_DSP_EXACT_DIV) */
+}
+
+/** ----------------------------------------------------------------------------
+ *  @name   RGB2YCBCR_DSP_PAIR
+ *
+ *  @desc   Two matrix coefficients packed as the 16 bit pair pmaddwd takes.
+ *  ----------------------------------------------------------------------------
+ */
+#define RGB2YCBCR_DSP_PAIR(lo, hi) \
+   _mm_set1_epi32((Int32) ((((Uint32) (hi)) << 16) | (((Uint32) (lo)) & 0xFFFF)))
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_ConvertSse2
+ *
+ *  @desc   SSE2 kernel. Four pixels are gathered into unsigned (R, G) and
+ *          (B, 0) 16 bit pairs so pmaddwd applies a matrix row in two
+ *          instructions, then the sums are scaled four at a time and
+ *          packssdw and packuswb clamp them to bytes.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_ConvertSse2(
+   IN OUT Char8 * buffer,
+   IN     Uint32  size)
+{
+   Uint8 * pixels    = (Uint8 *) buffer;
+   Uint32  numPixels = size / 3;
+   Uint32  i;
+   Uint32  k;
+   __m128i rg;
+   __m128i b0;
+   __m128i y;
+   __m128i cb;
+   __m128i cr;
+   Uint8   ycbcr [16];
+   RGB2YCBCR_DSP_Matrix * m = RGB2YCBCR_DSP_CurrentMatrix;
+
+   /* The coefficient pairs and offsets are made once per buffer */
+   const __m128i k1rg = RGB2YCBCR_DSP_PAIR(m->k [0][0], m->k [0][1]);
+   const __m128i k1b  = RGB2YCBCR_DSP_PAIR(m->k [0][2], 0);
+   const __m128i k2rg = RGB2YCBCR_DSP_PAIR(m->k [1][0], m->k [1][1]);
+   const __m128i k2b  = RGB2YCBCR_DSP_PAIR(m->k [1][2], 0);
+   const __m128i k3rg = RGB2YCBCR_DSP_PAIR(m->k [2][0], m->k [2][1]);
+   const __m128i k3b  = RGB2YCBCR_DSP_PAIR(m->k [2][2], 0);
+   const __m128i c1   = _mm_set1_epi32(m->c [0]);
+   const __m128i c2   = _mm_set1_epi32(m->c [1]);
+   const __m128i c3   = _mm_set1_epi32(m->c [2]);
+
+   for (i = 0 ; (i + 4) <= numPixels ; i += 4) {
+      rg = _mm_setr_epi16(pixels [0], pixels [1], pixels [3], pixels [4],
+                          pixels [6], pixels [7], pixels [9], pixels [10]);
+      b0 = _mm_setr_epi16(pixels [2], 0, pixels [5], 0,
+                          pixels [8], 0, pixels [11], 0);
+
+      y  = _mm_add_epi32(_mm_madd_epi16(rg, k1rg), _mm_madd_epi16(b0, k1b));
+      cb = _mm_add_epi32(_mm_madd_epi16(rg, k2rg), _mm_madd_epi16(b0, k2b));
+      cr = _mm_add_epi32(_mm_madd_epi16(rg, k3rg), _mm_madd_epi16(b0, k3b));
+      y  = _mm_add_epi32(RGB2YCBCR_DSP_ScaleSse2(y), c1);
+      cb = _mm_add_epi32(RGB2YCBCR_DSP_ScaleSse2(cb), c2);
+      cr = _mm_add_epi32(RGB2YCBCR_DSP_ScaleSse2(cr), c3);
+
+      /* Y0..Y3 Cb0..Cb3 Cr0..Cr3, each clamped to 0..255 */
+      _mm_storeu_si128((__m128i *) ycbcr,
+                       _mm_packus_epi16(_mm_packs_epi32(y, cb), _mm_packs_epi32(cr, cr)));
+
+      for (k = 0 ; k < 4 ; k++) {
+         pixels [0] = ycbcr [k];
+         pixels [1] = ycbcr [4 + k];
+         pixels [2] = ycbcr [8 + k];
+         pixels += 3;
+      }
+   }
+
+   /* Pixels left over, and any partial pixel, go through the reference */
+   RGB2YCBCR_DSP_ConvertMatrix((Char8 *) pixels, size - (i * 3), m);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_InverseSse2
+ *
+ *  @desc   SSE2 inverse kernel. Four pixels are gathered into (Y, Cb) and
+ *          (Cr, 0) pairs of unsigned levels for pmaddwd, and packssdw and
+ *          packuswb clamp the results to bytes.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_InverseSse2(
+   IN OUT Char8 * buffer,
+   IN     Uint32  size)
+{
+   Uint8 * pixels    = (Uint8 *) buffer;
+   Uint32  numPixels = size / 3;
+   Uint32  i;
+   Uint32  k;
+   __m128i ycb;
+   __m128i cr0;
+   __m128i r;
+   __m128i g;
+   __m128i b;
+   Uint8   rgb [16];
+   RGB2YCBCR_DSP_Matrix * m = RGB2YCBCR_DSP_CurrentInverse;
+
+   /* The coefficient pairs and biases are made once per buffer */
+   const __m128i k1yc  = RGB2YCBCR_DSP_PAIR(m->k [0][0], m->k [0][1]);
+   const __m128i k1r   = RGB2YCBCR_DSP_PAIR(m->k [0][2], 0);
+   const __m128i k2yc  = RGB2YCBCR_DSP_PAIR(m->k [1][0], m->k [1][1]);
+   const __m128i k2r   = RGB2YCBCR_DSP_PAIR(m->k [1][2], 0);
+   const __m128i k3yc  = RGB2YCBCR_DSP_PAIR(m->k [2][0], m->k [2][1]);
+   const __m128i k3r   = RGB2YCBCR_DSP_PAIR(m->k [2][2], 0);
+   const __m128i bias1 = _mm_set1_epi32(INVERSE_BIAS(m, 0));
+   const __m128i bias2 = _mm_set1_epi32(INVERSE_BIAS(m, 1));
+   const __m128i bias3 = _mm_set1_epi32(INVERSE_BIAS(m, 2));
+
+   for (i = 0 ; (i + 4) <= numPixels ; i += 4) {
+      ycb = _mm_setr_epi16(pixels [0], pixels [1], pixels [3], pixels [4],
+                           pixels [6], pixels [7], pixels [9], pixels [10]);
+      cr0 = _mm_setr_epi16(pixels [2], 0, pixels [5], 0,
+                           pixels [8], 0, pixels [11], 0);
+
+      r = _mm_add_epi32(_mm_madd_epi16(ycb, k1yc), _mm_madd_epi16(cr0, k1r));
+      g = _mm_add_epi32(_mm_madd_epi16(ycb, k2yc), _mm_madd_epi16(cr0, k2r));
+      b = _mm_add_epi32(_mm_madd_epi16(ycb, k3yc), _mm_madd_epi16(cr0, k3r));
+      r = _mm_srai_epi32(_mm_add_epi32(r, bias1), 12);
+      g = _mm_srai_epi32(_mm_add_epi32(g, bias2), 12);
+      b = _mm_srai_epi32(_mm_add_epi32(b, bias3), 12);
+
+      /* R0..R3 G0..G3 B0..B3, each clamped to 0..255 */
+      _mm_storeu_si128((__m128i *) rgb,
+                       _mm_packus_epi16(_mm_packs_epi32(r, g), _mm_packs_epi32(b, b)));
+
+      for (k = 0 ; k < 4 ; k++) {
+         pixels [0] = rgb [k];
+         pixels [1] = rgb [4 + k];
+         pixels [2] = rgb [8 + k];
+         pixels += 3;
+      }
+   }
+
+   /* Pixels left over, and any partial pixel, go through the reference */
+   RGB2YCBCR_DSP_InverseMatrix((Char8 *) pixels, size - (i * 3), m);
+}
+#endif /* defined (RGB2YCBCR_DSP_SSE2) */
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_Kernels
+ *
+ *  @desc   Kernels built for this GPP, the fastest one last.
+ *  ============================================================================
+ */
+STATIC RGB2YCBCR_DSP_Kernel RGB2YCBCR_DSP_Kernels [] = {
+   { "ref",  RGB2YCBCR_DSP_ConvertRef,  RGB2YCBCR_DSP_InverseRef  },
+#if defined (RGB2YCBCR_DSP_NEON)
+   { "neon", RGB2YCBCR_DSP_ConvertNeon, RGB2YCBCR_DSP_InverseNeon },
+#endif /* defined (RGB2YCBCR_DSP_NEON) */
+#if defined (RGB2YCBCR_DSP_SSE2)
+   { "sse2", RGB2YCBCR_DSP_ConvertSse2, RGB2YCBCR_DSP_InverseSse2 },
+#endif /* defined (RGB2YCBCR_DSP_SSE2) */
+};
+
+#define NUM_KERNELS (sizeof (RGB2YCBCR_DSP_Kernels) / sizeof (RGB2YCBCR_DSP_Kernels [0]))
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_FormatNames
+ *
+ *  @desc   Names of the output formats, indexed by RGB2YCBCR_DSP_FORMAT_XXX.
+ *  ============================================================================
+ */
+STATIC Char8 * RGB2YCBCR_DSP_FormatNames [] = {
+   "packed",
+   "i444",
+   "i420",
+   "nv12",
+   "i422"
+};
+
+#define NUM_FORMATS (sizeof (RGB2YCBCR_DSP_FormatNames) / sizeof (RGB2YCBCR_DSP_FormatNames [0]))
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_FilterNames
+ *
+ *  @desc   Names of the chroma filters, indexed by RGB2YCBCR_DSP_FILTER_XXX.
+ *  ============================================================================
+ */
+STATIC Char8 * RGB2YCBCR_DSP_FilterNames [] = {
+   "drop",
+   "avg2",
+   "box"
+};
+
+#define NUM_FILTERS (sizeof (RGB2YCBCR_DSP_FilterNames) / sizeof (RGB2YCBCR_DSP_FilterNames [0]))
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ConvertRef
+ *
+ *  @desc   Portable scalar kernel, same arithmetic as the DSP kernel.
+ *
+ *  @modif  buffer
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_ConvertRef(
+   IN OUT Char8 * buffer,
+   IN     Uint32  size)
+{
+   RGB2YCBCR_DSP_ConvertMatrix(buffer, size, RGB2YCBCR_DSP_CurrentMatrix);
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ConvertMatrix
+ *
+ *  @desc   Scalar kernel converting with the matrix it is given.
+ *
+ *  @modif  buffer
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_ConvertMatrix(
+   IN OUT Char8 *                buffer,
+   IN     Uint32                 size,
+   IN     RGB2YCBCR_DSP_Matrix * matrix)
+{
+   Uint8 * pixels = (Uint8 *) buffer;
+   Int32   k11 = matrix->k [0][0];
+   Int32   k12 = matrix->k [0][1];
+   Int32   k13 = matrix->k [0][2];
+   Int32   k21 = matrix->k [1][0];
+   Int32   k22 = matrix->k [1][1];
+   Int32   k23 = matrix->k [1][2];
+   Int32   k31 = matrix->k [2][0];
+   Int32   k32 = matrix->k [2][1];
+   Int32   k33 = matrix->k [2][2];
+   Uint32  j;
+   Int32   y, cb, cr;
+
+   /* Pixels are unsigned levels whatever Char is, results are clamped */
+   for (j = 0 ; (j+3) <= size ; j = j+3) {
+      y = SCALE((k11 * pixels[j]) + (k12 * pixels[j+1]) + (k13 * pixels[j+2])) + matrix->c [0];
+      cb = SCALE((k21 * pixels[j]) + (k22 * pixels[j+1]) + (k23 * pixels[j+2])) + matrix->c [1];
+      cr = SCALE((k31 * pixels[j]) + (k32 * pixels[j+1]) + (k33 * pixels[j+2])) + matrix->c [2];
+
+      pixels[j] = (Uint8) CLAMP_PIXEL(y);
+      pixels[j+1] = (Uint8) CLAMP_PIXEL(cb);
+      pixels[j+2] = (Uint8) CLAMP_PIXEL(cr);
+   }
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_InverseRef
+ *
+ *  @desc   Portable scalar inverse kernel, same arithmetic as the DSP one.
+ *
+ *  @modif  buffer
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_InverseRef(
+   IN OUT Char8 * buffer,
+   IN     Uint32  size)
+{
+   RGB2YCBCR_DSP_InverseMatrix(buffer, size, RGB2YCBCR_DSP_CurrentInverse);
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_InverseMatrix
+ *
+ *  @desc   Scalar inverse kernel converting with the matrix it is given.
+ *          The offsets are folded into the rounding term, as on the DSP.
+ *
+ *  @modif  buffer
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_InverseMatrix(
+   IN OUT Char8 *                buffer,
+   IN     Uint32                 size,
+   IN     RGB2YCBCR_DSP_Matrix * matrix)
+{
+   Uint8 * pixels = (Uint8 *) buffer;
+   Int32   bias1  = INVERSE_BIAS(matrix, 0);
+   Int32   bias2  = INVERSE_BIAS(matrix, 1);
+   Int32   bias3  = INVERSE_BIAS(matrix, 2);
+   Uint32  j;
+   Int32   r, g, b;
+
+   for (j = 0 ; (j+3) <= size ; j = j+3) {
+      r = (  (matrix->k [0][0] * pixels[j]) + (matrix->k [0][1] * pixels[j+1])
+           + (matrix->k [0][2] * pixels[j+2]) + bias1) >> 12;
+      g = (  (matrix->k [1][0] * pixels[j]) + (matrix->k [1][1] * pixels[j+1])
+           + (matrix->k [1][2] * pixels[j+2]) + bias2) >> 12;
+      b = (  (matrix->k [2][0] * pixels[j]) + (matrix->k [2][1] * pixels[j+1])
+           + (matrix->k [2][2] * pixels[j+2]) + bias3) >> 12;
+
+      pixels[j]   = (Uint8) CLAMP_PIXEL(r);
+      pixels[j+1] = (Uint8) CLAMP_PIXEL(g);
+      pixels[j+2] = (Uint8) CLAMP_PIXEL(b);
+   }
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_GetKernel
+ *
+ *  @desc   Looks up a GPP conversion kernel by name.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API RGB2YCBCR_DSP_Kernel * RGB2YCBCR_DSP_GetKernel(
+   IN Char8 * name)
+{
+   Uint32 i;
+
+   if ((name == NULL) || (strcmp(name, "simd") == 0)) {
+      return &RGB2YCBCR_DSP_Kernels [NUM_KERNELS - 1];
+   }
+
+   for (i = 0 ; i < NUM_KERNELS ; i++) {
+      if (strcmp(name, RGB2YCBCR_DSP_Kernels [i].name) == 0) {
+         return &RGB2YCBCR_DSP_Kernels [i];
+      }
+   }
+
+   return NULL;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_GetFormat
+ *
+ *  @desc   Looks up an output format by name.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Int32 RGB2YCBCR_DSP_GetFormat(
+   IN Char8 * name)
+{
+   Uint32 i;
+
+   for (i = 0 ; i < NUM_FORMATS ; i++) {
+      if (strcmp(name, RGB2YCBCR_DSP_FormatNames [i]) == 0) {
+         return i;
+      }
+   }
+
+   return -1;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_GetFilter
+ *
+ *  @desc   Looks up a chroma filter by name.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Int32 RGB2YCBCR_DSP_GetFilter(
+   IN Char8 * name)
+{
+   Uint32 i;
+
+   for (i = 0 ; i < NUM_FILTERS ; i++) {
+      if (strcmp(name, RGB2YCBCR_DSP_FilterNames [i]) == 0) {
+         return i;
+      }
+   }
+
+   return -1;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_GetColorimetry
+ *
+ *  @desc   Looks up a colorimetry by name.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Int32 RGB2YCBCR_DSP_GetColorimetry(
+   IN Char8 * name)
+{
+   Uint32 i;
+
+   for (i = 0 ; i < NUM_COLORS ; i++) {
+      if (strcmp(name, RGB2YCBCR_DSP_ColorNames [i]) == 0) {
+         return i;
+      }
+   }
+
+   return -1;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_GetMatrix
+ *
+ *  @desc   Gives the matrix of a colorimetry.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API RGB2YCBCR_DSP_Matrix * RGB2YCBCR_DSP_GetMatrix(
+   IN Uint32 colorimetry)
+{
+   if (colorimetry >= NUM_MATRICES) {
+      return NULL;
+   }
+
+   return &RGB2YCBCR_DSP_Matrices [colorimetry];
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_GetInverse
+ *
+ *  @desc   Gives the inverse matrix of a colorimetry.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API RGB2YCBCR_DSP_Matrix * RGB2YCBCR_DSP_GetInverse(
+   IN Uint32 colorimetry)
+{
+   if (colorimetry >= NUM_MATRICES) {
+      return NULL;
+   }
+
+   return &RGB2YCBCR_DSP_Inverses [colorimetry];
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_SelectMatrix
+ *
+ *  @desc   Picks the matrices the kernels convert with.
+ *
+ *  @modif  RGB2YCBCR_DSP_CurrentMatrix, RGB2YCBCR_DSP_CurrentInverse
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_SelectMatrix(
+   IN Uint32 colorimetry)
+{
+   RGB2YCBCR_DSP_Matrix * matrix = RGB2YCBCR_DSP_GetMatrix(colorimetry);
+
+   if (matrix == NULL) {
+      return DSP_EINVALIDARG;
+   }
+
+   RGB2YCBCR_DSP_CurrentMatrix  = matrix;
+   RGB2YCBCR_DSP_CurrentInverse = RGB2YCBCR_DSP_GetInverse(colorimetry);
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_PlaneSizes
+ *
+ *  @desc   Gives the plane sizes of a format for a number of pixels.
+ *
+ *  @modif  planeSizes
+ *  ============================================================================
+ */
+NORMAL_API Uint32 RGB2YCBCR_DSP_PlaneSizes(
+   IN  Uint32   format,
+   IN  Uint32   numPixels,
+   OUT Uint32 * planeSizes)
+{
+   switch (format) {
+   case RGB2YCBCR_DSP_FORMAT_I444:
+      planeSizes [0] = numPixels;
+      planeSizes [1] = numPixels;
+      planeSizes [2] = numPixels;
+      return 3;
+
+   case RGB2YCBCR_DSP_FORMAT_I420:
+      planeSizes [0] = numPixels;
+      planeSizes [1] = numPixels / 4;
+      planeSizes [2] = numPixels / 4;
+      return 3;
+
+   case RGB2YCBCR_DSP_FORMAT_NV12:
+      planeSizes [0] = numPixels;
+      planeSizes [1] = numPixels / 2;
+      return 2;
+
+   case RGB2YCBCR_DSP_FORMAT_I422:
+      planeSizes [0] = numPixels;
+      planeSizes [1] = numPixels / 2;
+      planeSizes [2] = numPixels / 2;
+      return 3;
+
+   default:
+      planeSizes [0] = numPixels * 3;
+      return 1;
+   }
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_Subsample
+ *
+ *  @desc   Makes a subsampled chroma sample from the byte of the top left
+ *          pixel, averaging the bytes the filter takes as unsigned levels
+ *          with halves rounded up. below is the distance to the byte one
+ *          row down, 0 when a sample only covers a pair of columns.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Char8 RGB2YCBCR_DSP_Subsample(
+   IN Char8  * sample,
+   IN Uint32   below,
+   IN Uint32   filter)
+{
+   Uint8 * level = (Uint8 *) sample;
+
+   if ((filter == RGB2YCBCR_DSP_FILTER_AVG2) && (below != 0)) {
+      return (Char8) ((level [0] + level [below] + 1) >> 1);
+   }
+
+   if ((filter == RGB2YCBCR_DSP_FILTER_BOX) && (below != 0)) {
+      return (Char8) ((level [0] + level [3] + level [below] + level [below + 3] + 2) >> 2);
+   }
+
+   if (filter != RGB2YCBCR_DSP_FILTER_DROP) {
+      return (Char8) ((level [0] + level [3] + 1) >> 1);
+   }
+
+   return sample [0];
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_Planarize
+ *
+ *  @desc   Gathers the planes of a format from converted pixels, the same
+ *          way the DSP does.
+ *
+ *  @modif  output
+ *  ============================================================================
+ */
+NORMAL_API Uint32 RGB2YCBCR_DSP_Planarize(
+   IN  Char8  * input,
+   OUT Char8  * output,
+   IN  Uint32   numPixels,
+   IN  Uint32   format,
+   IN  Uint32   width,
+   IN  Uint32   filter)
+{
+   Char8 * cb;
+   Char8 * cr;
+   Char8 * pixel;
+   Uint32  below;
+   Uint32  rowStep;
+   Uint32  chromaSize;
+   Uint32  numRows;
+   Uint32  row;
+   Uint32  i;
+
+   if (format == RGB2YCBCR_DSP_FORMAT_PACKED) {
+      memcpy(output, input, numPixels * 3);
+      return numPixels * 3;
+   }
+
+   for (i = 0 ; i < numPixels ; i++) {
+      output [i] = input [i * 3];
+   }
+
+   if ((format == RGB2YCBCR_DSP_FORMAT_I444) || (width == 0)) {
+      cb = output + numPixels;
+      cr = cb + numPixels;
+      for (i = 0 ; i < numPixels ; i++) {
+         cb [i] = input [(i * 3) + 1];
+         cr [i] = input [(i * 3) + 2];
+      }
+      return numPixels * 3;
+   }
+
+   if (format == RGB2YCBCR_DSP_FORMAT_I422) {
+      rowStep    = 1;
+      below      = 0;
+      chromaSize = numPixels / 2;
+   }
+   else {
+      rowStep    = 2;
+      below      = width * 3;
+      chromaSize = numPixels / 4;
+   }
+
+   numRows = numPixels / width;
+   cb      = output + numPixels;
+   cr      = cb + chromaSize;
+   for (row = 0 ; (row + rowStep) <= numRows ; row = row + rowStep) {
+      pixel = input + (row * width * 3);
+      for (i = 0 ; i < width ; i = i + 2) {
+         *cb++ = RGB2YCBCR_DSP_Subsample(pixel + (i * 3) + 1, below, filter);
+         if (format == RGB2YCBCR_DSP_FORMAT_NV12) {
+            *cb++ = RGB2YCBCR_DSP_Subsample(pixel + (i * 3) + 2, below, filter);
+         }
+         else {
+            *cr++ = RGB2YCBCR_DSP_Subsample(pixel + (i * 3) + 2, below, filter);
+         }
+      }
+   }
+
+   return numPixels + (2 * chromaSize);
+}
+
+
+#if defined (VERIFY_DATA)
+/** ============================================================================
+ *  @const  GOLDEN_TOLERANCE
+ *
+ *  @desc   Largest difference allowed between the reference and the golden
+ *          model. Q12 coefficients and the final rounding, or the
+ *          truncation of RGB2YCBCR_DSP_EXACT_DIV, stay below one level.
+ *  ============================================================================
+ */
+#define GOLDEN_TOLERANCE 1.0
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_GoldenColor
+ *
+ *  @desc   Definition of a colorimetry the golden model works from.
+ *
+ *  @field  kr
+ *              Weight of red in luma.
+ *  @field  kb
+ *              Weight of blue in luma.
+ *  @field  full
+ *              TRUE when every level is used, FALSE for Y in 16..235 and
+ *              chroma in 16..240.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_GoldenColor_tag {
+   Real64 kr;
+   Real64 kb;
+   Bool   full;
+} RGB2YCBCR_DSP_GoldenColor;
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_GoldenColors
+ *
+ *  @desc   Golden definitions indexed by RGB2YCBCR_DSP_COLOR_XXX, from the
+ *          luma weights of BT.601, BT.709 and BT.2020. The legacy forward
+ *          matrix is checked against DXY instead, its inverse is BT.601.
+ *  ============================================================================
+ */
+STATIC RGB2YCBCR_DSP_GoldenColor RGB2YCBCR_DSP_GoldenColors [] = {
+   { 0.299,  0.114,  FALSE },
+   { 0.299,  0.114,  FALSE },
+   { 0.299,  0.114,  TRUE  },
+   { 0.2126, 0.0722, FALSE },
+   { 0.2126, 0.0722, TRUE  },
+   { 0.2627, 0.0593, FALSE },
+   { 0.2627, 0.0593, TRUE  }
+};
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_GoldenPixel
+ *
+ *  @desc   Converts one pixel in double precision, from the definition of
+ *          the colorimetry rather than from its fixed point matrix, and
+ *          clamps the result to 0..255 without rounding it.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_GoldenPixel(
+   IN  Uint32        colorimetry,
+   IN  Bool          inverse,
+   IN  Uint8 *       in,
+   OUT Real64 *      out)
+{
+   RGB2YCBCR_DSP_GoldenColor * color = &RGB2YCBCR_DSP_GoldenColors [colorimetry];
+   Real64 kr = color->kr;
+   Real64 kb = color->kb;
+   Real64 yScale = color->full ? 1.0 : (219.0 / 255.0);
+   Real64 cScale = color->full ? 1.0 : (224.0 / 255.0);
+   Real64 yOffset = color->full ? 0.0 : 16.0;
+   Real64 luma;
+   Real64 pb;
+   Real64 pr;
+   Uint32 i;
+
+   if (inverse) {
+      luma   = (in [0] - yOffset) / yScale;
+      pb     = (in [1] - 128.0) / cScale;
+      pr     = (in [2] - 128.0) / cScale;
+      out[0] = luma + (2.0 * (1.0 - kr) * pr);
+      out[2] = luma + (2.0 * (1.0 - kb) * pb);
+      out[1] = (luma - (kr * out[0]) - (kb * out[2])) / (1.0 - kr - kb);
+   }
+   else if (colorimetry == RGB2YCBCR_DSP_COLOR_LEGACY) {
+      out[0] = (((D11 * in [0]) + (D12 * in [1]) + (D13 * in [2])) / 100.0) + C1;
+      out[1] = (((D21 * in [0]) + (D22 * in [1]) + (D23 * in [2])) / 100.0) + C2;
+      out[2] = (((D31 * in [0]) + (D32 * in [1]) + (D33 * in [2])) / 100.0) + C3;
+   }
+   else {
+      luma   = (kr * in [0]) + ((1.0 - kr - kb) * in [1]) + (kb * in [2]);
+      out[0] = yOffset + (yScale * luma);
+      out[1] = 128.0 + (cScale * (in [2] - luma) / (2.0 * (1.0 - kb)));
+      out[2] = 128.0 + (cScale * (in [0] - luma) / (2.0 * (1.0 - kr)));
+   }
+
+   for (i = 0 ; i < 3 ; i++) {
+      out[i] = (out[i] < 0.0) ? 0.0 : ((out[i] > 255.0) ? 255.0 : out[i]);
+   }
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_VerifyGolden
+ *
+ *  @desc   Compares converted pixels with the golden model and returns
+ *          TRUE when they all lie within GOLDEN_TOLERANCE of it.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Bool RGB2YCBCR_DSP_VerifyGolden(
+   IN Uint32  colorimetry,
+   IN Bool    inverse,
+   IN Char8 * source,
+   IN Char8 * converted,
+   IN Uint32  numPixels)
+{
+   Real64 golden [3];
+   Real64 diff;
+   Uint32 i;
+   Uint32 j;
+
+   for (i = 0 ; i < numPixels ; i++) {
+      RGB2YCBCR_DSP_GoldenPixel(colorimetry, inverse, (Uint8 *) source + (i * 3), golden);
+      for (j = 0 ; j < 3 ; j++) {
+         diff = ((Uint8) converted [(i * 3) + j]) - golden [j];
+         if ((diff > GOLDEN_TOLERANCE) || (diff < -GOLDEN_TOLERANCE)) {
+            return FALSE;
+         }
+      }
+   }
+
+   return TRUE;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_VerifyKernels
+ *
+ *  @desc   Compares the reference with the golden model and every kernel
+ *          with the reference over all RGB values, for every matrix, then
+ *          the inverse ones over all Y, Cb, Cr values. Each red (or Y)
+ *          value is one pass over the 65536 pairs of the other two, placed
+ *          at a different alignment and followed by 0 to 2 spare bytes.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_VerifyKernels(Void)
+{
+   DSP_STATUS status   = DSP_SOK;
+   Uint32     passSize = 65536 * 3;
+   Char8 *    source;
+   Char8 *    expected;
+   Char8 *    actual;
+   Uint32     size;
+   Uint32     offset;
+   Uint32     red;
+   Uint32     i;
+   Uint32     k;
+   Uint32     m;
+   Uint32     inverse;
+   RGB2YCBCR_DSP_ConvertFxn fxn;
+   RGB2YCBCR_DSP_Matrix * selected        = RGB2YCBCR_DSP_CurrentMatrix;
+   RGB2YCBCR_DSP_Matrix * selectedInverse = RGB2YCBCR_DSP_CurrentInverse;
+
+   source   = (Char8 *) malloc(passSize + 2);
+   expected = (Char8 *) malloc(passSize + 2);
+   actual   = (Char8 *) malloc(passSize + 2 + 16);
+
+   if ((source == NULL) || (expected == NULL) || (actual == NULL)) {
+      status = DSP_EMEMORY;
+   }
+
+   for (m = 0 ; (m < (2 * NUM_MATRICES)) && DSP_SUCCEEDED (status) ; m++) {
+      /* The forward kernels first, then the inverse ones */
+      inverse = (m >= NUM_MATRICES);
+      RGB2YCBCR_DSP_CurrentMatrix  = &RGB2YCBCR_DSP_Matrices [m % NUM_MATRICES];
+      RGB2YCBCR_DSP_CurrentInverse = &RGB2YCBCR_DSP_Inverses [m % NUM_MATRICES];
+
+      for (red = 0 ; (red < 256) && DSP_SUCCEEDED (status) ; red++) {
+         for (i = 0 ; i < 65536 ; i++) {
+            source [(i * 3)]     = (Char8) red;
+            source [(i * 3) + 1] = (Char8) (i >> 8);
+            source [(i * 3) + 2] = (Char8) i;
+         }
+         source [passSize]     = (Char8) red;
+         source [passSize + 1] = (Char8) ~red;
+
+         size   = passSize + (red % 3);
+         offset = red % 16;
+
+         memcpy(expected, source, size);
+         if (inverse) {
+            RGB2YCBCR_DSP_InverseRef(expected, size);
+         }
+         else {
+            RGB2YCBCR_DSP_ConvertRef(expected, size);
+         }
+
+         if (!RGB2YCBCR_DSP_VerifyGolden(m % NUM_MATRICES, inverse, source, expected, 65536)) {
+            RGB2YCBCR_DSP_0Print("Reference differs from the golden model");
+            RGB2YCBCR_DSP_0Print(inverse ? " with the inverse " : " with the ");
+            RGB2YCBCR_DSP_0Print(RGB2YCBCR_DSP_ColorNames [m % NUM_MATRICES]);
+            RGB2YCBCR_DSP_0Print(" matrix");
+            RGB2YCBCR_DSP_1Print("\nRed value", red);
+            RGB2YCBCR_DSP_0Print("\n");
+            status = DSP_EFAIL;
+         }
+
+         for (k = 1 ; (k < NUM_KERNELS) && DSP_SUCCEEDED (status) ; k++) {
+            fxn = inverse ? RGB2YCBCR_DSP_Kernels [k].inverseFxn
+                          : RGB2YCBCR_DSP_Kernels [k].convertFxn;
+            memcpy(actual + offset, source, size);
+            fxn(actual + offset, size);
+
+            if (memcmp(actual + offset, expected, size) != 0) {
+               RGB2YCBCR_DSP_0Print("Kernel differs from the reference: ");
+               RGB2YCBCR_DSP_0Print(RGB2YCBCR_DSP_Kernels [k].name);
+               RGB2YCBCR_DSP_0Print(inverse ? " with the inverse " : " with the ");
+               RGB2YCBCR_DSP_0Print(RGB2YCBCR_DSP_ColorNames [m % NUM_MATRICES]);
+               RGB2YCBCR_DSP_0Print(" matrix");
+               RGB2YCBCR_DSP_1Print("\nRed value", red);
+               RGB2YCBCR_DSP_0Print("\n");
+               status = DSP_EFAIL;
+            }
+         }
+      }
+   }
+
+   RGB2YCBCR_DSP_CurrentMatrix  = selected;
+   RGB2YCBCR_DSP_CurrentInverse = selectedInverse;
+
+   if (DSP_SUCCEEDED (status)) {
+      RGB2YCBCR_DSP_1Print("Reference matches the golden model, both ways, matrices checked:",
+                           NUM_MATRICES);
+      RGB2YCBCR_DSP_0Print("\n");
+   }
+
+   for (k = 1 ; (k < NUM_KERNELS) && DSP_SUCCEEDED (status) ; k++) {
+      RGB2YCBCR_DSP_0Print("Kernel matches the reference: ");
+      RGB2YCBCR_DSP_0Print(RGB2YCBCR_DSP_Kernels [k].name);
+      RGB2YCBCR_DSP_1Print(", both ways, matrices checked:", NUM_MATRICES);
+      RGB2YCBCR_DSP_0Print("\n");
+   }
+
+   free(actual);
+   free(expected);
+   free(source);
+
+   return status;
+}
+#endif /* defined (VERIFY_DATA) */
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
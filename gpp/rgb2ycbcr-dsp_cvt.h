@@ -0,0 +1,505 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_cvt.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/
+ *
+ *  @desc   Color space conversion kernels running on the GPP, used when the
+ *          DSP is not worth or not available for a frame.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RGB2YCBCR_DSP_CVT_H)
+#define RGB2YCBCR_DSP_CVT_H
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_ConvertFxn
+ *
+ *  @desc   Signature of the GPP conversion kernels. The buffer holds
+ *          interleaved R, G, B bytes and is overwritten with Y, Cb, Cr, or
+ *          the other way round for the inverse kernels. Trailing bytes that
+ *          do not make a whole pixel are left as is.
+ *
+ *  @arg    buffer
+ *              Pixels to convert in place.
+ *
+ *  @arg    size
+ *              Size of the buffer in bytes.
+ *
+ *  @ret    None
+ *  ============================================================================
+ */
+typedef Void (*RGB2YCBCR_DSP_ConvertFxn) (
+   IN OUT Char8 * buffer,
+   IN     Uint32  size);
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_Kernel
+ *
+ *  @desc   A GPP conversion kernel and the name it is selected by.
+ *
+ *  @field  name
+ *              Name of the kernel.
+ *  @field  convertFxn
+ *              Function converting a buffer.
+ *  @field  inverseFxn
+ *              Function converting a buffer back.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_Kernel_tag {
+   Char8 *                  name;
+   RGB2YCBCR_DSP_ConvertFxn convertFxn;
+   RGB2YCBCR_DSP_ConvertFxn inverseFxn;
+} RGB2YCBCR_DSP_Kernel;
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_Matrix
+ *
+ *  @desc   Conversion matrix of a colorimetry, laid out as on the DSP.
+ *
+ *  @field  k
+ *              Coefficients, one row per output, in the fixed point of the
+ *              kernels. They fit in 16 bits for the vector multipliers.
+ *  @field  c
+ *              Offsets added to Y, Cb and Cr.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_Matrix_tag {
+   Int16 k [3][3];
+   Int16 c [3];
+} RGB2YCBCR_DSP_Matrix;
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ConvertRef
+ *
+ *  @desc   Portable scalar kernel. It uses the same arithmetic as the DSP,
+ *          reading the pixels as unsigned levels and clamping Y, Cb and Cr
+ *          to 0..255, and is the reference the other kernels must match.
+ *          Like them it converts with the matrix RGB2YCBCR_DSP_SelectMatrix ()
+ *          picked.
+ *
+ *  @arg    buffer
+ *              Pixels to convert in place.
+ *
+ *  @arg    size
+ *              Size of the buffer in bytes.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_GetKernel
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_ConvertRef(
+   IN OUT Char8 * buffer,
+   IN     Uint32  size);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_ConvertMatrix
+ *
+ *  @desc   Scalar kernel converting with a given matrix rather than the
+ *          selected one.
+ *
+ *  @arg    buffer
+ *              Pixels to convert in place.
+ *
+ *  @arg    size
+ *              Size of the buffer in bytes.
+ *
+ *  @arg    matrix
+ *              Matrix to convert with.
+ *
+ *  @ret    None
+ *
+ *  @enter  matrix must not be NULL.
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_GetMatrix
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_ConvertMatrix(
+   IN OUT Char8 *                buffer,
+   IN     Uint32                 size,
+   IN     RGB2YCBCR_DSP_Matrix * matrix);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_InverseRef
+ *
+ *  @desc   Portable scalar inverse kernel, with the arithmetic of the DSP.
+ *          Y, Cb and Cr are unsigned levels, the offsets of the selected
+ *          colorimetry are taken out and R, G and B are clamped to 0..255.
+ *          It is the reference the other inverse kernels must match.
+ *
+ *  @arg    buffer
+ *              Pixels to convert in place.
+ *
+ *  @arg    size
+ *              Size of the buffer in bytes.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_ConvertRef
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_InverseRef(
+   IN OUT Char8 * buffer,
+   IN     Uint32  size);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_InverseMatrix
+ *
+ *  @desc   Scalar inverse kernel converting with a given inverse matrix
+ *          rather than the selected one.
+ *
+ *  @arg    buffer
+ *              Pixels to convert in place.
+ *
+ *  @arg    size
+ *              Size of the buffer in bytes.
+ *
+ *  @arg    matrix
+ *              Inverse matrix to convert with.
+ *
+ *  @ret    None
+ *
+ *  @enter  matrix must not be NULL.
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_GetInverse
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_InverseMatrix(
+   IN OUT Char8 *                buffer,
+   IN     Uint32                 size,
+   IN     RGB2YCBCR_DSP_Matrix * matrix);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_GetColorimetry
+ *
+ *  @desc   Looks up a colorimetry by name: "legacy", "bt601", "bt709" or
+ *          "bt2020", the last three with a "-full" suffix for full range.
+ *
+ *  @arg    name
+ *              Name of the colorimetry.
+ *
+ *  @ret    One of RGB2YCBCR_DSP_COLOR_XXX, or -1 if there is none with
+ *          that name.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_SelectMatrix
+ *  ============================================================================
+ */
+NORMAL_API Int32 RGB2YCBCR_DSP_GetColorimetry(
+   IN Char8 * name);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_GetMatrix
+ *
+ *  @desc   Gives the matrix of a colorimetry. Only the legacy one is built
+ *          with RGB2YCBCR_DSP_EXACT_DIV.
+ *
+ *  @arg    colorimetry
+ *              One of RGB2YCBCR_DSP_COLOR_XXX.
+ *
+ *  @ret    The matrix, or NULL if it is not built in.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_SelectMatrix
+ *  ============================================================================
+ */
+NORMAL_API RGB2YCBCR_DSP_Matrix * RGB2YCBCR_DSP_GetMatrix(
+   IN Uint32 colorimetry);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_GetInverse
+ *
+ *  @desc   Gives the inverse matrix of a colorimetry. The legacy matrix is
+ *          ten times a BT.601 one and mostly saturates, it goes back with
+ *          the BT.601 inverse.
+ *
+ *  @arg    colorimetry
+ *              One of RGB2YCBCR_DSP_COLOR_XXX.
+ *
+ *  @ret    The inverse matrix, or NULL if the colorimetry is not built in.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_GetMatrix
+ *  ============================================================================
+ */
+NORMAL_API RGB2YCBCR_DSP_Matrix * RGB2YCBCR_DSP_GetInverse(
+   IN Uint32 colorimetry);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_SelectMatrix
+ *
+ *  @desc   Picks the matrices the GPP kernels convert with, both ways. The
+ *          kernels read them once per buffer.
+ *
+ *  @arg    colorimetry
+ *              One of RGB2YCBCR_DSP_COLOR_XXX.
+ *
+ *  @ret    DSP_SOK
+ *              The matrix is selected.
+ *          DSP_EINVALIDARG
+ *              The colorimetry is not built in.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_GetMatrix
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_SelectMatrix(
+   IN Uint32 colorimetry);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_GetKernel
+ *
+ *  @desc   Looks up a GPP conversion kernel. "ref" is the scalar reference,
+ *          "simd" the vector kernel built for this GPP (NEON on ARM, SSE2 on
+ *          x86), which falls back to the reference when there is none. A
+ *          kernel can also be asked for by its own name.
+ *
+ *  @arg    name
+ *              Name of the kernel, NULL for the fastest one.
+ *
+ *  @ret    The kernel, or NULL if there is none with that name.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_ConvertRef
+ *  ============================================================================
+ */
+NORMAL_API RGB2YCBCR_DSP_Kernel * RGB2YCBCR_DSP_GetKernel(
+   IN Char8 * name);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_GetFormat
+ *
+ *  @desc   Looks up an output format by name: "packed", "i444", "i422",
+ *          "i420" or "nv12".
+ *
+ *  @arg    name
+ *              Name of the format.
+ *
+ *  @ret    One of RGB2YCBCR_DSP_FORMAT_XXX, or -1 if there is none with
+ *          that name.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_PlaneSizes
+ *  ============================================================================
+ */
+NORMAL_API Int32 RGB2YCBCR_DSP_GetFormat(
+   IN Char8 * name);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_GetFilter
+ *
+ *  @desc   Looks up a chroma filter by name: "drop", "avg2" or "box".
+ *
+ *  @arg    name
+ *              Name of the filter.
+ *
+ *  @ret    One of RGB2YCBCR_DSP_FILTER_XXX, or -1 if there is none with
+ *          that name.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_Planarize
+ *  ============================================================================
+ */
+NORMAL_API Int32 RGB2YCBCR_DSP_GetFilter(
+   IN Char8 * name);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_PlaneSizes
+ *
+ *  @desc   Gives the size of each plane of a format holding a number of
+ *          pixels. The packed format has a single plane. For the
+ *          subsampled formats the number of pixels is expected to cover
+ *          whole rows of an even width, whole pairs of rows for I420 and
+ *          NV12.
+ *
+ *  @arg    format
+ *              One of RGB2YCBCR_DSP_FORMAT_XXX.
+ *
+ *  @arg    numPixels
+ *              Number of pixels.
+ *
+ *  @arg    planeSizes
+ *              Receives the size of each plane in bytes. It must have room
+ *              for RGB2YCBCR_DSP_MAX_PLANES entries.
+ *
+ *  @ret    Number of planes.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_Planarize
+ *  ============================================================================
+ */
+NORMAL_API Uint32 RGB2YCBCR_DSP_PlaneSizes(
+   IN  Uint32   format,
+   IN  Uint32   numPixels,
+   OUT Uint32 * planeSizes);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_Planarize
+ *
+ *  @desc   Writes converted Y, Cb, Cr pixels as the planes of a format, as
+ *          the DSP does for a chunk. The planes follow each other in
+ *          output. Used to convert on the GPP and to check the DSP.
+ *
+ *  @arg    input
+ *              Converted pixels, interleaved.
+ *
+ *  @arg    output
+ *              Buffer receiving the planes. It must not overlap input.
+ *
+ *  @arg    numPixels
+ *              Number of pixels in input.
+ *
+ *  @arg    format
+ *              One of RGB2YCBCR_DSP_FORMAT_XXX.
+ *
+ *  @arg    width
+ *              Width of the frame in pixels.
+ *
+ *  @arg    filter
+ *              Chroma filter of the subsampled formats, one of
+ *              RGB2YCBCR_DSP_FILTER_XXX.
+ *
+ *  @ret    Number of bytes written to output.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_PlaneSizes
+ *  ============================================================================
+ */
+NORMAL_API Uint32 RGB2YCBCR_DSP_Planarize(
+   IN  Char8  * input,
+   OUT Char8  * output,
+   IN  Uint32   numPixels,
+   IN  Uint32   format,
+   IN  Uint32   width,
+   IN  Uint32   filter);
+
+
+#if defined (VERIFY_DATA)
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_VerifyKernels
+ *
+ *  @desc   Runs every GPP kernel over all 2^24 RGB values, at every
+ *          alignment and with a partial trailing pixel, and compares the
+ *          result byte for byte with RGB2YCBCR_DSP_ConvertRef (), once per
+ *          matrix built in. The inverse kernels are compared the same way
+ *          with RGB2YCBCR_DSP_InverseRef (). The references themselves are
+ *          checked against a golden model in double precision, worked out
+ *          from the definition of each colorimetry, which they must match
+ *          within one level. The selected matrices are kept.
+ *
+ *  @ret    DSP_SOK
+ *              Every kernel matches the reference.
+ *          DSP_EFAIL
+ *              A kernel differs from the reference, or the reference
+ *              from the golden model.
+ *          DSP_EMEMORY
+ *              Out of memory.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_ConvertRef
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_VerifyKernels(Void);
+#endif /* defined (VERIFY_DATA) */
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RGB2YCBCR_DSP_CVT_H) */
@@ -0,0 +1,155 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_plan.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/
+ *
+ *  @desc   Chunk planner. Picks how many bytes of the image every transfer
+ *          carries so no pixel is split between two chunks.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+/*  ----------------------------------- OS Specific Headers           */
+#include <stdlib.h>
+#include <string.h>
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <rgb2ycbcr-dsp_plan.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_PlanLcm
+ *
+ *  @desc   Least common multiple of two sizes.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Uint32 RGB2YCBCR_DSP_PlanLcm(
+   IN Uint32 a,
+   IN Uint32 b)
+{
+   Uint32 x = a;
+   Uint32 y = b;
+   Uint32 t;
+
+   while (y != 0) {
+      t = x % y;
+      x = y;
+      y = t;
+   }
+
+   return (a / x) * b;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_PlanChunk
+ *
+ *  @desc   Rounds the target size down to the coarsest unit that still
+ *          fits it: aligned rows, then rows, then aligned pixels.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Uint32 RGB2YCBCR_DSP_PlanChunk(
+   IN Uint32 requested,
+   IN Uint32 dataSize,
+   IN Uint32 rowBytes,
+   IN Uint32 numBuffers)
+{
+   Uint32 stride = RGB2YCBCR_DSP_PlanLcm(PLAN_PIXEL_BYTES, DSPLINK_BUF_ALIGN);
+   Uint32 target = requested;
+   Uint32 unit   = stride;
+   Uint32 rowUnit;
+
+   if (target == 0) {
+      if ((dataSize == 0) || (numBuffers == 0)) {
+         target = PLAN_MAX_CHUNK;
+      }
+      else {
+         target = dataSize / (numBuffers * PLAN_CHUNKS_PER_BUFFER);
+         target = (target < PLAN_MIN_CHUNK) ? PLAN_MIN_CHUNK : target;
+         target = (target > PLAN_MAX_CHUNK) ? PLAN_MAX_CHUNK : target;
+      }
+   }
+
+   /* A chunk larger than the whole image only wastes pool memory */
+   if ((dataSize != 0) && (target > dataSize)) {
+      target = dataSize;
+   }
+
+   if ((rowBytes != 0) && ((rowBytes % PLAN_PIXEL_BYTES) == 0)) {
+      rowUnit = RGB2YCBCR_DSP_PlanLcm(rowBytes, stride);
+      if (rowUnit <= target) {
+         unit = rowUnit;
+      }
+      else if (rowBytes <= target) {
+         unit = rowBytes;
+      }
+   }
+
+   if (target < unit) {
+      /* Even a small image goes in whole aligned groups of pixels */
+      return unit;
+   }
+
+   return (target / unit) * unit;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_PlanParse
+ *
+ *  @desc   Converts the argument, "auto" being zero.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API Uint32 RGB2YCBCR_DSP_PlanParse(
+   IN Char8 * strBufferSize)
+{
+   if ((strBufferSize == NULL) || (strcmp(strBufferSize, "auto") == 0)) {
+      return 0;
+   }
+
+   return (Uint32) atoi(strBufferSize);
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
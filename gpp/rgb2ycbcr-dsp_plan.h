@@ -0,0 +1,147 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_plan.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/
+ *
+ *  @desc   Chunk planner. Picks how many bytes of the image every transfer
+ *          carries so no pixel is split between two chunks.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RGB2YCBCR_DSP_PLAN_H)
+#define RGB2YCBCR_DSP_PLAN_H
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  PLAN_PIXEL_BYTES
+ *
+ *  @desc   Bytes of an interleaved R, G, B pixel.
+ *  ============================================================================
+ */
+#define PLAN_PIXEL_BYTES 3
+
+/** ============================================================================
+ *  @const  PLAN_MIN_CHUNK, PLAN_MAX_CHUNK
+ *
+ *  @desc   Bounds of an automatic chunk size. Below the minimum the cost of
+ *          a transfer is no longer paid back by the conversion, above the
+ *          maximum the buffers no longer fit the pool.
+ *  ============================================================================
+ */
+#define PLAN_MIN_CHUNK     (16 * 1024)
+#define PLAN_MAX_CHUNK     (64 * 1024)
+
+/** ============================================================================
+ *  @const  PLAN_CHUNKS_PER_BUFFER
+ *
+ *  @desc   Chunks an automatic size aims at for every buffer in flight, so
+ *          the pipeline fills and drains a few times per image.
+ *  ============================================================================
+ */
+#define PLAN_CHUNKS_PER_BUFFER 4
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_PlanChunk
+ *
+ *  @desc   Picks the number of bytes every chunk carries. The size is always
+ *          a whole number of pixels. It is a multiple of
+ *          lcm (PLAN_PIXEL_BYTES, DSPLINK_BUF_ALIGN) so every chunk also
+ *          starts aligned in the data, or of whole rows when they fit.
+ *          Rows that are aligned too are preferred over both.
+ *
+ *  @arg    requested
+ *              Chunk size asked for, the plan is no larger unless the size
+ *              is below one aligned group of pixels. Zero picks a size from
+ *              the data size and the pipeline depth.
+ *
+ *  @arg    dataSize
+ *              Size of the image in bytes, zero if not known.
+ *
+ *  @arg    rowBytes
+ *              Size of an image row in bytes, zero if chunks need not hold
+ *              whole rows.
+ *
+ *  @arg    numBuffers
+ *              Number of buffers kept in flight.
+ *
+ *  @ret    Number of bytes every chunk but the last one carries.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_PlanParse
+ *  ============================================================================
+ */
+NORMAL_API Uint32 RGB2YCBCR_DSP_PlanChunk(
+   IN Uint32 requested,
+   IN Uint32 dataSize,
+   IN Uint32 rowBytes,
+   IN Uint32 numBuffers);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_PlanParse
+ *
+ *  @desc   Reads a buffer size argument. "auto" and "0" ask the planner to
+ *          pick the size.
+ *
+ *  @arg    strBufferSize
+ *              Buffer size in string format.
+ *
+ *  @ret    Size asked for, zero for an automatic size.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_PlanChunk
+ *  ============================================================================
+ */
+NORMAL_API Uint32 RGB2YCBCR_DSP_PlanParse(
+   IN Char8 * strBufferSize);
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RGB2YCBCR_DSP_PLAN_H) */
@@ -0,0 +1,221 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_roundtrip.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/
+ *
+ *  @desc   Round trip benchmark. Times the forward and inverse conversions
+ *          of a frame and measures the PSNR of the frame that comes back.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+/*  ----------------------------------- OS Specific Headers           */
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <rgb2ycbcr-dsp.h>
+#include <rgb2ycbcr-dsp_os.h>
+#include <rgb2ycbcr-dsp_cvt.h>
+#include <rgb2ycbcr-dsp_stats.h>
+#include <rgb2ycbcr-dsp_roundtrip.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_RoundTripPass
+ *
+ *  @desc   Converts input into output in one direction, one warm-up and
+ *          ROUNDTRIP_REPEATS timed times, and returns the best time, zero
+ *          if it could not be run. Output holds the converted frame.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Real64 RGB2YCBCR_DSP_RoundTripPass(
+   IN  Char8 *                dspExecutable,
+   IN  Char8 *                strBufferSize,
+   IN  Char8 *                strNumBuffers,
+   IN  Char8 *                strNumDspBuffers,
+   IN  Char8 *                strProcessorId,
+   IN  RGB2YCBCR_DSP_Kernel * kernel,
+   IN  Uint32                 direction,
+   IN  Char8 *                input,
+   OUT Char8 *                output,
+   IN  Uint32                 size)
+{
+   DSP_STATUS status = DSP_SOK;
+   Real64     best   = 0;
+   Real64     start;
+   Real64     elapsed;
+   Uint8      processorId;
+   Uint32     i;
+
+   if (kernel == NULL) {
+      status = RGB2YCBCR_DSP_SetDirection(direction);
+      if (DSP_SUCCEEDED(status)) {
+         status = RGB2YCBCR_DSP_SessionCreate(dspExecutable,
+                                              strBufferSize,
+                                              strNumBuffers,
+                                              strNumDspBuffers,
+                                              strProcessorId,
+                                              &processorId);
+      }
+      if (DSP_FAILED(status)) {
+         return 0;
+      }
+   }
+
+   /* The first conversion warms the caches up and is not counted */
+   for (i = 0 ; (i <= ROUNDTRIP_REPEATS) && DSP_SUCCEEDED(status) ; i++) {
+      memcpy(output, input, size);
+      start = RGB2YCBCR_DSP_GetTime();
+      if (kernel == NULL) {
+         status = RGB2YCBCR_DSP_SessionConvert(output, size, processorId);
+      }
+      else if (direction == RGB2YCBCR_DSP_DIR_INVERSE) {
+         kernel->inverseFxn(output, size);
+      }
+      else {
+         kernel->convertFxn(output, size);
+      }
+      elapsed = RGB2YCBCR_DSP_GetTime() - start;
+      if ((i > 0) && ((best == 0) || (elapsed < best))) {
+         best = elapsed;
+      }
+   }
+
+   if (kernel == NULL) {
+      RGB2YCBCR_DSP_SessionDelete(processorId);
+   }
+
+   return DSP_SUCCEEDED(status) ? best : 0;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_RoundTrip
+ *
+ *  @desc   Runs both directions and compares the frame with a copy of the
+ *          original.
+ *
+ *  @modif  frame, result
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_RoundTrip(
+   IN     Char8 *                         dspExecutable,
+   IN     Char8 *                         strBufferSize,
+   IN     Char8 *                         strNumBuffers,
+   IN     Char8 *                         strNumDspBuffers,
+   IN     Char8 *                         strProcessorId,
+   IN     RGB2YCBCR_DSP_Kernel *          kernel,
+   IN OUT Char8 *                         frame,
+   IN     Uint32                          frameSize,
+   OUT    RGB2YCBCR_DSP_RoundTripResult * result)
+{
+   DSP_STATUS status = DSP_SOK;
+   Char8 *    original;
+   Char8 *    converted;
+   Real64     forward;
+   Real64     inverse = 0;
+   Real64     sum     = 0;
+   Int32      diff;
+   Uint32     i;
+
+   if ((frame == NULL) || (frameSize == 0) || (result == NULL)) {
+      return DSP_EINVALIDARG;
+   }
+
+   original  = (Char8 *) malloc(frameSize);
+   converted = (Char8 *) malloc(frameSize);
+   if ((original == NULL) || (converted == NULL)) {
+      free(original);
+      free(converted);
+      return DSP_EMEMORY;
+   }
+
+   memset(result, 0, sizeof(*result));
+   memcpy(original, frame, frameSize);
+   RGB2YCBCR_DSP_StatsQuiet(TRUE);
+
+   forward = RGB2YCBCR_DSP_RoundTripPass(dspExecutable, strBufferSize, strNumBuffers,
+                                         strNumDspBuffers, strProcessorId, kernel,
+                                         RGB2YCBCR_DSP_DIR_FORWARD,
+                                         original, converted, frameSize);
+   if (forward != 0) {
+      inverse = RGB2YCBCR_DSP_RoundTripPass(dspExecutable, strBufferSize, strNumBuffers,
+                                            strNumDspBuffers, strProcessorId, kernel,
+                                            RGB2YCBCR_DSP_DIR_INVERSE,
+                                            converted, frame, frameSize);
+   }
+
+   if (kernel == NULL) {
+      RGB2YCBCR_DSP_SetDirection(RGB2YCBCR_DSP_DIR_FORWARD);
+   }
+   RGB2YCBCR_DSP_StatsQuiet(FALSE);
+   RGB2YCBCR_DSP_StatsFree();
+
+   if ((forward == 0) || (inverse == 0)) {
+      memcpy(frame, original, frameSize);
+      status = DSP_EFAIL;
+   }
+   else {
+      for (i = 0 ; i < frameSize ; i++) {
+         diff = (Int32) ((Uint8) frame [i]) - (Int32) ((Uint8) original [i]);
+         diff = (diff < 0) ? -diff : diff;
+         sum += (Real64) (diff * diff);
+         if ((Uint32) diff > result->maxError) {
+            result->maxError = diff;
+         }
+      }
+
+      result->forward = frameSize / (forward * 1000000.0);
+      result->inverse = frameSize / (inverse * 1000000.0);
+      result->mse     = sum / frameSize;
+      result->psnr    = (result->mse == 0) ? HUGE_VAL
+                                           : 10.0 * log10((255.0 * 255.0) / result->mse);
+   }
+
+   free(original);
+   free(converted);
+
+   return status;
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
@@ -0,0 +1,159 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_roundtrip.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/
+ *
+ *  @desc   Round trip benchmark. Converts a frame to Y, Cb, Cr and back and
+ *          measures the speed of both directions and the error left.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RGB2YCBCR_DSP_ROUNDTRIP_H)
+#define RGB2YCBCR_DSP_ROUNDTRIP_H
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <rgb2ycbcr-dsp_cvt.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  ROUNDTRIP_REPEATS
+ *
+ *  @desc   Timed conversions of the frame per direction, after one warm-up
+ *          conversion. The fastest one counts.
+ *  ============================================================================
+ */
+#define ROUNDTRIP_REPEATS  3
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_RoundTripResult
+ *
+ *  @desc   Outcome of a round trip.
+ *
+ *  @field  forward
+ *              Throughput of R, G, B to Y, Cb, Cr, in MB/s.
+ *  @field  inverse
+ *              Throughput of Y, Cb, Cr to R, G, B, in MB/s.
+ *  @field  mse
+ *              Mean squared error of the samples against the original.
+ *  @field  psnr
+ *              Peak signal to noise ratio in dB, infinite when the frame
+ *              came back unchanged.
+ *  @field  maxError
+ *              Largest difference of a sample against the original.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_RoundTripResult_tag {
+   Real64 forward;
+   Real64 inverse;
+   Real64 mse;
+   Real64 psnr;
+   Uint32 maxError;
+} RGB2YCBCR_DSP_RoundTripResult;
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_RoundTrip
+ *
+ *  @desc   Converts a packed R, G, B frame to Y, Cb, Cr and back with the
+ *          selected colorimetry, on the DSP or with a GPP kernel, and
+ *          compares the result with the original. The DSP is loaded once
+ *          per direction. Each timed conversion works on a fresh copy of
+ *          its input, so the frame is converted once per direction.
+ *
+ *  @arg    dspExecutable
+ *              DSP executable name.
+ *
+ *  @arg    strBufferSize
+ *              String representation of the chunk size in bytes.
+ *
+ *  @arg    strNumBuffers
+ *              Number of buffers kept in flight in string format.
+ *
+ *  @arg    strNumDspBuffers
+ *              Number of buffers the DSP streams through in string format.
+ *
+ *  @arg    strProcessorId
+ *              Id of the DSP Processor in string format.
+ *
+ *  @arg    kernel
+ *              GPP kernel to convert with, NULL to convert on the DSP.
+ *
+ *  @arg    frame
+ *              Packed R, G, B frame. It receives the frame after the round
+ *              trip.
+ *
+ *  @arg    frameSize
+ *              Size of the frame in bytes.
+ *
+ *  @arg    result
+ *              Location to receive the throughputs and the error.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EMEMORY
+ *              Out of memory.
+ *          DSP_EFAIL
+ *              A direction could not be run, the frame is left as it was.
+ *
+ *  @enter  No other DSP session is open and the format is packed.
+ *
+ *  @leave  The direction is forward.
+ *
+ *  @see    RGB2YCBCR_DSP_SetDirection, RGB2YCBCR_DSP_SetColorimetry
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_RoundTrip(
+   IN     Char8 *                         dspExecutable,
+   IN     Char8 *                         strBufferSize,
+   IN     Char8 *                         strNumBuffers,
+   IN     Char8 *                         strNumDspBuffers,
+   IN     Char8 *                         strProcessorId,
+   IN     RGB2YCBCR_DSP_Kernel *          kernel,
+   IN OUT Char8 *                         frame,
+   IN     Uint32                          frameSize,
+   OUT    RGB2YCBCR_DSP_RoundTripResult * result);
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RGB2YCBCR_DSP_ROUNDTRIP_H) */
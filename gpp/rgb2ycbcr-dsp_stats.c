@@ -0,0 +1,521 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_stats.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/
+ *
+ *  @desc   Per chunk timing of the GPP execute loop. Each chunk is split in
+ *          the copy into the channel buffer, the channel issue and reclaim
+ *          calls, the round trip through the DSP and the copy out of the
+ *          channel buffer.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+/*  ----------------------------------- OS Specific Headers           */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <rgb2ycbcr-dsp.h>
+#include <rgb2ycbcr-dsp_os.h>
+#include <rgb2ycbcr-dsp_stats.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  SAMPLES_PER_CHUNK
+ *
+ *  @desc   Most samples a phase takes for one chunk.
+ *  ============================================================================
+ */
+#define SAMPLES_PER_CHUNK 2
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_Summary
+ *
+ *  @desc   Aggregate of the samples of a phase, in seconds.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_Summary_tag {
+   Real64 min;
+   Real64 mean;
+   Real64 p50;
+   Real64 p99;
+   Real64 max;
+} RGB2YCBCR_DSP_Summary;
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_PhaseNames
+ *
+ *  @desc   Names the phases are reported with.
+ *  ============================================================================
+ */
+STATIC Char8 * RGB2YCBCR_DSP_PhaseNames [RGB2YCBCR_DSP_NumPhases] = {
+   "copy_in",
+   "issue",
+   "round_trip",
+   "copy_out"
+};
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_Samples
+ *
+ *  @desc   Time of every sample of every phase, in seconds.
+ *  ============================================================================
+ */
+STATIC Real64 * RGB2YCBCR_DSP_Samples [RGB2YCBCR_DSP_NumPhases];
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_NumSamples
+ *
+ *  @desc   Number of samples taken for every phase.
+ *  ============================================================================
+ */
+STATIC Uint32 RGB2YCBCR_DSP_NumSamples [RGB2YCBCR_DSP_NumPhases];
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_MaxSamples
+ *
+ *  @desc   Number of samples there is room for in every phase.
+ *  ============================================================================
+ */
+STATIC Uint32 RGB2YCBCR_DSP_MaxSamples;
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_RunFirst
+ *
+ *  @desc   Index of the first sample of the current run in every phase, past
+ *          the samples kept from the runs before it.
+ *  ============================================================================
+ */
+STATIC Uint32 RGB2YCBCR_DSP_RunFirst [RGB2YCBCR_DSP_NumPhases];
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_RunStart
+ *
+ *  @desc   Time the run started at.
+ *  ============================================================================
+ */
+STATIC Real64 RGB2YCBCR_DSP_RunStart;
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_RunTime
+ *
+ *  @desc   Length of the run in seconds.
+ *  ============================================================================
+ */
+STATIC Real64 RGB2YCBCR_DSP_RunTime;
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_RunBytes
+ *
+ *  @desc   Bytes converted during the run.
+ *  ============================================================================
+ */
+STATIC Uint32 RGB2YCBCR_DSP_RunBytes;
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_StatsSilent
+ *
+ *  @desc   Tells whether the summary is printed at the end of a run.
+ *  ============================================================================
+ */
+STATIC Bool RGB2YCBCR_DSP_StatsSilent = FALSE;
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_StatsKept
+ *
+ *  @desc   Tells whether a run adds its samples to those of the runs before
+ *          it instead of starting over.
+ *  ============================================================================
+ */
+STATIC Bool RGB2YCBCR_DSP_StatsKept = FALSE;
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_CompareSamples
+ *
+ *  @desc   Orders two samples for qsort ().
+ *  ----------------------------------------------------------------------------
+ */
+STATIC int RGB2YCBCR_DSP_CompareSamples(
+   const void * a,
+   const void * b)
+{
+   Real64 x = *(const Real64 *) a;
+   Real64 y = *(const Real64 *) b;
+
+   return (x > y) - (x < y);
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_Summarize
+ *
+ *  @desc   Aggregates the samples of a phase from the given one on.
+ *          Percentiles are nearest rank. Returns DSP_ENOTFOUND when there is
+ *          no sample.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC DSP_STATUS RGB2YCBCR_DSP_Summarize(
+   IN  RGB2YCBCR_DSP_Phase     phase,
+   IN  Uint32                  first,
+   OUT RGB2YCBCR_DSP_Summary * summary)
+{
+   Uint32   count  = RGB2YCBCR_DSP_NumSamples [phase] - first;
+   Real64 * sorted = NULL;
+   Real64   sum    = 0;
+   Uint32   i;
+
+   if (count == 0) {
+      return DSP_ENOTFOUND;
+   }
+
+   sorted = (Real64 *) malloc(count * sizeof(Real64));
+   if (sorted == NULL) {
+      return DSP_EMEMORY;
+   }
+
+   memcpy(sorted, RGB2YCBCR_DSP_Samples [phase] + first, count * sizeof(Real64));
+   qsort(sorted, count, sizeof(Real64), RGB2YCBCR_DSP_CompareSamples);
+
+   for (i = 0 ; i < count ; i++) {
+      sum += sorted [i];
+   }
+
+   summary->min  = sorted [0];
+   summary->mean = sum / count;
+   summary->p50  = sorted [((count * 50) + 99) / 100 - 1];
+   summary->p99  = sorted [((count * 99) + 99) / 100 - 1];
+   summary->max  = sorted [count - 1];
+
+   free(sorted);
+
+   return DSP_SOK;
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_Throughput
+ *
+ *  @desc   Megabytes (10^6 bytes) per second of that many bytes converted
+ *          in that many seconds, the unit every MB/s figure of the sample is
+ *          given in.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Real64 RGB2YCBCR_DSP_Throughput(
+   IN Uint32 numBytes,
+   IN Real64 time)
+{
+   if (time <= 0) {
+      return 0;
+   }
+
+   return (numBytes / 1e6) / time;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_StatsStart
+ *
+ *  @desc   Allocates room for the samples and resets the counts, or makes
+ *          room for more after those kept.
+ *
+ *  @modif  RGB2YCBCR_DSP_Samples, RGB2YCBCR_DSP_NumSamples
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_StatsStart(
+   IN Uint32 numChunks)
+{
+   DSP_STATUS status = DSP_SOK;
+   Real64 *   samples;
+   Uint32     maxSamples;
+   Uint32     i;
+
+   if (RGB2YCBCR_DSP_StatsKept && (RGB2YCBCR_DSP_MaxSamples > 0)) {
+      /* A buffer that can not grow keeps its samples, the room stays as it
+       * was and the samples that do not fit are dropped
+       */
+      maxSamples = RGB2YCBCR_DSP_MaxSamples + (numChunks * SAMPLES_PER_CHUNK);
+      for (i = 0 ; i < RGB2YCBCR_DSP_NumPhases ; i++) {
+         samples = (Real64 *) realloc(RGB2YCBCR_DSP_Samples [i], maxSamples * sizeof(Real64));
+         if (samples != NULL) {
+            RGB2YCBCR_DSP_Samples [i] = samples;
+         }
+         else {
+            status = DSP_EMEMORY;
+         }
+         RGB2YCBCR_DSP_RunFirst [i] = RGB2YCBCR_DSP_NumSamples [i];
+      }
+      if (DSP_SUCCEEDED(status)) {
+         RGB2YCBCR_DSP_MaxSamples = maxSamples;
+      }
+
+      RGB2YCBCR_DSP_RunStart = RGB2YCBCR_DSP_GetTime();
+
+      return status;
+   }
+
+   RGB2YCBCR_DSP_StatsFree();
+
+   RGB2YCBCR_DSP_MaxSamples = numChunks * SAMPLES_PER_CHUNK;
+   for (i = 0 ; (i < RGB2YCBCR_DSP_NumPhases) && DSP_SUCCEEDED(status) ; i++) {
+      RGB2YCBCR_DSP_Samples [i] = (Real64 *) malloc(RGB2YCBCR_DSP_MaxSamples * sizeof(Real64));
+      if (RGB2YCBCR_DSP_Samples [i] == NULL) {
+         status = DSP_EMEMORY;
+      }
+   }
+
+   if (DSP_FAILED(status)) {
+      RGB2YCBCR_DSP_StatsFree();
+   }
+
+   RGB2YCBCR_DSP_RunTime  = 0;
+   RGB2YCBCR_DSP_RunBytes = 0;
+   RGB2YCBCR_DSP_RunStart = RGB2YCBCR_DSP_GetTime();
+
+   return status;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_StatsRecord
+ *
+ *  @desc   Stores a sample.
+ *
+ *  @modif  RGB2YCBCR_DSP_Samples, RGB2YCBCR_DSP_NumSamples
+ *  ============================================================================
+ */
+NORMAL_API Real64 RGB2YCBCR_DSP_StatsRecord(
+   IN RGB2YCBCR_DSP_Phase phase,
+   IN Real64              start)
+{
+   Real64 now = RGB2YCBCR_DSP_GetTime();
+
+   if (RGB2YCBCR_DSP_NumSamples [phase] < RGB2YCBCR_DSP_MaxSamples) {
+      RGB2YCBCR_DSP_Samples [phase][RGB2YCBCR_DSP_NumSamples [phase]] = now - start;
+      RGB2YCBCR_DSP_NumSamples [phase]++;
+   }
+
+   return now;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_StatsStop
+ *
+ *  @desc   Stops the run clock and prints the summary of the run.
+ *
+ *  @modif  RGB2YCBCR_DSP_RunTime, RGB2YCBCR_DSP_RunBytes
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_StatsStop(
+   IN Uint32 numBytes)
+{
+   RGB2YCBCR_DSP_Summary summary;
+   Real64                time;
+   Uint32                i;
+
+   time = RGB2YCBCR_DSP_GetTime() - RGB2YCBCR_DSP_RunStart;
+   if (RGB2YCBCR_DSP_StatsKept) {
+      RGB2YCBCR_DSP_RunTime  += time;
+      RGB2YCBCR_DSP_RunBytes += numBytes;
+   }
+   else {
+      RGB2YCBCR_DSP_RunTime  = time;
+      RGB2YCBCR_DSP_RunBytes = numBytes;
+   }
+
+   if (RGB2YCBCR_DSP_StatsSilent) {
+      return;
+   }
+
+   printf("%-10s %8s %10s %10s %10s %10s %10s\n",
+          "phase (us)", "count", "min", "mean", "p50", "p99", "max");
+   for (i = 0 ; i < RGB2YCBCR_DSP_NumPhases ; i++) {
+      if (DSP_SUCCEEDED(RGB2YCBCR_DSP_Summarize((RGB2YCBCR_DSP_Phase) i,
+                                                RGB2YCBCR_DSP_RunFirst [i],
+                                                &summary))) {
+         printf("%-10s %8u %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                RGB2YCBCR_DSP_PhaseNames [i],
+                (unsigned int) (RGB2YCBCR_DSP_NumSamples [i] - RGB2YCBCR_DSP_RunFirst [i]),
+                summary.min * 1e6, summary.mean * 1e6, summary.p50 * 1e6,
+                summary.p99 * 1e6, summary.max * 1e6);
+      }
+   }
+   printf("%u bytes in %.6f s, %.2f MB/s\n",
+          (unsigned int) numBytes,
+          time,
+          RGB2YCBCR_DSP_Throughput(numBytes, time));
+   fflush(stdout);
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_StatsQuiet
+ *
+ *  @desc   Sets whether the summary is printed.
+ *
+ *  @modif  RGB2YCBCR_DSP_StatsSilent
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_StatsQuiet(
+   IN Bool quiet)
+{
+   RGB2YCBCR_DSP_StatsSilent = quiet;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_StatsKeep
+ *
+ *  @desc   Sets whether the samples of a run are kept for the next one.
+ *
+ *  @modif  RGB2YCBCR_DSP_StatsKept
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_StatsKeep(
+   IN Bool keep)
+{
+   RGB2YCBCR_DSP_StatsKept = keep;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_StatsDump
+ *
+ *  @desc   The CSV file has a row per sample. The JSON file has the summary
+ *          of each phase along with its samples. Times are in microseconds.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_StatsDump(
+   IN Char8 * fileName)
+{
+   DSP_STATUS            status = DSP_SOK;
+   FILE *                file   = NULL;
+   Uint32                length = strlen(fileName);
+   Bool                  json   = FALSE;
+   RGB2YCBCR_DSP_Summary summary;
+   Uint32                i;
+   Uint32                j;
+
+   file = fopen(fileName, "w");
+   if (file == NULL) {
+      RGB2YCBCR_DSP_0Print("Could not open the timing file\n");
+      return DSP_EFAIL;
+   }
+
+   if ((length >= 5) && (strcmp(fileName + length - 5, ".json") == 0)) {
+      json = TRUE;
+   }
+
+   if (json) {
+      fprintf(file, "{\n  \"bytes\": %u,\n  \"seconds\": %.9f,\n  \"mb_per_s\": %.3f,\n"
+              "  \"phases\": {",
+              (unsigned int) RGB2YCBCR_DSP_RunBytes,
+              RGB2YCBCR_DSP_RunTime,
+              RGB2YCBCR_DSP_Throughput(RGB2YCBCR_DSP_RunBytes, RGB2YCBCR_DSP_RunTime));
+      for (i = 0 ; i < RGB2YCBCR_DSP_NumPhases ; i++) {
+         fprintf(file, "%s\n    \"%s\": {\n      \"count\": %u",
+                 (i == 0) ? "" : ",",
+                 RGB2YCBCR_DSP_PhaseNames [i],
+                 (unsigned int) RGB2YCBCR_DSP_NumSamples [i]);
+         if (DSP_SUCCEEDED(RGB2YCBCR_DSP_Summarize((RGB2YCBCR_DSP_Phase) i, 0, &summary))) {
+            fprintf(file, ",\n      \"min_us\": %.3f,\n      \"mean_us\": %.3f,\n"
+                    "      \"p50_us\": %.3f,\n      \"p99_us\": %.3f,\n      \"max_us\": %.3f",
+                    summary.min * 1e6, summary.mean * 1e6, summary.p50 * 1e6,
+                    summary.p99 * 1e6, summary.max * 1e6);
+         }
+         fprintf(file, ",\n      \"samples_us\": [");
+         for (j = 0 ; j < RGB2YCBCR_DSP_NumSamples [i] ; j++) {
+            fprintf(file, "%s%.3f", (j == 0) ? "" : ", ", RGB2YCBCR_DSP_Samples [i][j] * 1e6);
+         }
+         fprintf(file, "]\n    }");
+      }
+      fprintf(file, "\n  }\n}\n");
+   }
+   else {
+      fprintf(file, "phase,sample,us\n");
+      for (i = 0 ; i < RGB2YCBCR_DSP_NumPhases ; i++) {
+         for (j = 0 ; j < RGB2YCBCR_DSP_NumSamples [i] ; j++) {
+            fprintf(file, "%s,%u,%.3f\n",
+                    RGB2YCBCR_DSP_PhaseNames [i],
+                    (unsigned int) j,
+                    RGB2YCBCR_DSP_Samples [i][j] * 1e6);
+         }
+      }
+   }
+
+   if (fclose(file) != 0) {
+      RGB2YCBCR_DSP_0Print("Could not write the timing file\n");
+      status = DSP_EFAIL;
+   }
+
+   return status;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_StatsFree
+ *
+ *  @desc   Frees the samples.
+ *
+ *  @modif  RGB2YCBCR_DSP_Samples, RGB2YCBCR_DSP_NumSamples
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_StatsFree(Void)
+{
+   Uint32 i;
+
+   for (i = 0 ; i < RGB2YCBCR_DSP_NumPhases ; i++) {
+      free(RGB2YCBCR_DSP_Samples [i]);
+      RGB2YCBCR_DSP_Samples [i]    = NULL;
+      RGB2YCBCR_DSP_NumSamples [i] = 0;
+      RGB2YCBCR_DSP_RunFirst [i]   = 0;
+   }
+   RGB2YCBCR_DSP_MaxSamples = 0;
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
@@ -0,0 +1,249 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_stats.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/
+ *
+ *  @desc   Per chunk timing of the GPP execute loop. Each chunk is split in
+ *          the copy into the channel buffer, the channel issue and reclaim
+ *          calls, the round trip through the DSP and the copy out of the
+ *          channel buffer.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RGB2YCBCR_DSP_STATS_H)
+#define RGB2YCBCR_DSP_STATS_H
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_Phase
+ *
+ *  @desc   Steps a chunk is timed in.
+ *
+ *  @field  RGB2YCBCR_DSP_Phase_CopyIn
+ *              Filling a channel buffer with the chunk.
+ *  @field  RGB2YCBCR_DSP_Phase_Issue
+ *              Sending the chunk with CHNL_issue, and reclaiming the sent
+ *              buffer to post it as a receive buffer. Two samples a chunk.
+ *  @field  RGB2YCBCR_DSP_Phase_RoundTrip
+ *              From the chunk being issued to the DSP until it is reclaimed
+ *              from the input channel.
+ *  @field  RGB2YCBCR_DSP_Phase_CopyOut
+ *              Emptying the channel buffer holding the result.
+ *  @field  RGB2YCBCR_DSP_NumPhases
+ *              Number of phases.
+ *  ============================================================================
+ */
+typedef enum {
+   RGB2YCBCR_DSP_Phase_CopyIn    = 0,
+   RGB2YCBCR_DSP_Phase_Issue     = 1,
+   RGB2YCBCR_DSP_Phase_RoundTrip = 2,
+   RGB2YCBCR_DSP_Phase_CopyOut   = 3,
+   RGB2YCBCR_DSP_NumPhases       = 4
+} RGB2YCBCR_DSP_Phase;
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_StatsStart
+ *
+ *  @desc   Discards the previous samples and starts timing a run.
+ *
+ *  @arg    numChunks
+ *              Number of chunks the run converts.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EMEMORY
+ *              Out of memory for the samples.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_StatsStop
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_StatsStart(
+   IN Uint32 numChunks);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_StatsRecord
+ *
+ *  @desc   Adds the time elapsed since start to a phase. Samples past the
+ *          number the run was started with are dropped.
+ *
+ *  @arg    phase
+ *              Phase the time is spent in.
+ *
+ *  @arg    start
+ *              Time the phase began at, from RGB2YCBCR_DSP_GetTime ().
+ *
+ *  @ret    The current time, so the next phase can start from it.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_GetTime
+ *  ============================================================================
+ */
+NORMAL_API Real64 RGB2YCBCR_DSP_StatsRecord(
+   IN RGB2YCBCR_DSP_Phase phase,
+   IN Real64              start);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_StatsStop
+ *
+ *  @desc   Ends the run and prints min, mean, p50, p99 and max of every
+ *          phase and the throughput.
+ *
+ *  @arg    numBytes
+ *              Bytes converted during the run.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_StatsStart
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_StatsStop(
+   IN Uint32 numBytes);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_StatsQuiet
+ *
+ *  @desc   Turns the summary printed by RGB2YCBCR_DSP_StatsStop () off or
+ *          back on. The samples are still taken.
+ *
+ *  @arg    quiet
+ *              TRUE to stop printing the summary.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_StatsStop
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_StatsQuiet(
+   IN Bool quiet);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_StatsKeep
+ *
+ *  @desc   Makes every run add its samples, bytes and time to those of the
+ *          runs before it, so the runs of a session are dumped as one. The
+ *          summary printed at the end of a run still covers that run alone.
+ *
+ *  @arg    keep
+ *              TRUE to keep the samples from run to run, FALSE to start
+ *              every run over.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_StatsStart, RGB2YCBCR_DSP_StatsFree
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_StatsKeep(
+   IN Bool keep);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_StatsDump
+ *
+ *  @desc   Writes the samples and the summary of the last run, or of all
+ *          the runs kept, to a file, as JSON when its name ends in .json and
+ *          as CSV otherwise.
+ *
+ *  @arg    fileName
+ *              File to write.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EFAIL
+ *              The file could not be written.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_StatsStop
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_StatsDump(
+   IN Char8 * fileName);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_StatsFree
+ *
+ *  @desc   Frees the samples of the last run, or of all the runs kept.
+ *
+ *  @arg    None
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_StatsStart
+ *  ============================================================================
+ */
+NORMAL_API Void RGB2YCBCR_DSP_StatsFree(Void);
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RGB2YCBCR_DSP_STATS_H) */
@@ -0,0 +1,356 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_tune.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/
+ *
+ *  @desc   Auto-tuner. Sweeps the chunk size and the pipeline depth on a
+ *          synthetic frame and keeps the fastest configuration in a cache
+ *          file for the next runs.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+/*  ----------------------------------- OS Specific Headers           */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <rgb2ycbcr-dsp.h>
+#include <rgb2ycbcr-dsp_os.h>
+#include <rgb2ycbcr-dsp_plan.h>
+#include <rgb2ycbcr-dsp_stats.h>
+#include <rgb2ycbcr-dsp_tune.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  TUNE_LINE_SIZE
+ *
+ *  @desc   Longest line of the cache file.
+ *  ============================================================================
+ */
+#define TUNE_LINE_SIZE   512
+
+/** ============================================================================
+ *  @const  TUNE_MODE
+ *
+ *  @desc   Link and build mode of this executable, part of the cache key.
+ *  ============================================================================
+ */
+#if defined (ZCPY_LINK)
+#define TUNE_LINK        "zcpy"
+#else /* if defined (ZCPY_LINK) */
+#define TUNE_LINK        "pcpy"
+#endif /* if defined (ZCPY_LINK) */
+
+#if defined (RGB2YCBCR_DSP_EMULATION)
+#define TUNE_MODE        TUNE_LINK "-emu"
+#else /* if defined (RGB2YCBCR_DSP_EMULATION) */
+#define TUNE_MODE        TUNE_LINK
+#endif /* if defined (RGB2YCBCR_DSP_EMULATION) */
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_TuneKey
+ *
+ *  @desc   Writes the cache key of a resolution and DSP executable. Only
+ *          the file name of the executable is kept, so the cache still
+ *          applies when it is run from elsewhere.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Void RGB2YCBCR_DSP_TuneKey(
+   IN  Uint32  width,
+   IN  Uint32  height,
+   IN  Char8 * dspExecutable,
+   OUT Char8 * key,
+   IN  Uint32  keySize)
+{
+   Char8 * name = strrchr(dspExecutable, '/');
+
+   name = (name != NULL) ? (name + 1) : dspExecutable;
+   snprintf(key, keySize, "%ux%u %s %s",
+            (unsigned int) width, (unsigned int) height, TUNE_MODE, name);
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RGB2YCBCR_DSP_TuneRun
+ *
+ *  @desc   Loads the DSP with one configuration and returns the best time
+ *          of TUNE_REPEATS conversions of the frame, zero if it could not
+ *          be run.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC Real64 RGB2YCBCR_DSP_TuneRun(
+   IN Char8 * dspExecutable,
+   IN Char8 * frame,
+   IN Uint32  frameSize,
+   IN Uint32  chunkSize,
+   IN Uint32  numBuffers,
+   IN Char8 * strNumDspBuffers,
+   IN Char8 * strProcessorId)
+{
+   DSP_STATUS status = DSP_SOK;
+   Real64     best   = 0;
+   Real64     start;
+   Real64     elapsed;
+   Char8      strChunkSize [12];
+   Char8      strNumBuffers [12];
+   Uint8      processorId;
+   Uint32     i;
+
+   snprintf(strChunkSize, sizeof(strChunkSize), "%u", (unsigned int) chunkSize);
+   snprintf(strNumBuffers, sizeof(strNumBuffers), "%u", (unsigned int) numBuffers);
+
+   status = RGB2YCBCR_DSP_SessionCreate(dspExecutable,
+                                        strChunkSize,
+                                        strNumBuffers,
+                                        strNumDspBuffers,
+                                        strProcessorId,
+                                        &processorId);
+   if (DSP_FAILED(status)) {
+      return 0;
+   }
+
+   /* The first conversion warms the caches up and is not counted */
+   status = RGB2YCBCR_DSP_SessionConvert(frame, frameSize, processorId);
+
+   for (i = 0 ; (i < TUNE_REPEATS) && DSP_SUCCEEDED(status) ; i++) {
+      start   = RGB2YCBCR_DSP_GetTime();
+      status  = RGB2YCBCR_DSP_SessionConvert(frame, frameSize, processorId);
+      elapsed = RGB2YCBCR_DSP_GetTime() - start;
+      if ((best == 0) || (elapsed < best)) {
+         best = elapsed;
+      }
+   }
+
+   RGB2YCBCR_DSP_SessionDelete(processorId);
+
+   return DSP_SUCCEEDED(status) ? best : 0;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_Tune
+ *
+ *  @desc   Runs the sweep and prints the throughput of every configuration.
+ *
+ *  @modif  best
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_Tune(
+   IN  Char8 *                    dspExecutable,
+   IN  Uint32                     width,
+   IN  Uint32                     height,
+   IN  Char8 *                    strNumDspBuffers,
+   IN  Char8 *                    strProcessorId,
+   OUT RGB2YCBCR_DSP_TuneResult * best)
+{
+   Uint32  rowBytes  = width * PLAN_PIXEL_BYTES;
+   Uint32  frameSize = rowBytes * height;
+   Char8 * frame     = NULL;
+   Uint32  numBuffers;
+   Uint32  target;
+   Uint32  chunkSize;
+   Uint32  lastChunkSize;
+   Real64  elapsed;
+   Real64  throughput;
+   Uint32  i;
+
+   if ((dspExecutable == NULL) || (frameSize == 0) || (best == NULL)) {
+      return DSP_EINVALIDARG;
+   }
+
+   frame = (Char8 *) malloc(frameSize);
+   if (frame == NULL) {
+      return DSP_EMEMORY;
+   }
+
+   /* The content does not matter to the speed, only the size does */
+   for (i = 0 ; i < frameSize ; i++) {
+      frame [i] = (Char8) (i * 7);
+   }
+
+   memset(best, 0, sizeof(*best));
+   RGB2YCBCR_DSP_StatsQuiet(TRUE);
+
+   for (numBuffers = 1 ; numBuffers <= MAX_PIPELINE_DEPTH ; numBuffers *= 2) {
+      lastChunkSize = 0;
+      for (target = TUNE_MIN_CHUNK ; target <= PLAN_MAX_CHUNK ; target *= 2) {
+         chunkSize = RGB2YCBCR_DSP_PlanChunk(target, frameSize, rowBytes, numBuffers);
+         if (chunkSize == lastChunkSize) {
+            continue;
+         }
+         lastChunkSize = chunkSize;
+
+         elapsed = RGB2YCBCR_DSP_TuneRun(dspExecutable, frame, frameSize,
+                                         chunkSize, numBuffers,
+                                         strNumDspBuffers, strProcessorId);
+         if (elapsed == 0) {
+            printf("tune: chunk %6u depth %2u failed\n",
+                   (unsigned int) chunkSize, (unsigned int) numBuffers);
+            continue;
+         }
+
+         throughput = frameSize / (elapsed * 1000000.0);
+         printf("tune: chunk %6u depth %2u %8.2f MB/s\n",
+                (unsigned int) chunkSize, (unsigned int) numBuffers, throughput);
+         if (throughput > best->throughput) {
+            best->chunkSize  = chunkSize;
+            best->numBuffers = numBuffers;
+            best->throughput = throughput;
+         }
+      }
+   }
+
+   RGB2YCBCR_DSP_StatsQuiet(FALSE);
+   RGB2YCBCR_DSP_StatsFree();
+   free(frame);
+
+   return (best->chunkSize != 0) ? DSP_SOK : DSP_EFAIL;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_TuneSave
+ *
+ *  @desc   Copies the other entries of the cache to a new file, adds this
+ *          one and moves the new file over the old one.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_TuneSave(
+   IN Char8 *                    fileName,
+   IN Uint32                     width,
+   IN Uint32                     height,
+   IN Char8 *                    dspExecutable,
+   IN RGB2YCBCR_DSP_TuneResult * result)
+{
+   Char8  key [TUNE_LINE_SIZE];
+   Char8  line [TUNE_LINE_SIZE];
+   Char8  tmpName [TUNE_LINE_SIZE];
+   FILE * in;
+   FILE * out;
+   Uint32 keyLength;
+
+   RGB2YCBCR_DSP_TuneKey(width, height, dspExecutable, key, sizeof(key));
+   keyLength = strlen(key);
+
+   snprintf(tmpName, sizeof(tmpName), "%s.tmp", fileName);
+   out = fopen(tmpName, "w");
+   if (out == NULL) {
+      return DSP_EFAIL;
+   }
+
+   in = fopen(fileName, "r");
+   if (in != NULL) {
+      while (fgets(line, sizeof(line), in) != NULL) {
+         if ((strncmp(line, key, keyLength) != 0) || (line [keyLength] != ' ')) {
+            fputs(line, out);
+         }
+      }
+      fclose(in);
+   }
+
+   fprintf(out, "%s %u %u %.2f\n", key,
+           (unsigned int) result->chunkSize,
+           (unsigned int) result->numBuffers,
+           result->throughput);
+
+   if ((fclose(out) != 0) || (rename(tmpName, fileName) != 0)) {
+      remove(tmpName);
+      return DSP_EFAIL;
+   }
+
+   return DSP_SOK;
+}
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_TuneLoad
+ *
+ *  @desc   Reads the cache file until an entry with the key is found.
+ *
+ *  @modif  result
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_TuneLoad(
+   IN  Char8 *                    fileName,
+   IN  Uint32                     width,
+   IN  Uint32                     height,
+   IN  Char8 *                    dspExecutable,
+   OUT RGB2YCBCR_DSP_TuneResult * result)
+{
+   DSP_STATUS   status = DSP_ENOTFOUND;
+   Char8        key [TUNE_LINE_SIZE];
+   Char8        line [TUNE_LINE_SIZE];
+   FILE *       in;
+   Uint32       keyLength;
+   unsigned int chunkSize;
+   unsigned int numBuffers;
+   double       throughput;
+
+   RGB2YCBCR_DSP_TuneKey(width, height, dspExecutable, key, sizeof(key));
+   keyLength = strlen(key);
+
+   in = fopen(fileName, "r");
+   if (in == NULL) {
+      return DSP_ENOTFOUND;
+   }
+
+   while ((status == DSP_ENOTFOUND) && (fgets(line, sizeof(line), in) != NULL)) {
+      if (   (strncmp(line, key, keyLength) == 0) && (line [keyLength] == ' ')
+          && (sscanf(line + keyLength, "%u %u %lf", &chunkSize, &numBuffers, &throughput) == 3)
+          && (chunkSize != 0) && (numBuffers != 0) && (numBuffers <= MAX_PIPELINE_DEPTH)) {
+         result->chunkSize  = chunkSize;
+         result->numBuffers = numBuffers;
+         result->throughput = throughput;
+         status = DSP_SOK;
+      }
+   }
+
+   fclose(in);
+
+   return status;
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
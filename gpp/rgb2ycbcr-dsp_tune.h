@@ -0,0 +1,239 @@
+/** ============================================================================
+ *  @file   rgb2ycbcr-dsp_tune.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/rgb2ycbcr-dsp/
+ *
+ *  @desc   Auto-tuner. Sweeps the chunk size and the pipeline depth on a
+ *          synthetic frame and keeps the fastest configuration in a cache
+ *          file for the next runs.
+ *
+ *  @ver    1.65.00.03
+ *  ============================================================================
+ *  Copyright (C) 2015, Allan Granados
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RGB2YCBCR_DSP_TUNE_H)
+#define RGB2YCBCR_DSP_TUNE_H
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  TUNE_CACHE_FILE
+ *
+ *  @desc   Cache file the tuned configurations are kept in, in the working
+ *          directory.
+ *  ============================================================================
+ */
+#define TUNE_CACHE_FILE  "rgb2ycbcr-dsp.tune"
+
+/** ============================================================================
+ *  @const  TUNE_MIN_CHUNK
+ *
+ *  @desc   Smallest chunk size the sweep starts from. Sizes double from
+ *          here up to PLAN_MAX_CHUNK.
+ *  ============================================================================
+ */
+#define TUNE_MIN_CHUNK   4096
+
+/** ============================================================================
+ *  @const  TUNE_REPEATS
+ *
+ *  @desc   Timed conversions of the frame per configuration, after one
+ *          warm-up conversion. The fastest one counts.
+ *  ============================================================================
+ */
+#define TUNE_REPEATS     3
+
+
+/** ============================================================================
+ *  @name   RGB2YCBCR_DSP_TuneResult
+ *
+ *  @desc   A tuned configuration.
+ *
+ *  @field  chunkSize
+ *              Bytes of data per chunk.
+ *  @field  numBuffers
+ *              Number of buffers kept in flight.
+ *  @field  throughput
+ *              Throughput measured with it, in MB/s.
+ *  ============================================================================
+ */
+typedef struct RGB2YCBCR_DSP_TuneResult_tag {
+   Uint32 chunkSize;
+   Uint32 numBuffers;
+   Real64 throughput;
+} RGB2YCBCR_DSP_TuneResult;
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_Tune
+ *
+ *  @desc   Converts a synthetic frame of the given resolution with every
+ *          pipeline depth from 1 to MAX_PIPELINE_DEPTH, in powers of two,
+ *          and every planned chunk size from TUNE_MIN_CHUNK to
+ *          PLAN_MAX_CHUNK. The DSP is loaded again for each configuration.
+ *          Configurations that cannot be set up, for instance because the
+ *          pool is too small for them, are skipped.
+ *
+ *  @arg    dspExecutable
+ *              DSP executable name.
+ *
+ *  @arg    width
+ *              Width of the frame in pixels.
+ *
+ *  @arg    height
+ *              Height of the frame in pixels.
+ *
+ *  @arg    strNumDspBuffers
+ *              Number of buffers the DSP streams through in string format.
+ *
+ *  @arg    strProcessorId
+ *              Id of the DSP Processor in string format.
+ *
+ *  @arg    best
+ *              Location to receive the fastest configuration.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EMEMORY
+ *              Out of memory.
+ *          DSP_EFAIL
+ *              No configuration could be run.
+ *
+ *  @enter  No other DSP session is open.
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_TuneSave
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_Tune(
+   IN  Char8 *                    dspExecutable,
+   IN  Uint32                     width,
+   IN  Uint32                     height,
+   IN  Char8 *                    strNumDspBuffers,
+   IN  Char8 *                    strProcessorId,
+   OUT RGB2YCBCR_DSP_TuneResult * best);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_TuneSave
+ *
+ *  @desc   Stores a configuration in the cache file, replacing the one with
+ *          the same key. The key is the resolution, the link and build mode
+ *          of this GPP executable and the name of the DSP executable, which
+ *          tells the TSK and SWI builds apart.
+ *
+ *  @arg    fileName
+ *              Cache file.
+ *
+ *  @arg    width
+ *              Width of the frame in pixels.
+ *
+ *  @arg    height
+ *              Height of the frame in pixels.
+ *
+ *  @arg    dspExecutable
+ *              DSP executable name.
+ *
+ *  @arg    result
+ *              Configuration to store.
+ *
+ *  @ret    DSP_SOK
+ *              Operation Successfully completed.
+ *          DSP_EFAIL
+ *              The cache file could not be written.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_TuneLoad
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_TuneSave(
+   IN Char8 *                    fileName,
+   IN Uint32                     width,
+   IN Uint32                     height,
+   IN Char8 *                    dspExecutable,
+   IN RGB2YCBCR_DSP_TuneResult * result);
+
+
+/** ============================================================================
+ *  @func   RGB2YCBCR_DSP_TuneLoad
+ *
+ *  @desc   Looks a configuration up in the cache file.
+ *
+ *  @arg    fileName
+ *              Cache file.
+ *
+ *  @arg    width
+ *              Width of the frame in pixels.
+ *
+ *  @arg    height
+ *              Height of the frame in pixels.
+ *
+ *  @arg    dspExecutable
+ *              DSP executable name.
+ *
+ *  @arg    result
+ *              Location to receive the configuration.
+ *
+ *  @ret    DSP_SOK
+ *              The configuration was found.
+ *          DSP_ENOTFOUND
+ *              There is no cache file or no entry for this key.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RGB2YCBCR_DSP_TuneSave
+ *  ============================================================================
+ */
+NORMAL_API DSP_STATUS RGB2YCBCR_DSP_TuneLoad(
+   IN  Char8 *                    fileName,
+   IN  Uint32                     width,
+   IN  Uint32                     height,
+   IN  Char8 *                    dspExecutable,
+   OUT RGB2YCBCR_DSP_TuneResult * result);
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RGB2YCBCR_DSP_TUNE_H) */